@@ -14,15 +14,16 @@ layout(location = 3) out vec3 to_frag_position;
 
 
 void main() {
-    gl_Position = camera.cameras[pc.camera_id].proj * camera.cameras[pc.camera_id].view * pc.model * vec4(vertex_position.xyz, 1.0);
+    mat4 model = ENGINE_MODEL_MATRIX;
+    gl_Position = camera.cameras[pc.camera_id].proj * camera.cameras[pc.camera_id].view * model * vec4(vertex_position.xyz, 1.0);
 
     to_frag_color = vertex_color;
     to_frag_uv_0 = vertex_uv_0;
 
     // Transform normal to world space
     // TODO: Consider non-uniform scaling
-    to_frag_normal = mat3(pc.model) * vertex_normal;
+    to_frag_normal = mat3(model) * vertex_normal;
 
     // Get world space fragment position
-    to_frag_position = vec3(pc.model * vec4(vertex_position.xyz, 1.0));
+    to_frag_position = vec3(model * vec4(vertex_position.xyz, 1.0));
 }
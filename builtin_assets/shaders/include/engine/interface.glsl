@@ -33,9 +33,23 @@ layout(set = 1, binding = 0) uniform CameraBuffer{
     CameraBufferStruct cameras[MAX_CAMERAS];
 } camera;
 
+struct InstanceDataStruct {
+    mat4 model;
+};
+
+// Per-instance data of instanced draws, indexed by gl_InstanceIndex.
+layout(std430, set = 1, binding = 1) readonly buffer InstanceBuffer {
+    InstanceDataStruct instances[];
+} instance;
+
 layout(push_constant) uniform ModelTransform {
     mat4 model;
     int camera_id;
 } pc;
 
+// Model matrix of the current vertex shader invocation. Instanced draws start from
+// instance one, while other draws have an instance index of zero and use the push constant.
+// Materials whose vertex shaders use this can set `supports_instancing` to be instanced.
+#define ENGINE_MODEL_MATRIX (gl_InstanceIndex == 0 ? pc.model : instance.instances[gl_InstanceIndex].model)
+
 #endif // INTERFACE_GLSL_INCLUDED
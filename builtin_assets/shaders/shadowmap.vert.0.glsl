@@ -11,5 +11,6 @@ out gl_PerVertex
  
 void main()
 {
-    gl_Position = scene.casting_lights.light_vp_matrix[pc.camera_id] * pc.model * vec4(vertex_position.xyz, 1.0);
+    mat4 model = ENGINE_MODEL_MATRIX;
+    gl_Position = scene.casting_lights.light_vp_matrix[pc.camera_id] * model * vec4(vertex_position.xyz, 1.0);
 }
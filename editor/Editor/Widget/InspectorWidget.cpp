@@ -1,6 +1,7 @@
 #include "InspectorWidget.h"
 #include <Core/guid.h>
 #include <Framework/component/Component.h>
+#include <Framework/component/TransformComponent/TransformComponent.h>
 #include <Framework/object/GameObject.h>
 #include <Framework/world/Scene.h>
 #include <Framework/world/WorldSystem.h>
@@ -57,6 +58,10 @@ namespace Editor {
                             }
                             ImGui::PopID();
                         }
+                        // Fields are edited in place, so the cached world transform cannot observe the change.
+                        if (auto transform_component = dynamic_cast<Engine::TransformComponent *>(component)) {
+                            transform_component->MarkLocalTransformDirty();
+                        }
                         ImGui::TreePop();
                     }
                     ImGui::Separator();
@@ -65,6 +65,11 @@ namespace Engine {
         /// @see https://docs.vulkan.org/refpages/latest/refpages/source/VkPipelineMultisampleStateCreateInfo.html
         REFL_SER_ENABLE Multisampling multisampling{};
 
+        /// Whether the vertex shaders read the model matrix with `ENGINE_MODEL_MATRIX`,
+        /// so that draws of the same submesh and material can be instanced.
+        /// @see MaterialTemplate
+        REFL_SER_ENABLE bool supports_instancing{false};
+
         // XXX: We had better support pipeline caches to speed up loading...
         // C.f. `vkGetPipelineCacheData`
         // void * pipeline_cache.
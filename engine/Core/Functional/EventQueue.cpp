@@ -1,27 +1,75 @@
 #include "EventQueue.h"
+#include <Framework/component/Component.h>
+#include <algorithm>
 
 namespace Engine {
     EventQueue::EventQueue(Scene &scene) : m_scene(scene) {
     }
 
     void EventQueue::AddEvent(DelegatePtr event) {
-        m_events.push(std::move(event));
+        Command command{};
+        command.delegate_index = m_delegates.size();
+        command.type = CommandType::Delegate;
+        m_delegates.push_back(std::move(event));
+        m_commands.push_back(command);
+    }
+
+    void EventQueue::AddEvent(Component &component, ComponentEvent event) {
+        Command command{};
+        command.component = &component;
+        command.handle = component.GetHandle();
+        command.type = event == ComponentEvent::Init ? CommandType::ComponentInit : CommandType::ComponentTick;
+        m_commands.push_back(command);
+    }
+
+    void EventQueue::AddSceneTickEvent() {
+        Command command{};
+        command.component = nullptr;
+        command.type = CommandType::SceneTick;
+        m_commands.push_back(command);
+    }
+
+    void EventQueue::Reserve(size_t count) {
+        size_t required = m_commands.size() + count;
+        if (required > m_commands.capacity()) {
+            // Grow geometrically, so that reserving small batches repeatedly stays amortized O(1).
+            m_commands.reserve(std::max(required, m_commands.capacity() * 2));
+        }
     }
 
     void EventQueue::ProcessEvents() {
-        // TODO: try parallel processing
-        while (!m_events.empty()) {
-            auto event = std::move(m_events.front());
-            m_events.pop();
-            if (event && event->IsValid()) {
-                event->Invoke();
+        // Events may queue further events, so the size is checked on every iteration
+        // and commands are copied out before invoking.
+        for (size_t i = 0; i < m_commands.size(); i++) {
+            Command command = m_commands[i];
+            switch (command.type) {
+            case CommandType::ComponentInit:
+            case CommandType::ComponentTick:
+                // The slot map lookup rejects removed Components by generation.
+                if (m_scene.GetComponent(command.handle) != command.component) break;
+                if (command.type == CommandType::ComponentInit) {
+                    command.component->Init();
+                } else {
+                    command.component->Tick();
+                }
+                break;
+            case CommandType::SceneTick:
+                m_scene.TickComponents();
+                break;
+            case CommandType::Delegate: {
+                auto &event = m_delegates[command.delegate_index];
+                if (event && event->IsValid()) {
+                    event->Invoke();
+                }
+                break;
+            }
             }
         }
+        Clear();
     }
 
     void EventQueue::Clear() {
-        while (!m_events.empty()) {
-            m_events.pop();
-        }
+        m_commands.clear();
+        m_delegates.clear();
     }
 } // namespace Engine
@@ -1,12 +1,32 @@
 #ifndef ENGINE_FUNCTIONAL_EVENTQUEUE_H
 #define ENGINE_FUNCTIONAL_EVENTQUEUE_H
 
-#include <Core/Delegate/ComponentDelegate.h>
+#include <Core/Delegate/DelegateBase.h>
 #include <Framework/world/Scene.h>
+#include <cstdint>
 #include <memory>
-#include <queue>
+#include <vector>
 
 namespace Engine {
+    class Component;
+
+    /**
+     * @brief The events of a Component that can be queued without allocation.
+     */
+    enum class ComponentEvent : uint8_t {
+        Init,
+        Tick
+    };
+
+    /**
+     * @brief A queue of events processed in order by the scene.
+     *
+     * Component events are stored as flat commands holding the Component pointer, its handle
+     * and an event tag. The handle is checked against the scene before invoking, so events of
+     * Components removed in the meantime are dropped. The command buffer keeps its capacity
+     * across frames, so queueing and processing Component events does not allocate in steady
+     * state. Arbitrary delegates are supported as well, at the cost of one allocation each.
+     */
     class EventQueue {
         using DelegatePtr = std::unique_ptr<DelegateBase<>>;
 
@@ -14,18 +34,54 @@ namespace Engine {
         EventQueue(Scene &world);
         virtual ~EventQueue() = default;
 
+        /**
+         * @brief Queue an arbitrary delegate.
+         */
         void AddEvent(DelegatePtr event);
-        template <typename T>
-        void AddEvent(ComponentHandle object, void (T::*method)()) {
-            m_events.push(std::make_unique<ComponentDelegate<>>(m_scene, object, method));
-        }
+
+        /**
+         * @brief Queue an event of a committed or pending Component.
+         */
+        void AddEvent(Component &component, ComponentEvent event);
+
+        /**
+         * @brief Queue the tick of all Components of the scene, see Scene::AddTickEvent().
+         */
+        void AddSceneTickEvent();
+
+        /**
+         * @brief Reserve storage for the given count of additional events.
+         */
+        void Reserve(size_t count);
+
+        /**
+         * @brief Process all queued events in order, including events queued during processing.
+         */
         void ProcessEvents();
 
         void Clear();
 
     protected:
+        enum class CommandType : uint8_t {
+            ComponentInit,
+            ComponentTick,
+            SceneTick,
+            Delegate
+        };
+
+        struct Command {
+            // The Component, or the index of the delegate for CommandType::Delegate.
+            union {
+                Component *component;
+                size_t delegate_index;
+            };
+            ComponentHandle handle;
+            CommandType type;
+        };
+
         Scene &m_scene;
-        std::queue<DelegatePtr> m_events{};
+        std::vector<Command> m_commands{};
+        std::vector<DelegatePtr> m_delegates{};
     };
 } // namespace Engine
 
@@ -0,0 +1,125 @@
+#ifndef CORE_INLINEVECTOR_INCLUDED
+#define CORE_INLINEVECTOR_INCLUDED
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace Engine {
+    /**
+     * @brief A vector with a fixed capacity, stored inline.
+     *
+     * It never allocates, which makes it suitable for short arrays built on hot
+     * paths, e.g. per-draw vertex buffer bindings. Exceeding the capacity throws
+     * `std::length_error`. Being a contiguous range, it converts to `std::span`.
+     *
+     * @tparam T The element type, which must be default constructible.
+     * @tparam N The capacity.
+     */
+    template <typename T, size_t N>
+    class InlineVector {
+    public:
+        using value_type = T;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        constexpr InlineVector() noexcept = default;
+
+        constexpr InlineVector(std::initializer_list<T> init) {
+            for (const auto &value : init) push_back(value);
+        }
+
+        constexpr void push_back(const T &value) {
+            if (m_size >= N) throw std::length_error("InlineVector capacity exceeded.");
+            m_data[m_size++] = value;
+        }
+
+        template <typename... Args>
+        constexpr T &emplace_back(Args &&...args) {
+            if (m_size >= N) throw std::length_error("InlineVector capacity exceeded.");
+            m_data[m_size] = T{std::forward<Args>(args)...};
+            return m_data[m_size++];
+        }
+
+        constexpr void pop_back() noexcept {
+            assert(m_size > 0);
+            m_size--;
+        }
+
+        /// @brief Resize the vector. New elements are value-initialized.
+        constexpr void resize(size_t size) {
+            if (size > N) throw std::length_error("InlineVector capacity exceeded.");
+            for (size_t i = m_size; i < size; i++) m_data[i] = T{};
+            m_size = size;
+        }
+
+        constexpr void clear() noexcept {
+            m_size = 0;
+        }
+
+        constexpr size_t size() const noexcept {
+            return m_size;
+        }
+
+        static constexpr size_t capacity() noexcept {
+            return N;
+        }
+
+        constexpr bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        constexpr T *data() noexcept {
+            return m_data.data();
+        }
+
+        constexpr const T *data() const noexcept {
+            return m_data.data();
+        }
+
+        constexpr T &operator[](size_t index) noexcept {
+            assert(index < m_size);
+            return m_data[index];
+        }
+
+        constexpr const T &operator[](size_t index) const noexcept {
+            assert(index < m_size);
+            return m_data[index];
+        }
+
+        constexpr T &back() noexcept {
+            assert(m_size > 0);
+            return m_data[m_size - 1];
+        }
+
+        constexpr const T &back() const noexcept {
+            assert(m_size > 0);
+            return m_data[m_size - 1];
+        }
+
+        constexpr iterator begin() noexcept {
+            return m_data.data();
+        }
+
+        constexpr iterator end() noexcept {
+            return m_data.data() + m_size;
+        }
+
+        constexpr const_iterator begin() const noexcept {
+            return m_data.data();
+        }
+
+        constexpr const_iterator end() const noexcept {
+            return m_data.data() + m_size;
+        }
+
+    private:
+        std::array<T, N> m_data{};
+        size_t m_size{0};
+    };
+} // namespace Engine
+
+#endif // CORE_INLINEVECTOR_INCLUDED
@@ -0,0 +1,256 @@
+#include "JobSystem.h"
+#include "WorkStealingDeque.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    struct ThreadContext {
+        const Engine::JobSystem *system{nullptr};
+        uint32_t deque_index{0};
+    };
+
+    thread_local ThreadContext t_context{};
+    thread_local uint32_t t_random_state{0x9E3779B9u};
+
+    // Xorshift for picking steal victims.
+    uint32_t NextRandom() noexcept {
+        uint32_t x = t_random_state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        t_random_state = x;
+        return x;
+    }
+
+    // Failed attempts to find a job before a worker goes to sleep.
+    constexpr int SPIN_COUNT = 64;
+} // namespace
+
+namespace Engine {
+    struct JobSystem::Job {
+        JobFunction function;
+        JobCounter *signal;
+        bool main_thread;
+    };
+
+    bool JobCounter::IsDone() const noexcept {
+        if (m_value.load(std::memory_order_acquire) != 0) return false;
+        // The last job decrements the counter under the lock. Taking the lock waits for the job
+        // to let go of the counter, so the counter can be destroyed as soon as this returns.
+        std::lock_guard lock(m_mutex);
+        return true;
+    }
+
+    uint32_t JobCounter::GetValue() const noexcept {
+        return m_value.load(std::memory_order_acquire);
+    }
+
+    JobSystem::JobSystem(uint32_t worker_count) : m_main_thread(std::this_thread::get_id()) {
+        m_deques.reserve(worker_count + 1);
+        for (uint32_t i = 0; i <= worker_count; i++) {
+            m_deques.push_back(std::make_unique<WorkStealingDeque<Job *>>());
+        }
+        t_context = ThreadContext{this, 0};
+
+        m_workers.reserve(worker_count);
+        for (uint32_t i = 1; i <= worker_count; i++) {
+            m_workers.emplace_back([this, i] { WorkerMain(i); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(m_sleep_mutex);
+            m_stop = true;
+        }
+        m_wake_cv.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+        if (t_context.system == this) {
+            t_context = ThreadContext{};
+        }
+
+        // Jobs nobody waited for are dropped.
+        Job *job;
+        for (auto &deque : m_deques) {
+            while (deque->Steal(job)) delete job;
+        }
+        for (auto *injected : m_injected) delete injected;
+        for (auto *main_thread_job : m_main_thread_jobs) delete main_thread_job;
+    }
+
+    uint32_t JobSystem::GetDefaultWorkerCount() noexcept {
+        uint32_t hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    uint32_t JobSystem::GetWorkerCount() const noexcept {
+        return static_cast<uint32_t>(m_workers.size());
+    }
+
+    bool JobSystem::IsMainThread() const noexcept {
+        return std::this_thread::get_id() == m_main_thread;
+    }
+
+    void JobSystem::Schedule(JobFunction function, JobCounter *signal, JobCounter *dependency) {
+        if (signal) signal->m_value.fetch_add(1, std::memory_order_relaxed);
+        Submit(new Job{std::move(function), signal, false}, dependency);
+    }
+
+    void JobSystem::ScheduleOnMainThread(JobFunction function, JobCounter *signal, JobCounter *dependency) {
+        if (signal) signal->m_value.fetch_add(1, std::memory_order_relaxed);
+        Submit(new Job{std::move(function), signal, true}, dependency);
+    }
+
+    void JobSystem::Submit(Job *job, JobCounter *dependency) {
+        if (dependency && !dependency->IsDone()) {
+            std::lock_guard lock(dependency->m_mutex);
+            // Check again under the lock, as the counter may have been drained in between.
+            if (dependency->m_value.load(std::memory_order_acquire) != 0) {
+                dependency->m_waiting.push_back(job);
+                return;
+            }
+        }
+        Enqueue(job);
+    }
+
+    void JobSystem::Enqueue(Job *job) {
+        if (job->main_thread) {
+            std::lock_guard lock(m_main_thread_mutex);
+            m_main_thread_jobs.push_back(job);
+            return;
+        }
+
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        if (t_context.system == this) {
+            m_deques[t_context.deque_index]->Push(job);
+        } else {
+            std::lock_guard lock(m_injected_mutex);
+            m_injected.push_back(job);
+        }
+        if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard lock(m_sleep_mutex);
+            m_wake_cv.notify_one();
+        }
+    }
+
+    bool JobSystem::TryGetJob(uint32_t deque_index, Job *&job) {
+        if (deque_index != NO_DEQUE && m_deques[deque_index]->Pop(job)) {
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        {
+            std::lock_guard lock(m_injected_mutex);
+            if (!m_injected.empty()) {
+                job = m_injected.front();
+                m_injected.pop_front();
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        uint32_t count = static_cast<uint32_t>(m_deques.size());
+        uint32_t start = NextRandom() % count;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t victim = (start + i) % count;
+            if (victim == deque_index) continue;
+            if (m_deques[victim]->Steal(job)) {
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void JobSystem::Execute(Job *job) {
+        job->function();
+        JobCounter *signal = job->signal;
+        delete job;
+        if (signal == nullptr) return;
+
+        // The counter may be destroyed once it is done, so it is not touched after the lock is released.
+        std::vector<void *> released{};
+        {
+            std::lock_guard lock(signal->m_mutex);
+            if (signal->m_value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                released.swap(signal->m_waiting);
+            }
+        }
+        for (auto *waiting : released) {
+            Enqueue(static_cast<Job *>(waiting));
+        }
+    }
+
+    void JobSystem::WorkerMain(uint32_t deque_index) {
+        t_context = ThreadContext{this, deque_index};
+        t_random_state ^= deque_index * 0x85EBCA6Bu;
+
+        int spins = 0;
+        while (true) {
+            Job *job;
+            if (TryGetJob(deque_index, job)) {
+                Execute(job);
+                spins = 0;
+                continue;
+            }
+            if (++spins < SPIN_COUNT) {
+                std::this_thread::yield();
+                continue;
+            }
+            spins = 0;
+
+            std::unique_lock lock(m_sleep_mutex);
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            m_wake_cv.wait(lock, [this] { return m_stop || m_pending.load(std::memory_order_seq_cst) > 0; });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (m_stop) return;
+        }
+    }
+
+    void JobSystem::Wait(JobCounter &counter) {
+        uint32_t deque_index = t_context.system == this ? t_context.deque_index : NO_DEQUE;
+        bool main_thread = IsMainThread();
+        while (!counter.IsDone()) {
+            if (main_thread && RunMainThreadJobs() > 0) continue;
+            Job *job;
+            if (TryGetJob(deque_index, job)) {
+                Execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &function) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (count + grain - 1) / grain;
+        if (chunks == 1 || m_workers.empty()) {
+            function(0, count);
+            return;
+        }
+
+        JobCounter counter{};
+        for (size_t chunk = 1; chunk < chunks; chunk++) {
+            size_t begin = chunk * grain;
+            size_t end = std::min(begin + grain, count);
+            Schedule([&function, begin, end]() { function(begin, end); }, &counter);
+        }
+        function(0, std::min(grain, count));
+        Wait(counter);
+    }
+
+    size_t JobSystem::RunMainThreadJobs() {
+        assert(IsMainThread() && "Main thread jobs must be run on the main thread.");
+        std::vector<Job *> jobs{};
+        {
+            std::lock_guard lock(m_main_thread_mutex);
+            jobs.swap(m_main_thread_jobs);
+        }
+        for (auto *job : jobs) {
+            Execute(job);
+        }
+        return jobs.size();
+    }
+} // namespace Engine
@@ -0,0 +1,160 @@
+#ifndef CORE_JOBS_JOBSYSTEM_INCLUDED
+#define CORE_JOBS_JOBSYSTEM_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+    template <typename T>
+    class WorkStealingDeque;
+
+    /**
+     * @brief Counts unfinished jobs.
+     *
+     * A counter passed as the signal of a job is incremented when the job is scheduled and
+     * decremented when it finishes. A counter passed as the dependency of a job holds the job
+     * back until the counter drops to zero. A counter can be reused once it is done.
+     */
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        /**
+         * @brief Check whether all jobs signaling the counter have finished.
+         *
+         * Once it returns true, no job touches the counter any more, and it can be destroyed.
+         */
+        bool IsDone() const noexcept;
+
+        /**
+         * @brief Get the count of unfinished jobs.
+         */
+        uint32_t GetValue() const noexcept;
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_value{0};
+        mutable std::mutex m_mutex{};
+        // Jobs depending on the counter, released when it drops to zero.
+        std::vector<void *> m_waiting{};
+    };
+
+    /**
+     * @brief A work-stealing job scheduler shared by engine modules.
+     *
+     * Each worker thread owns a Chase-Lev deque. Jobs scheduled from a worker go to its own
+     * deque, and idle workers steal from the others. The thread creating the job system is
+     * the main thread: it owns a deque as well, helps running jobs in `Wait()`, and is the
+     * only thread running jobs scheduled by `ScheduleOnMainThread()`.
+     *
+     * Jobs scheduled from other threads are pushed to a shared queue.
+     */
+    class JobSystem {
+    public:
+        using JobFunction = std::function<void()>;
+
+        /**
+         * @brief Create a job system and start its worker threads.
+         * @param worker_count The count of worker threads, excluding the main thread.
+         */
+        explicit JobSystem(uint32_t worker_count = GetDefaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        /**
+         * @brief Get the default count of worker threads, which leaves one hardware thread for the main thread.
+         */
+        static uint32_t GetDefaultWorkerCount() noexcept;
+
+        /**
+         * @brief Get the count of worker threads, excluding the main thread.
+         */
+        uint32_t GetWorkerCount() const noexcept;
+
+        /**
+         * @brief Check whether the calling thread is the main thread of the job system.
+         */
+        bool IsMainThread() const noexcept;
+
+        /**
+         * @brief Schedule a job on any thread.
+         * @param function The job.
+         * @param signal The counter to be decremented when the job finishes. Can be nullptr.
+         * @param dependency The counter that must be done before the job starts. Can be nullptr.
+         */
+        void Schedule(JobFunction function, JobCounter *signal = nullptr, JobCounter *dependency = nullptr);
+
+        /**
+         * @brief Schedule a job to be run on the main thread, in `RunMainThreadJobs()` or while it waits.
+         * @param function The job.
+         * @param signal The counter to be decremented when the job finishes. Can be nullptr.
+         * @param dependency The counter that must be done before the job starts. Can be nullptr.
+         */
+        void ScheduleOnMainThread(JobFunction function, JobCounter *signal = nullptr, JobCounter *dependency = nullptr);
+
+        /**
+         * @brief Run jobs until the counter is done.
+         * The calling thread helps executing pending jobs instead of blocking.
+         */
+        void Wait(JobCounter &counter);
+
+        /**
+         * @brief Split the range [0, count) into chunks of `grain` elements and process them in parallel.
+         * Returns after all chunks are processed.
+         * @param count The size of the range.
+         * @param grain The count of elements per job. 0 is treated as 1.
+         * @param function Called with the begin and end of each chunk.
+         */
+        void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &function);
+
+        /**
+         * @brief Run all jobs scheduled on the main thread. Must be called on the main thread.
+         * @return The count of jobs run.
+         */
+        size_t RunMainThreadJobs();
+
+    protected:
+        struct Job;
+
+        void Submit(Job *job, JobCounter *dependency);
+        void Enqueue(Job *job);
+        bool TryGetJob(uint32_t deque_index, Job *&job);
+        void Execute(Job *job);
+        void WorkerMain(uint32_t deque_index);
+
+        static constexpr uint32_t NO_DEQUE = 0xFFFFFFFFu;
+
+        std::thread::id m_main_thread{};
+
+        // Index 0 is owned by the main thread, the others by the workers.
+        std::vector<std::unique_ptr<WorkStealingDeque<Job *>>> m_deques{};
+        std::vector<std::thread> m_workers{};
+
+        std::mutex m_injected_mutex{};
+        std::deque<Job *> m_injected{};
+
+        std::mutex m_main_thread_mutex{};
+        std::vector<Job *> m_main_thread_jobs{};
+
+        // Jobs that can be run by workers but are not taken yet.
+        std::atomic<int64_t> m_pending{0};
+        std::atomic<uint32_t> m_sleeping{0};
+        std::mutex m_sleep_mutex{};
+        std::condition_variable m_wake_cv{};
+        bool m_stop{false};
+    };
+} // namespace Engine
+
+#endif // CORE_JOBS_JOBSYSTEM_INCLUDED
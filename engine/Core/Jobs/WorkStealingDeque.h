@@ -0,0 +1,144 @@
+#ifndef CORE_JOBS_WORKSTEALINGDEQUE_INCLUDED
+#define CORE_JOBS_WORKSTEALINGDEQUE_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Engine {
+    /**
+     * @brief A Chase-Lev work-stealing deque of trivially copyable values, typically pointers.
+     *
+     * The owner thread pushes and pops at the bottom in LIFO order, and any other
+     * thread steals from the top in FIFO order, without locks. The memory orderings
+     * follow Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models".
+     *
+     * The ring buffer grows when full. Old buffers may still be read by concurrent
+     * thieves, so they are retired and only freed with the deque.
+     *
+     * @tparam T The element type, which must be trivially copyable.
+     */
+    template <typename T>
+    class WorkStealingDeque {
+        static_assert(std::is_trivially_copyable_v<T>, "Elements of the deque must be trivially copyable.");
+
+    public:
+        explicit WorkStealingDeque(size_t capacity = 1024) {
+            assert((capacity & (capacity - 1)) == 0 && "The capacity must be a power of two.");
+            m_retired.push_back(std::make_unique<Buffer>(capacity));
+            m_buffer.store(m_retired.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque &) = delete;
+        WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+        /**
+         * @brief Push a value at the bottom. Must only be called by the owner thread.
+         */
+        void Push(T value) {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+            if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+                buffer = Grow(buffer, top, bottom);
+            }
+            buffer->Put(bottom, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Pop a value from the bottom. Must only be called by the owner thread.
+         * @return Whether a value was popped.
+         */
+        bool Pop(T &value) {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                // Empty.
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+            value = buffer->Get(bottom);
+            if (top == bottom) {
+                // Last element, race against thieves.
+                bool won = m_top.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+                );
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Steal a value from the top. May be called by any thread.
+         * @return Whether a value was stolen. Fails spuriously when racing with other thieves or the owner.
+         */
+        bool Steal(T &value) {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+            if (top >= bottom) return false;
+
+            Buffer *buffer = m_buffer.load(std::memory_order_acquire);
+            T stolen = buffer->Get(top);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return false;
+            }
+            value = stolen;
+            return true;
+        }
+
+        /**
+         * @brief Get an estimate of the count of values. Exact only when called by the owner without thieves.
+         */
+        size_t SizeEstimate() const noexcept {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+        }
+
+    protected:
+        struct Buffer {
+            explicit Buffer(size_t capacity) : mask(capacity - 1), values(new std::atomic<T>[capacity]) {
+            }
+
+            void Put(int64_t index, T value) noexcept {
+                values[index & mask].store(value, std::memory_order_relaxed);
+            }
+            T Get(int64_t index) const noexcept {
+                return values[index & mask].load(std::memory_order_relaxed);
+            }
+
+            size_t mask;
+            std::unique_ptr<std::atomic<T>[]> values;
+        };
+
+        Buffer *Grow(Buffer *old, int64_t top, int64_t bottom) {
+            auto buffer = std::make_unique<Buffer>((old->mask + 1) * 2);
+            for (int64_t i = top; i < bottom; i++) {
+                buffer->Put(i, old->Get(i));
+            }
+            Buffer *ret = buffer.get();
+            m_retired.push_back(std::move(buffer));
+            m_buffer.store(ret, std::memory_order_release);
+            return ret;
+        }
+
+        alignas(64) std::atomic<int64_t> m_top{0};
+        alignas(64) std::atomic<int64_t> m_bottom{0};
+        std::atomic<Buffer *> m_buffer{nullptr};
+        // All buffers ever allocated, including the current one. Only touched by the owner thread.
+        std::vector<std::unique_ptr<Buffer>> m_retired{};
+    };
+} // namespace Engine
+
+#endif // CORE_JOBS_WORKSTEALINGDEQUE_INCLUDED
@@ -0,0 +1,108 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define ENGINE_FRUSTUM_SSE 1
+#endif
+
+namespace {
+    // Slack of the plane test, in world units. Boxes touching a plane are kept despite
+    // rounding errors of the distance to the plane.
+    constexpr float PLANE_SLACK = 1e-3f;
+} // namespace
+
+namespace Engine {
+    bool AABB::IsEmpty() const noexcept {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    void AABB::Expand(const glm::vec3 &point) noexcept {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    glm::vec3 AABB::GetCenter() const noexcept {
+        return (min + max) * 0.5f;
+    }
+
+    glm::vec3 AABB::GetExtent() const noexcept {
+        return (max - min) * 0.5f;
+    }
+
+    AABB AABB::Transformed(const glm::mat4 &matrix) const noexcept {
+        if (IsEmpty()) return *this;
+        // Arvo's method: the extent of the transformed box is |M| * extent.
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+        glm::vec3 extent = GetExtent();
+        glm::vec3 new_extent = glm::abs(glm::vec3(matrix[0])) * extent.x + glm::abs(glm::vec3(matrix[1])) * extent.y
+                               + glm::abs(glm::vec3(matrix[2])) * extent.z;
+        return AABB{center - new_extent, center + new_extent};
+    }
+
+    Frustum::Frustum() noexcept {
+        for (int i = 0; i < 8; i++) {
+            m_nx[i] = m_ny[i] = m_nz[i] = 0.0f;
+            m_d[i] = 1.0f;
+        }
+    }
+
+    Frustum::Frustum(const glm::mat4 &projection_view) noexcept : Frustum() {
+        // Rows of the matrix, as glm matrices are column-major.
+        glm::vec4 rows[4];
+        for (int r = 0; r < 4; r++) {
+            rows[r] = glm::vec4(
+                projection_view[0][r], projection_view[1][r], projection_view[2][r], projection_view[3][r]
+            );
+        }
+        // -w <= x <= w, -w <= y <= w, 0 <= z <= w.
+        const glm::vec4 planes[6] = {
+            rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[2], rows[3] - rows[2]
+        };
+        for (int i = 0; i < 6; i++) {
+            float length = glm::length(glm::vec3(planes[i]));
+            glm::vec4 plane = length > 0.0f ? planes[i] / length : planes[i];
+            m_nx[i] = plane.x;
+            m_ny[i] = plane.y;
+            m_nz[i] = plane.z;
+            m_d[i] = plane.w;
+        }
+    }
+
+    bool Frustum::Intersects(const AABB &box) const noexcept {
+        if (box.IsEmpty()) return false;
+        glm::vec3 c = box.GetCenter();
+        glm::vec3 e = box.GetExtent();
+#ifdef ENGINE_FRUSTUM_SSE
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+        __m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ez = _mm_set1_ps(e.z);
+        for (int g = 0; g < 8; g += 4) {
+            __m128 nx = _mm_load_ps(m_nx + g);
+            __m128 ny = _mm_load_ps(m_ny + g);
+            __m128 nz = _mm_load_ps(m_nz + g);
+            // Signed distance of the center, and the projected radius of the box onto the normal.
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                _mm_add_ps(_mm_mul_ps(nz, cz), _mm_load_ps(m_d + g))
+            );
+            __m128 radius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, nx), ex), _mm_mul_ps(_mm_andnot_ps(sign_mask, ny), ey)),
+                _mm_mul_ps(_mm_andnot_ps(sign_mask, nz), ez)
+            );
+            if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_set1_ps(-PLANE_SLACK))) != 0) {
+                return false;
+            }
+        }
+        return true;
+#else
+        for (int i = 0; i < 6; i++) {
+            float distance = m_nx[i] * c.x + m_ny[i] * c.y + m_nz[i] * c.z + m_d[i];
+            float radius = std::abs(m_nx[i]) * e.x + std::abs(m_ny[i]) * e.y + std::abs(m_nz[i]) * e.z;
+            if (distance + radius < -PLANE_SLACK) return false;
+        }
+        return true;
+#endif
+    }
+} // namespace Engine
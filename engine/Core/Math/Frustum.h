@@ -0,0 +1,77 @@
+#ifndef CORE_MATH_FRUSTUM_INCLUDED
+#define CORE_MATH_FRUSTUM_INCLUDED
+
+#include <glm.hpp>
+#include <limits>
+
+namespace Engine {
+    /**
+     * @brief An axis-aligned bounding box.
+     *
+     * A default-constructed box is empty, i.e. its minimum is larger than its
+     * maximum, and expanding it by a point yields a box containing only that point.
+     */
+    struct AABB {
+        glm::vec3 min{std::numeric_limits<float>::max()};
+        glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+        /**
+         * @brief Check whether the box contains no point.
+         */
+        bool IsEmpty() const noexcept;
+
+        /**
+         * @brief Grow the box to contain a point.
+         */
+        void Expand(const glm::vec3 &point) noexcept;
+
+        glm::vec3 GetCenter() const noexcept;
+        glm::vec3 GetExtent() const noexcept;
+
+        /**
+         * @brief Get the axis-aligned box bounding this box transformed by an affine matrix.
+         * Empty boxes stay empty.
+         */
+        AABB Transformed(const glm::mat4 &matrix) const noexcept;
+    };
+
+    /**
+     * @brief A view frustum defined by six planes, used for visibility culling.
+     *
+     * Planes are extracted from a projection * view matrix with the Vulkan
+     * clip volume (depth in [0, 1]), and are stored in structure-of-arrays form
+     * so that a box is tested against four planes at once with SSE when available.
+     */
+    class Frustum {
+    public:
+        /**
+         * @brief Construct a frustum that contains everything.
+         */
+        Frustum() noexcept;
+
+        /**
+         * @brief Construct the frustum of a projection * view matrix.
+         * Boxes are then tested in the space that the view matrix transforms from, usually the world space.
+         */
+        explicit Frustum(const glm::mat4 &projection_view) noexcept;
+
+        /**
+         * @brief Check whether a box is inside or intersects the frustum.
+         *
+         * The test is conservative: boxes near the edges of the frustum, or within
+         * a millimeter of a plane, may be reported as intersecting while being outside.
+         * Empty boxes are never reported as intersecting.
+         */
+        bool Intersects(const AABB &box) const noexcept;
+
+    protected:
+        // Two groups of four planes, the last two planes are padding that contains everything.
+        // The plane equation is dot(n, p) + d >= 0 for points inside.
+        alignas(16) float m_nx[8];
+        alignas(16) float m_ny[8];
+        alignas(16) float m_nz[8];
+        alignas(16) float m_d[8];
+    };
+} // namespace Engine
+
+#endif // CORE_MATH_FRUSTUM_INCLUDED
@@ -0,0 +1,206 @@
+#include "TransformHierarchy.h"
+#include "Transform.h"
+
+#include <cassert>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define ENGINE_TRANSFORM_HIERARCHY_SSE 1
+#endif
+
+namespace {
+    /// Build the columns of T * R * S, matching `Transform::GetTransformMatrix()`.
+    inline void ComposeLocal(const glm::vec3 &t, const glm::quat &q, const glm::vec3 &s, float (&cols)[4][4]) {
+        float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        cols[0][0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+        cols[0][1] = 2.0f * (xy + wz) * s.x;
+        cols[0][2] = 2.0f * (xz - wy) * s.x;
+        cols[0][3] = 0.0f;
+
+        cols[1][0] = 2.0f * (xy - wz) * s.y;
+        cols[1][1] = (1.0f - 2.0f * (xx + zz)) * s.y;
+        cols[1][2] = 2.0f * (yz + wx) * s.y;
+        cols[1][3] = 0.0f;
+
+        cols[2][0] = 2.0f * (xz + wy) * s.z;
+        cols[2][1] = 2.0f * (yz - wx) * s.z;
+        cols[2][2] = (1.0f - 2.0f * (xx + yy)) * s.z;
+        cols[2][3] = 0.0f;
+
+        cols[3][0] = t.x;
+        cols[3][1] = t.y;
+        cols[3][2] = t.z;
+        cols[3][3] = 1.0f;
+    }
+
+    /// out = parent * local, where local is affine (last row is 0, 0, 0, 1).
+    inline void MultiplyAffine(const glm::mat4 &parent, const float (&local)[4][4], glm::mat4 &out) {
+#ifdef ENGINE_TRANSFORM_HIERARCHY_SSE
+        const float *p = &parent[0][0];
+        __m128 p0 = _mm_loadu_ps(p + 0);
+        __m128 p1 = _mm_loadu_ps(p + 4);
+        __m128 p2 = _mm_loadu_ps(p + 8);
+        __m128 p3 = _mm_loadu_ps(p + 12);
+        float *o = &out[0][0];
+        for (int c = 0; c < 3; c++) {
+            __m128 r = _mm_mul_ps(p0, _mm_set1_ps(local[c][0]));
+            r = _mm_add_ps(r, _mm_mul_ps(p1, _mm_set1_ps(local[c][1])));
+            r = _mm_add_ps(r, _mm_mul_ps(p2, _mm_set1_ps(local[c][2])));
+            _mm_storeu_ps(o + 4 * c, r);
+        }
+        __m128 r = _mm_mul_ps(p0, _mm_set1_ps(local[3][0]));
+        r = _mm_add_ps(r, _mm_mul_ps(p1, _mm_set1_ps(local[3][1])));
+        r = _mm_add_ps(r, _mm_mul_ps(p2, _mm_set1_ps(local[3][2])));
+        r = _mm_add_ps(r, p3);
+        _mm_storeu_ps(o + 12, r);
+#else
+        for (int c = 0; c < 3; c++) {
+            out[c] = parent[0] * local[c][0] + parent[1] * local[c][1] + parent[2] * local[c][2];
+        }
+        out[3] = parent[0] * local[3][0] + parent[1] * local[3][1] + parent[2] * local[3][2] + parent[3];
+#endif
+    }
+} // namespace
+
+namespace Engine {
+    void TransformHierarchy::Clear() noexcept {
+        m_positions.clear();
+        m_rotations.clear();
+        m_scales.clear();
+        m_parents.clear();
+        m_local_dirty.clear();
+        m_world_matrices.clear();
+        m_world_versions.clear();
+        m_kept_nodes.clear();
+
+        m_previous_positions.clear();
+        m_previous_rotations.clear();
+        m_previous_scales.clear();
+        m_previous_parents.clear();
+        m_previous_local_dirty.clear();
+        m_previous_world_matrices.clear();
+        m_previous_world_versions.clear();
+    }
+
+    void TransformHierarchy::BeginRebuild() noexcept {
+        // Swap rather than move, so that the storage of both generations is reused.
+        m_positions.swap(m_previous_positions);
+        m_rotations.swap(m_previous_rotations);
+        m_scales.swap(m_previous_scales);
+        m_parents.swap(m_previous_parents);
+        m_local_dirty.swap(m_previous_local_dirty);
+        m_world_matrices.swap(m_previous_world_matrices);
+        m_world_versions.swap(m_previous_world_versions);
+
+        m_positions.clear();
+        m_rotations.clear();
+        m_scales.clear();
+        m_parents.clear();
+        m_local_dirty.clear();
+        m_world_matrices.clear();
+        m_world_versions.clear();
+        m_kept_nodes.clear();
+    }
+
+    void TransformHierarchy::Reserve(size_t count) {
+        m_positions.reserve(count);
+        m_rotations.reserve(count);
+        m_scales.reserve(count);
+        m_parents.reserve(count);
+        m_local_dirty.reserve(count);
+        m_world_matrices.reserve(count);
+        m_world_versions.reserve(count);
+        m_kept_nodes.reserve(count);
+    }
+
+    uint32_t TransformHierarchy::AddNode(uint32_t parent, const Transform &local, uint32_t previous) {
+        uint32_t index = static_cast<uint32_t>(m_parents.size());
+        assert((parent == NO_PARENT || parent < index) && "Parents must be added before their children.");
+        m_positions.push_back(local.GetPosition());
+        m_rotations.push_back(local.GetRotation());
+        m_scales.push_back(local.GetScale());
+        m_parents.push_back(parent);
+
+        // The world matrix of the previous node is still valid if its parent is the node that
+        // continues its previous parent, as that parent keeps its world matrix or is recomputed
+        // along with its descendants.
+        bool keep = false;
+        if (previous < m_previous_parents.size()) {
+            uint32_t previous_parent = m_previous_parents[previous];
+            bool same_parent = parent == NO_PARENT
+                                   ? previous_parent == NO_PARENT
+                                   : previous_parent != NO_PARENT && m_kept_nodes[parent] == previous_parent;
+            keep = same_parent && m_positions.back() == m_previous_positions[previous]
+                   && m_rotations.back() == m_previous_rotations[previous]
+                   && m_scales.back() == m_previous_scales[previous];
+        }
+        if (keep) {
+            m_local_dirty.push_back(m_previous_local_dirty[previous]);
+            m_world_matrices.push_back(m_previous_world_matrices[previous]);
+            m_world_versions.push_back(m_previous_world_versions[previous]);
+            m_kept_nodes.push_back(previous);
+        } else {
+            m_local_dirty.push_back(1);
+            m_world_matrices.emplace_back(1.0f);
+            m_world_versions.push_back(0);
+            m_kept_nodes.push_back(INVALID_NODE);
+        }
+        return index;
+    }
+
+    void TransformHierarchy::SetLocalTransform(uint32_t node, const Transform &local) noexcept {
+        assert(node < m_parents.size());
+        m_positions[node] = local.GetPosition();
+        m_rotations[node] = local.GetRotation();
+        m_scales[node] = local.GetScale();
+        m_local_dirty[node] = 1;
+    }
+
+    size_t TransformHierarchy::UpdateWorldMatrices() noexcept {
+        const uint64_t version = ++m_version_counter;
+        const size_t count = m_parents.size();
+        size_t updated = 0;
+
+        float local[4][4];
+        for (size_t i = 0; i < count; i++) {
+            uint32_t parent = m_parents[i];
+            // Parents precede their children, so their versions are final at this point.
+            bool parent_updated = parent != NO_PARENT && m_world_versions[parent] == version;
+            if (!m_local_dirty[i] && !parent_updated) continue;
+
+            ComposeLocal(m_positions[i], m_rotations[i], m_scales[i], local);
+            if (parent == NO_PARENT) {
+                auto &out = m_world_matrices[i];
+                for (int c = 0; c < 4; c++) out[c] = glm::vec4(local[c][0], local[c][1], local[c][2], local[c][3]);
+            } else {
+                MultiplyAffine(m_world_matrices[parent], local, m_world_matrices[i]);
+            }
+            m_local_dirty[i] = 0;
+            m_world_versions[i] = version;
+            updated++;
+        }
+        return updated;
+    }
+
+    size_t TransformHierarchy::GetNodeCount() const noexcept {
+        return m_parents.size();
+    }
+
+    uint32_t TransformHierarchy::GetParent(uint32_t node) const noexcept {
+        assert(node < m_parents.size());
+        return m_parents[node];
+    }
+
+    const glm::mat4 &TransformHierarchy::GetWorldMatrix(uint32_t node) const noexcept {
+        assert(node < m_world_matrices.size());
+        return m_world_matrices[node];
+    }
+
+    uint64_t TransformHierarchy::GetWorldMatrixVersion(uint32_t node) const noexcept {
+        assert(node < m_world_versions.size());
+        return m_world_versions[node];
+    }
+} // namespace Engine
@@ -0,0 +1,125 @@
+#ifndef CORE_MATH_TRANSFORMHIERARCHY_INCLUDED
+#define CORE_MATH_TRANSFORMHIERARCHY_INCLUDED
+
+#include <glm.hpp>
+#include <gtc/quaternion.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    class Transform;
+
+    /**
+     * @brief A flattened transform hierarchy stored in structure-of-arrays form.
+     *
+     * Nodes are stored in parent-before-child order, which is enforced by
+     * `AddNode()` only accepting parents that already exist. World matrices
+     * of all nodes whose local transform or any ancestor changed are then
+     * recomputed in a single linear pass by `UpdateWorldMatrices()`, using SSE
+     * for the matrix composition when available.
+     *
+     * Each recomputed world matrix is stamped with a version number, which is
+     * unique across the lifetime of the hierarchy (including `Clear()`), so
+     * consumers can skip uploading matrices that did not change.
+     *
+     * When the structure changes, the hierarchy is rebuilt with `BeginRebuild()`
+     * followed by `AddNode()` calls. Nodes that keep their parent and local
+     * transform across the rebuild keep their world matrices and versions.
+     */
+    class TransformHierarchy {
+    public:
+        static constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+        static constexpr uint32_t INVALID_NODE = 0xFFFFFFFFu;
+
+        TransformHierarchy() = default;
+        ~TransformHierarchy() = default;
+
+        /**
+         * @brief Remove all nodes.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Remove all nodes, keeping their state to be reused by `AddNode()`.
+         */
+        void BeginRebuild() noexcept;
+
+        /**
+         * @brief Reserve storage for the given count of nodes.
+         */
+        void Reserve(size_t count);
+
+        /**
+         * @brief Append a node to the hierarchy.
+         *
+         * The node is marked dirty and will be computed in the next update, unless it
+         * continues a node from before `BeginRebuild()` with the same parent and the same
+         * local transform, in which case it keeps the world matrix and version of that node.
+         * @param parent Index of the parent node, which must be smaller than the index of the new node,
+         * or NO_PARENT for root nodes.
+         * @param local The transform from local coordinate to parent local coordinate.
+         * @param previous Index of the node before the rebuild, or INVALID_NODE for new nodes.
+         * @return The index of the new node.
+         */
+        uint32_t AddNode(uint32_t parent, const Transform &local, uint32_t previous = INVALID_NODE);
+
+        /**
+         * @brief Update the local transform of a node and mark it dirty.
+         */
+        void SetLocalTransform(uint32_t node, const Transform &local) noexcept;
+
+        /**
+         * @brief Recompute the world matrices of all dirty nodes and their descendants.
+         * @return The count of recomputed nodes.
+         */
+        size_t UpdateWorldMatrices() noexcept;
+
+        /**
+         * @brief Get the count of nodes.
+         */
+        size_t GetNodeCount() const noexcept;
+
+        /**
+         * @brief Get the parent index of a node, or NO_PARENT for root nodes.
+         */
+        uint32_t GetParent(uint32_t node) const noexcept;
+
+        /**
+         * @brief Get the local-to-world matrix of a node computed in the last update.
+         */
+        const glm::mat4 &GetWorldMatrix(uint32_t node) const noexcept;
+
+        /**
+         * @brief Get the version of the world matrix of a node.
+         *
+         * The version changes whenever the world matrix is recomputed, and is
+         * never zero for a computed matrix.
+         */
+        uint64_t GetWorldMatrixVersion(uint32_t node) const noexcept;
+
+    protected:
+        std::vector<glm::vec3> m_positions{};
+        std::vector<glm::quat> m_rotations{};
+        std::vector<glm::vec3> m_scales{};
+        std::vector<uint32_t> m_parents{};
+        std::vector<uint8_t> m_local_dirty{};
+
+        std::vector<glm::mat4> m_world_matrices{};
+        std::vector<uint64_t> m_world_versions{};
+        // Index of the node before the rebuild whose state each node kept, or INVALID_NODE.
+        std::vector<uint32_t> m_kept_nodes{};
+
+        // Nodes before the rebuild, see `BeginRebuild()`.
+        std::vector<glm::vec3> m_previous_positions{};
+        std::vector<glm::quat> m_previous_rotations{};
+        std::vector<glm::vec3> m_previous_scales{};
+        std::vector<uint32_t> m_previous_parents{};
+        std::vector<uint8_t> m_previous_local_dirty{};
+        std::vector<glm::mat4> m_previous_world_matrices{};
+        std::vector<uint64_t> m_previous_world_versions{};
+
+        uint64_t m_version_counter{0};
+    };
+} // namespace Engine
+
+#endif // CORE_MATH_TRANSFORMHIERARCHY_INCLUDED
@@ -0,0 +1,103 @@
+#include "PoolAllocator.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+namespace {
+    using Engine::PoolAllocator;
+
+    constexpr size_t CLASS_COUNT = PoolAllocator::MAX_SIZE / PoolAllocator::GRANULARITY;
+    // The size of blocks carved when a size class runs out of memory.
+    constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    struct SizeClass {
+        std::mutex mutex{};
+        FreeNode *free_list{nullptr};
+        size_t free_count{0};
+        // Remaining space of the block being carved.
+        std::byte *cursor{nullptr};
+        std::byte *end{nullptr};
+    };
+
+    SizeClass &GetSizeClass(size_t index) {
+        // Never destroyed, as objects may be freed during static destruction.
+        static SizeClass *classes = new SizeClass[CLASS_COUNT];
+        return classes[index];
+    }
+
+    size_t GetClassIndex(size_t size) {
+        return (std::max<size_t>(size, 1) - 1) / PoolAllocator::GRANULARITY;
+    }
+
+    void PushFree(SizeClass &size_class, void *ptr) {
+        auto *node = static_cast<FreeNode *>(ptr);
+        node->next = size_class.free_list;
+        size_class.free_list = node;
+        size_class.free_count++;
+    }
+
+    // Start carving a new block, moving the rest of the current block to the free list.
+    void StartBlock(SizeClass &size_class, size_t object_size, size_t block_size) {
+        while (size_class.cursor && size_class.cursor + object_size <= size_class.end) {
+            PushFree(size_class, size_class.cursor);
+            size_class.cursor += object_size;
+        }
+        size_class.cursor = static_cast<std::byte *>(::operator new(block_size));
+        size_class.end = size_class.cursor + block_size;
+    }
+} // namespace
+
+namespace Engine {
+    void *PoolAllocator::Allocate(size_t size) {
+        if (size > MAX_SIZE) return ::operator new(size);
+
+        size_t index = GetClassIndex(size);
+        size_t object_size = (index + 1) * GRANULARITY;
+        auto &size_class = GetSizeClass(index);
+        std::lock_guard lock(size_class.mutex);
+        if (size_class.free_list) {
+            FreeNode *node = size_class.free_list;
+            size_class.free_list = node->next;
+            size_class.free_count--;
+            return node;
+        }
+        if (size_class.cursor == nullptr || size_class.cursor + object_size > size_class.end) {
+            StartBlock(size_class, object_size, std::max(BLOCK_SIZE, object_size));
+        }
+        void *ptr = size_class.cursor;
+        size_class.cursor += object_size;
+        return ptr;
+    }
+
+    void PoolAllocator::Deallocate(void *ptr, size_t size) noexcept {
+        if (ptr == nullptr) return;
+        if (size > MAX_SIZE) {
+            ::operator delete(ptr, size);
+            return;
+        }
+
+        auto &size_class = GetSizeClass(GetClassIndex(size));
+        std::lock_guard lock(size_class.mutex);
+        PushFree(size_class, ptr);
+    }
+
+    void PoolAllocator::Reserve(size_t size, size_t count) {
+        if (size > MAX_SIZE || count == 0) return;
+
+        size_t index = GetClassIndex(size);
+        size_t object_size = (index + 1) * GRANULARITY;
+        auto &size_class = GetSizeClass(index);
+        std::lock_guard lock(size_class.mutex);
+        size_t available = size_class.free_count;
+        if (size_class.cursor) {
+            available += static_cast<size_t>(size_class.end - size_class.cursor) / object_size;
+        }
+        if (available >= count) return;
+        StartBlock(size_class, object_size, std::max(BLOCK_SIZE, (count - available) * object_size));
+    }
+} // namespace Engine
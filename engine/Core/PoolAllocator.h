@@ -0,0 +1,48 @@
+#ifndef CORE_POOLALLOCATOR_INCLUDED
+#define CORE_POOLALLOCATOR_INCLUDED
+
+#include <cstddef>
+
+namespace Engine {
+    /**
+     * @brief A thread-safe allocator for small objects with one free list per size class.
+     *
+     * Sizes are rounded up to multiples of GRANULARITY, and each size class carves its objects
+     * from large blocks. Objects allocated in a row are therefore contiguous in memory, and freed
+     * objects are recycled by later allocations of the same size class. Blocks are kept until the
+     * process exits. Requests larger than MAX_SIZE are forwarded to the global allocator.
+     *
+     * GameObjects and Components are allocated through it by their class-specific operator new.
+     */
+    class PoolAllocator {
+    public:
+        /// The size granularity, which is also the guaranteed alignment.
+        static constexpr size_t GRANULARITY = 16;
+        /// The largest size served from the pools.
+        static constexpr size_t MAX_SIZE = 1024;
+
+        /**
+         * @brief Allocate memory for an object.
+         * @param size The size of the object.
+         */
+        static void *Allocate(size_t size);
+
+        /**
+         * @brief Free memory returned by `Allocate()`.
+         * @param ptr The pointer returned by `Allocate()`.
+         * @param size The size passed to `Allocate()`.
+         */
+        static void Deallocate(void *ptr, size_t size) noexcept;
+
+        /**
+         * @brief Make sure that the next `count` allocations of `size` do not need a new block.
+         * Space missing from the current block is carved as one contiguous run, so objects of
+         * a batch allocated right after reserving are laid out next to each other.
+         * @param size The size of the objects.
+         * @param count The count of objects.
+         */
+        static void Reserve(size_t size, size_t count);
+    };
+} // namespace Engine
+
+#endif // CORE_POOLALLOCATOR_INCLUDED
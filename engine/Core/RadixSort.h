@@ -0,0 +1,60 @@
+#ifndef CORE_RADIXSORT_INCLUDED
+#define CORE_RADIXSORT_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+    /**
+     * @brief Stable LSD radix sort of items by 64-bit unsigned keys, one byte per pass.
+     *
+     * Passes over bytes that are equal in all keys are skipped, so keys using
+     * only some of their bits cost only as many passes as there are varying bytes.
+     * Sorting n items takes O(n) per pass, with no comparison.
+     *
+     * @param items The items to be sorted in place.
+     * @param scratch Storage of the same size as items, reused across calls to avoid allocations.
+     * @param key Returns the uint64_t key of an item.
+     */
+    template <typename T, typename KeyFunc>
+    void RadixSort(std::vector<T> &items, std::vector<T> &scratch, KeyFunc key) {
+        constexpr uint32_t PASSES = 8;
+        constexpr uint32_t BUCKETS = 256;
+        if (items.size() < 2) return;
+
+        // Histograms of all passes are counted in one go.
+        std::array<std::array<uint32_t, BUCKETS>, PASSES> counts{};
+        for (const auto &item : items) {
+            uint64_t k = key(item);
+            for (uint32_t pass = 0; pass < PASSES; pass++) {
+                counts[pass][(k >> (pass * 8)) & 0xFF]++;
+            }
+        }
+
+        uint64_t first_key = key(items[0]);
+        scratch.resize(items.size());
+        std::vector<T> *from = &items, *to = &scratch;
+        for (uint32_t pass = 0; pass < PASSES; pass++) {
+            auto &count = counts[pass];
+            uint64_t first_byte = (first_key >> (pass * 8)) & 0xFF;
+            // All keys share this byte.
+            if (count[first_byte] == items.size()) continue;
+
+            uint32_t offset = 0;
+            for (auto &c : count) {
+                uint32_t size = c;
+                c = offset;
+                offset += size;
+            }
+            for (auto &item : *from) {
+                (*to)[count[(key(item) >> (pass * 8)) & 0xFF]++] = std::move(item);
+            }
+            std::swap(from, to);
+        }
+        if (from != &items) items.swap(scratch);
+    }
+} // namespace Engine
+
+#endif // CORE_RADIXSORT_INCLUDED
@@ -0,0 +1,109 @@
+#include "RangeAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace Engine {
+    RangeAllocator::RangeAllocator(uint64_t capacity) : m_capacity(capacity) {
+        Clear();
+    }
+
+    uint64_t RangeAllocator::Allocate(uint64_t size) {
+        if (size == 0) return INVALID_OFFSET;
+        auto fit = m_free_by_size.lower_bound(size);
+        if (fit == m_free_by_size.end()) return INVALID_OFFSET;
+
+        uint64_t offset = fit->second, free_size = fit->first;
+        EraseFreeRange(m_free_by_offset.find(offset));
+        if (free_size > size) InsertFreeRange(offset + size, free_size - size);
+        m_used += size;
+        return offset;
+    }
+
+    void RangeAllocator::Free(uint64_t offset, uint64_t size) {
+        assert(size > 0 && offset + size <= m_capacity);
+        assert(m_used >= size);
+        m_used -= size;
+
+        auto next = m_free_by_offset.lower_bound(offset);
+        assert(next == m_free_by_offset.end() || next->first >= offset + size);
+        if (next != m_free_by_offset.end() && next->first == offset + size) {
+            size += next->second;
+            EraseFreeRange(next);
+        }
+        auto prev = m_free_by_offset.lower_bound(offset);
+        if (prev != m_free_by_offset.begin()) {
+            --prev;
+            assert(prev->first + prev->second <= offset);
+            if (prev->first + prev->second == offset) {
+                offset = prev->first;
+                size += prev->second;
+                EraseFreeRange(prev);
+            }
+        }
+        InsertFreeRange(offset, size);
+    }
+
+    void RangeAllocator::Clear() noexcept {
+        m_used = 0;
+        m_free_by_offset.clear();
+        m_free_by_size.clear();
+        if (m_capacity) InsertFreeRange(0, m_capacity);
+    }
+
+    void RangeAllocator::Compact(std::span<Relocation> ranges) {
+        std::vector<Relocation *> order;
+        order.reserve(ranges.size());
+        for (auto &range : ranges) order.push_back(&range);
+        std::sort(order.begin(), order.end(), [](const Relocation *a, const Relocation *b) {
+            return a->offset < b->offset;
+        });
+
+        uint64_t end = 0;
+        for (auto *range : order) {
+            assert(range->size > 0 && range->offset >= end);
+            range->new_offset = end;
+            end += range->size;
+        }
+        assert(end <= m_capacity);
+
+        m_used = end;
+        m_free_by_offset.clear();
+        m_free_by_size.clear();
+        if (end < m_capacity) InsertFreeRange(end, m_capacity - end);
+    }
+
+    uint64_t RangeAllocator::GetCapacity() const noexcept {
+        return m_capacity;
+    }
+
+    uint64_t RangeAllocator::GetUsedSize() const noexcept {
+        return m_used;
+    }
+
+    uint64_t RangeAllocator::GetLargestFreeRange() const noexcept {
+        return m_free_by_size.empty() ? 0 : m_free_by_size.rbegin()->first;
+    }
+
+    size_t RangeAllocator::GetFreeRangeCount() const noexcept {
+        return m_free_by_offset.size();
+    }
+
+    void RangeAllocator::InsertFreeRange(uint64_t offset, uint64_t size) {
+        m_free_by_offset.emplace(offset, size);
+        m_free_by_size.emplace(size, offset);
+    }
+
+    void RangeAllocator::EraseFreeRange(std::map<uint64_t, uint64_t>::iterator itr) {
+        assert(itr != m_free_by_offset.end());
+        auto [first, last] = m_free_by_size.equal_range(itr->second);
+        for (auto by_size = first; by_size != last; ++by_size) {
+            if (by_size->second == itr->first) {
+                m_free_by_size.erase(by_size);
+                break;
+            }
+        }
+        m_free_by_offset.erase(itr);
+    }
+} // namespace Engine
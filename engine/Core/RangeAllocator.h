@@ -0,0 +1,86 @@
+#ifndef CORE_RANGEALLOCATOR_INCLUDED
+#define CORE_RANGEALLOCATOR_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+
+namespace Engine {
+    /**
+     * @brief A best-fit allocator of ranges in an abstract address space of fixed capacity.
+     *
+     * It only does the bookkeeping of offsets, and is used to suballocate large GPU
+     * buffers. Each allocation takes the smallest free range that fits it, and freed
+     * ranges are merged with their free neighbours, which keeps fragmentation low.
+     * Allocations and frees take O(log n) for n free ranges.
+     */
+    class RangeAllocator {
+    public:
+        /// Returned by `Allocate()` when no free range is large enough.
+        static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+        /// @brief A live range moved by `Compact()`.
+        struct Relocation {
+            uint64_t offset;
+            uint64_t size;
+            /// Offset of the range after compaction, set by `Compact()`.
+            uint64_t new_offset;
+        };
+
+        explicit RangeAllocator(uint64_t capacity = 0);
+
+        /**
+         * @brief Allocate a range.
+         * @return The offset of the range, or `INVALID_OFFSET` if no free range is large enough.
+         */
+        uint64_t Allocate(uint64_t size);
+
+        /**
+         * @brief Free a range returned by `Allocate()`.
+         * @param offset The offset of the range.
+         * @param size The size passed to `Allocate()`.
+         */
+        void Free(uint64_t offset, uint64_t size);
+
+        /**
+         * @brief Free all ranges.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Pack live ranges to the front, leaving a single free range at the end.
+         *
+         * Ranges not in `ranges` are freed. The live ranges are placed one after another
+         * in the order of their offsets, so that every range only moves towards the front
+         * and keeps its place relative to the others. Moving the data is up to the caller.
+         *
+         * @param ranges Live ranges returned by `Allocate()`, in any order.
+         */
+        void Compact(std::span<Relocation> ranges);
+
+        uint64_t GetCapacity() const noexcept;
+
+        /// @brief Get the total size of allocated ranges.
+        uint64_t GetUsedSize() const noexcept;
+
+        /// @brief Get the size of the largest free range, i.e. the largest size that can be allocated.
+        uint64_t GetLargestFreeRange() const noexcept;
+
+        /// @brief Get the count of free ranges. Free space split into many ranges indicates fragmentation.
+        size_t GetFreeRangeCount() const noexcept;
+
+    protected:
+        void InsertFreeRange(uint64_t offset, uint64_t size);
+        void EraseFreeRange(std::map<uint64_t, uint64_t>::iterator itr);
+
+        uint64_t m_capacity;
+        uint64_t m_used{0};
+        // Free ranges keyed by offset, used to merge neighbours.
+        std::map<uint64_t, uint64_t> m_free_by_offset{};
+        // Free ranges keyed by size, used to find the best fit.
+        std::multimap<uint64_t, uint64_t> m_free_by_size{};
+    };
+} // namespace Engine
+
+#endif // CORE_RANGEALLOCATOR_INCLUDED
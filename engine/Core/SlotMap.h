@@ -0,0 +1,245 @@
+#ifndef CORE_SLOTMAP_INCLUDED
+#define CORE_SLOTMAP_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Engine {
+    /**
+     * @brief A generational slot map owning heap-allocated objects.
+     *
+     * Objects are addressed by 32-bit keys packing a slot index (low bits) and
+     * a generation (high bits). Key zero is always the null key, as slot zero
+     * is never handed out. Removing an object bumps the generation of its slot,
+     * so stale keys are rejected in O(1) instead of aliasing the next occupant.
+     *
+     * A key can be allocated before its object is committed to the dense
+     * storage, which allows the scene to resolve handles of objects still
+     * waiting in its command queue. Committed objects are kept in a dense array
+     * of owning pointers and removed by swap-and-pop, so iteration order is not
+     * preserved across removals but object addresses stay stable.
+     *
+     * @tparam T The stored object type.
+     */
+    template <typename T>
+    class SlotMap {
+    public:
+        using KeyType = uint32_t;
+
+        static constexpr uint32_t INDEX_BITS = 20;
+        static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+        static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+        static constexpr uint32_t INVALID_DENSE_INDEX = 0xFFFFFFFFu;
+
+        SlotMap() = default;
+
+        /// @brief Get the slot index encoded in a key.
+        static constexpr uint32_t GetIndex(KeyType key) noexcept {
+            return key & INDEX_MASK;
+        }
+
+        /// @brief Get the generation encoded in a key.
+        static constexpr uint32_t GetGeneration(KeyType key) noexcept {
+            return key >> INDEX_BITS;
+        }
+
+        /// @brief Pack a slot index and a generation into a key.
+        static constexpr KeyType MakeKey(uint32_t index, uint32_t generation) noexcept {
+            return ((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK);
+        }
+
+        /**
+         * @brief Allocate a key for an object that is not yet committed.
+         *
+         * The object becomes resolvable through `Get()` immediately, but it is
+         * owned by the caller until `Commit()` is called.
+         * @param ptr The object pointer to be associated with the key.
+         * @return The allocated key.
+         */
+        KeyType Allocate(T *ptr) {
+            uint32_t index;
+            if (!m_free_slots.empty()) {
+                index = m_free_slots.back();
+                m_free_slots.pop_back();
+            } else {
+                // Slot zero is reserved so that key zero never resolves.
+                if (m_slots.empty()) m_slots.push_back(Slot{nullptr, INVALID_DENSE_INDEX, 0});
+                index = static_cast<uint32_t>(m_slots.size());
+                assert(index <= INDEX_MASK && "Slot map capacity exceeded.");
+                m_slots.push_back(Slot{nullptr, INVALID_DENSE_INDEX, 0});
+            }
+            auto &slot = m_slots[index];
+            slot.ptr = ptr;
+            slot.dense = INVALID_DENSE_INDEX;
+            return MakeKey(index, slot.generation);
+        }
+
+        /**
+         * @brief Hand the ownership of an allocated object over to the slot map.
+         * @param key The key returned by `Allocate()`.
+         * @param ptr The owning pointer of the object.
+         */
+        void Commit(KeyType key, std::unique_ptr<T> ptr) {
+            auto *slot = GetSlot(key);
+            assert(slot && slot->ptr == ptr.get() && slot->dense == INVALID_DENSE_INDEX);
+            slot->dense = static_cast<uint32_t>(m_dense.size());
+            m_dense.push_back(std::move(ptr));
+            m_dense_keys.push_back(key);
+        }
+
+        /**
+         * @brief Remove an object from the slot map.
+         *
+         * The slot is recycled with a bumped generation. Slots whose generation
+         * would wrap around are retired instead of recycled.
+         * @param key The key of the object.
+         * @return The owning pointer of the object if it was committed, nullptr otherwise.
+         */
+        std::unique_ptr<T> Erase(KeyType key) {
+            auto *slot = GetSlot(key);
+            if (!slot) return nullptr;
+
+            std::unique_ptr<T> ret{};
+            if (slot->dense != INVALID_DENSE_INDEX) {
+                uint32_t dense = slot->dense;
+                uint32_t last = static_cast<uint32_t>(m_dense.size() - 1);
+                ret = std::move(m_dense[dense]);
+                if (dense != last) {
+                    m_dense[dense] = std::move(m_dense[last]);
+                    m_dense_keys[dense] = m_dense_keys[last];
+                    m_slots[GetIndex(m_dense_keys[dense])].dense = dense;
+                }
+                m_dense.pop_back();
+                m_dense_keys.pop_back();
+            }
+
+            slot->ptr = nullptr;
+            slot->dense = INVALID_DENSE_INDEX;
+            slot->generation = (slot->generation + 1) & GENERATION_MASK;
+            if (slot->generation != 0) {
+                m_free_slots.push_back(GetIndex(key));
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Resolve a key.
+         * @return The object pointer, or nullptr if the key is null or stale.
+         */
+        T *Get(KeyType key) const noexcept {
+            auto *slot = GetSlot(key);
+            return slot ? slot->ptr : nullptr;
+        }
+
+        /**
+         * @brief Get the position of an object in the dense array.
+         *
+         * Erasing an object moves the last object of the dense array into its
+         * position, which allows storage kept parallel to the dense array to be
+         * updated the same way.
+         * @return The dense index, or INVALID_DENSE_INDEX if the key is stale or not committed.
+         */
+        uint32_t GetDenseIndex(KeyType key) const noexcept {
+            auto *slot = GetSlot(key);
+            return slot ? slot->dense : INVALID_DENSE_INDEX;
+        }
+
+        /// @brief Check whether a key refers to a live object.
+        bool Contains(KeyType key) const noexcept {
+            return Get(key) != nullptr;
+        }
+
+        /// @brief Get the dense array of committed objects.
+        const std::vector<std::unique_ptr<T>> &GetDense() const noexcept {
+            return m_dense;
+        }
+
+        /// @brief Get the keys of committed objects, parallel to `GetDense()`.
+        const std::vector<KeyType> &GetDenseKeys() const noexcept {
+            return m_dense_keys;
+        }
+
+        /// @brief Get the count of committed objects.
+        size_t Size() const noexcept {
+            return m_dense.size();
+        }
+
+        /// @brief Reserve storage for the given count of objects.
+        void Reserve(size_t count) {
+            m_slots.reserve(count + 1);
+            m_dense.reserve(count);
+            m_dense_keys.reserve(count);
+        }
+
+        /**
+         * @brief Reserve storage for the given count of objects on top of the allocated ones.
+         * Storage grows geometrically, so that reserving small batches repeatedly stays amortized O(1).
+         * @param count The count of objects to be allocated and committed.
+         */
+        void ReserveAdditional(size_t count) {
+            size_t free_slots = m_free_slots.size();
+            if (count > free_slots) {
+                GrowCapacity(m_slots, m_slots.size() + count - free_slots + 1);
+            }
+            GrowCapacity(m_dense, m_dense.size() + count);
+            GrowCapacity(m_dense_keys, m_dense_keys.size() + count);
+        }
+
+        /**
+         * @brief Remove all objects.
+         *
+         * Generations are bumped for every occupied slot so that keys issued
+         * before clearing remain invalid afterwards.
+         */
+        void Clear() {
+            m_dense.clear();
+            m_dense_keys.clear();
+            m_free_slots.clear();
+            for (uint32_t i = 1; i < static_cast<uint32_t>(m_slots.size()); i++) {
+                auto &slot = m_slots[i];
+                if (slot.ptr) {
+                    slot.generation = (slot.generation + 1) & GENERATION_MASK;
+                }
+                slot.ptr = nullptr;
+                slot.dense = INVALID_DENSE_INDEX;
+                if (slot.generation != 0) m_free_slots.push_back(i);
+            }
+        }
+
+    protected:
+        struct Slot {
+            T *ptr;
+            uint32_t dense;
+            uint32_t generation;
+        };
+
+        const Slot *GetSlot(KeyType key) const noexcept {
+            uint32_t index = GetIndex(key);
+            if (index == 0 || index >= m_slots.size()) return nullptr;
+            const auto &slot = m_slots[index];
+            if (slot.ptr == nullptr || slot.generation != GetGeneration(key)) return nullptr;
+            return &slot;
+        }
+
+        Slot *GetSlot(KeyType key) noexcept {
+            return const_cast<Slot *>(static_cast<const SlotMap *>(this)->GetSlot(key));
+        }
+
+        template <typename V>
+        static void GrowCapacity(V &vector, size_t required) {
+            if (required > vector.capacity()) {
+                vector.reserve(std::max(required, vector.capacity() * 2));
+            }
+        }
+
+        std::vector<Slot> m_slots{};
+        std::vector<uint32_t> m_free_slots{};
+        std::vector<std::unique_ptr<T>> m_dense{};
+        std::vector<KeyType> m_dense_keys{};
+    };
+} // namespace Engine
+
+#endif // CORE_SLOTMAP_INCLUDED
@@ -1,4 +1,5 @@
 #include "Component.h"
+#include <Core/PoolAllocator.h>
 #include <Framework/object/GameObject.h>
 #include <Framework/world/Scene.h>
 #include <Reflection/serialization.h>
@@ -8,6 +9,23 @@ namespace Engine {
         m_parentGameObject(parent.GetHandle()), m_scene(parent.GetScene()) {
     }
 
+    void *Component::operator new(size_t size) {
+        return PoolAllocator::Allocate(size);
+    }
+
+    void *Component::operator new(size_t size, std::align_val_t alignment) {
+        // Over-aligned types are not pooled.
+        return ::operator new(size, alignment);
+    }
+
+    void Component::operator delete(void *ptr, size_t size) noexcept {
+        PoolAllocator::Deallocate(ptr, size);
+    }
+
+    void Component::operator delete(void *ptr, size_t size, std::align_val_t alignment) noexcept {
+        ::operator delete(ptr, size, alignment);
+    }
+
     void Component::Awake() {
     }
 
@@ -17,6 +35,10 @@ namespace Engine {
     void Component::Tick() {
     }
 
+    ComponentTickTraits Component::GetTickTraits() const noexcept {
+        return ComponentTickTraits{};
+    }
+
     ComponentHandle Component::GetHandle() const noexcept {
         return m_handle;
     }
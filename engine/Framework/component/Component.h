@@ -6,10 +6,24 @@
 #include <Reflection/macros.h>
 #include <Reflection/serialization_smart_pointer.h>
 #include <memory>
+#include <new>
 
 namespace Engine {
     class Scene;
 
+    /**
+     * @brief Scheduling traits of the Tick() of a Component type.
+     * Declared in Component classes with the REFL_TICK_TRAITS macro.
+     */
+    struct ComponentTickTraits {
+        /// Components tick in ascending group order, with a barrier between groups.
+        uint8_t group{0};
+        /// Whether Tick() may run on a worker thread concurrently with other thread-safe Components of the group.
+        /// Such a Tick() may only modify its own Component, may read but not modify transforms,
+        /// and must not create or remove GameObjects or Components.
+        bool thread_safe{false};
+    };
+
     /**
      * @brief Components contains the actual functional logic and data of the game.
      * Component is attached to GameObjects, and is responsible for the behavior of the GameObject.
@@ -19,6 +33,8 @@ namespace Engine {
      * Each Component must have Init() and Tick() functions.
      * Init() is called when the parent GameObject is added to a running scene.
      * Tick() is called every frame.
+     * The scene only dispatches them to reflected Component types that override them,
+     * so Components that only hold data should not override them with empty functions.
      */
     class REFL_SER_CLASS(REFL_WHITELIST) Component {
         REFL_SER_BODY(Component)
@@ -35,6 +51,15 @@ namespace Engine {
         Component &operator=(const Component &other) = delete;
         Component &operator=(Component &&other) = delete;
 
+        /**
+         * @brief Allocate Components from the size-class pools of PoolAllocator,
+         * so that Components created in a batch are contiguous in memory.
+         */
+        static void *operator new(size_t size);
+        static void *operator new(size_t size, std::align_val_t alignment);
+        static void operator delete(void *ptr, size_t size) noexcept;
+        static void operator delete(void *ptr, size_t size, std::align_val_t alignment) noexcept;
+
         /**
          * @brief Called when the component becomes active in the scene.
          * This is called before Init() when the component is loaded or added.
@@ -52,6 +77,12 @@ namespace Engine {
          */
         REFL_ENABLE virtual void Tick();
 
+        /**
+         * @brief Get the scheduling traits of Tick().
+         * Overridden by the REFL_TICK_TRAITS macro. By default Components tick in group 0 on the main thread.
+         */
+        virtual ComponentTickTraits GetTickTraits() const noexcept;
+
         /**
          * @brief Get the Component handle.
          * @return The Component handle.
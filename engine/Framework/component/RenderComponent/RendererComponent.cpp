@@ -1,11 +1,41 @@
 #include "RendererComponent.h"
 
+#include "Core/Math/TransformHierarchy.h"
+#include "Framework/component/TransformComponent/TransformComponent.h"
 #include "Framework/object/GameObject.h"
 #include "MainClass.h"
 #include "Render/RenderSystem.h"
 #include "Render/RenderSystem/RendererManager.h"
+#include "Reflection/Type.h"
+
+#include <typeindex>
+#include <unordered_map>
 
 namespace Engine {
+    namespace {
+        /// @brief Check in the reflection system if the dynamic type of a renderer overrides GetWorldTransform().
+        bool OverridesWorldTransform(const RendererComponent &renderer) {
+            static std::unordered_map<std::type_index, bool> overrides;
+            std::type_index dynamic_type(typeid(renderer));
+            auto it = overrides.find(dynamic_type);
+            if (it != overrides.end()) return it->second;
+
+            // Overrides in types unknown to the reflection system cannot be ruled out.
+            bool result = true;
+            const auto &types = Reflection::Type::s_index_type_map;
+            auto dynamic_reflected = types.find(dynamic_type);
+            auto renderer_reflected = types.find(std::type_index(typeid(RendererComponent)));
+            if (dynamic_reflected != types.end() && renderer_reflected != types.end()
+                && dynamic_reflected->second->IsReflectable() && renderer_reflected->second->IsReflectable()) {
+                auto base_type = renderer_reflected->second;
+                if (dynamic_reflected->second->IsDerivedFrom(base_type)) {
+                    result = dynamic_reflected->second->OverridesMethod("GetWorldTransform");
+                }
+            }
+            return overrides[dynamic_type] = result;
+        }
+    } // namespace
+
     RendererComponent::RendererComponent(const GameObject &parent) : Component(parent) {
     }
 
@@ -30,9 +60,8 @@ namespace Engine {
     }
 
     void RendererComponent::Awake() {
-    }
-
-    void RendererComponent::Tick() {
+        // Renderer handles are (re-)registered on awake and need a fresh model matrix.
+        m_uploaded_world_version = 0;
     }
 
     void RendererComponent::PreRenderUpdate() {
@@ -43,6 +72,36 @@ namespace Engine {
             rm->UpdateModelMatrix(h, model);
         }
     }
+
+    void RendererComponent::CollectModelMatrixUpdates(
+        const TransformHierarchy &hierarchy, RendererList &handles, std::vector<glm::mat4> &matrices
+    ) {
+        if (m_renderer_handles.empty()) return;
+        if (OverridesWorldTransform(*this)) {
+            // The overridden transform may not come from the hierarchy, so it is uploaded every frame.
+            glm::mat4 model = GetWorldTransform().GetTransformMatrix();
+            for (auto h : m_renderer_handles) {
+                handles.push_back(h);
+                matrices.push_back(model);
+            }
+            return;
+        }
+
+        auto parentGameObject = this->GetParentGameObject();
+        assert(parentGameObject && "A renderer component has no parent game object.");
+        auto node = parentGameObject->GetTransformComponent()->GetHierarchyNode();
+        if (node >= hierarchy.GetNodeCount()) return;
+
+        auto version = hierarchy.GetWorldMatrixVersion(node);
+        if (version == m_uploaded_world_version) return;
+        m_uploaded_world_version = version;
+
+        const auto &model = hierarchy.GetWorldMatrix(node);
+        for (auto h : m_renderer_handles) {
+            handles.push_back(h);
+            matrices.push_back(model);
+        }
+    }
 } // namespace Engine
 
 #include "__generated__/RendererComponent.h.inc"
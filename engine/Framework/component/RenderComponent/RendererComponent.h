@@ -10,10 +10,14 @@
 #include <vector>
 
 namespace Engine {
+    class TransformHierarchy;
+
     class REFL_SER_CLASS(REFL_WHITELIST) RendererComponent : public Component {
         REFL_SER_BODY(RendererComponent)
     protected:
         RendererList m_renderer_handles{};
+        /// @brief Version of the world matrix in the scene transform hierarchy last collected for upload.
+        uint64_t m_uploaded_world_version{0};
 
     public:
         REFL_SER_ENABLE RendererComponent(const GameObject &parent);
@@ -26,10 +30,24 @@ namespace Engine {
 
         virtual void UnregisterFromRenderSystem();
         virtual void Awake() override;
-        virtual void Tick() override;
 
         void PreRenderUpdate();
 
+        /**
+         * @brief Collect model matrix updates from the scene transform hierarchy.
+         *
+         * Appends the renderer handles and the world matrix of the parent GameObject
+         * to the output lists, but only if the world matrix changed since the last collection.
+         * Types overriding GetWorldTransform(), or unknown to the reflection system, append
+         * the overridden transform instead, every time like PreRenderUpdate().
+         * @param hierarchy The up-to-date transform hierarchy of the scene.
+         * @param handles The output list of renderer handles.
+         * @param matrices The output list of model matrices, parallel to handles.
+         */
+        void CollectModelMatrixUpdates(
+            const TransformHierarchy &hierarchy, RendererList &handles, std::vector<glm::mat4> &matrices
+        );
+
         REFL_SER_ENABLE std::vector<AssetRef> m_material_assets{};
         /// @brief Is this renderer eagerly loaded onto the GPU instead of loaded on use?
         REFL_SER_ENABLE bool m_is_eagerly_loaded{false};
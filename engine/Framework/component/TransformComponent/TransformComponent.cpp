@@ -1,6 +1,16 @@
 #include "Framework/component/TransformComponent/TransformComponent.h"
 #include "TransformComponent.h"
 #include <Framework/object/GameObject.h>
+#include <Framework/world/Scene.h>
+#include <Framework/world/TickScheduler.h>
+#include <cassert>
+#include <mutex>
+
+namespace {
+    // Serializes filling caches read from thread-safe Ticks. Recursive, as filling the cache of
+    // a component fills the caches of its ancestors first.
+    std::recursive_mutex g_world_cache_mutex{};
+} // namespace
 
 namespace Engine {
     TransformComponent::TransformComponent(const GameObject &parent) : Component(parent) {
@@ -9,11 +19,14 @@ namespace Engine {
     TransformComponent::~TransformComponent() {
     }
 
-    void TransformComponent::Tick() {
+    void TransformComponent::Awake() {
+        // Fields may have been deserialized after the cache was built.
+        MarkLocalTransformDirty();
     }
 
     void TransformComponent::SetTransform(const Transform &transform) {
         m_transform = transform;
+        MarkLocalTransformDirty();
     }
 
     const Transform &TransformComponent::GetTransform() const {
@@ -21,8 +34,76 @@ namespace Engine {
     }
 
     Transform &TransformComponent::GetTransformRef() {
+        MarkLocalTransformDirty();
         return m_transform;
     }
+
+    const Transform &TransformComponent::GetWorldTransform() const {
+        if (m_world_dirty.load(std::memory_order_acquire)) UpdateWorldTransform();
+        return m_world_transform;
+    }
+
+    const glm::mat4 &TransformComponent::GetWorldTransformMatrix() const {
+        if (m_world_dirty.load(std::memory_order_acquire)) UpdateWorldTransform();
+        return m_world_matrix;
+    }
+
+    void TransformComponent::MarkWorldTransformDirty() noexcept {
+        assert(!TickScheduler::IsInParallelTick() && "Transforms must not be modified from thread-safe Ticks.");
+        // A dirty component always has a dirty subtree, as computing the cache
+        // of a component computes the caches of all its ancestors first.
+        if (m_world_dirty.load(std::memory_order_relaxed)) return;
+        m_world_dirty.store(true, std::memory_order_relaxed);
+
+        auto go = GetParentGameObject();
+        if (!go) return;
+        for (auto child : go->GetChildren()) {
+            auto child_go = GetScene()->GetGameObject(child);
+            if (!child_go) continue;
+            if (auto child_transform = child_go->GetTransformComponent()) {
+                child_transform->MarkWorldTransformDirty();
+            }
+        }
+    }
+
+    void TransformComponent::MarkLocalTransformDirty() noexcept {
+        MarkWorldTransformDirty();
+        if (!m_local_change_queued) {
+            m_local_change_queued = true;
+            GetScene()->NotifyLocalTransformChanged(GetHandle());
+        }
+    }
+
+    uint32_t TransformComponent::GetHierarchyNode() const noexcept {
+        return m_hierarchy_node;
+    }
+
+    bool TransformComponent::IsWorldTransformDirty() const noexcept {
+        return m_world_dirty.load(std::memory_order_acquire);
+    }
+
+    void TransformComponent::UpdateWorldTransform() const {
+        std::lock_guard lock(g_world_cache_mutex);
+        // Another thread may have filled the cache in between.
+        if (!m_world_dirty.load(std::memory_order_relaxed)) return;
+
+        const TransformComponent *parent_transform = nullptr;
+        auto go = GetParentGameObject();
+        if (go && go->GetParent().IsValid()) {
+            if (auto parent_go = GetScene()->GetGameObject(go->GetParent())) {
+                parent_transform = parent_go->GetTransformComponent();
+            }
+        }
+
+        if (parent_transform) {
+            m_world_matrix = parent_transform->GetWorldTransformMatrix() * m_transform.GetTransformMatrix();
+            m_world_transform = parent_transform->GetWorldTransform() * m_transform;
+        } else {
+            m_world_matrix = m_transform.GetTransformMatrix();
+            m_world_transform = m_transform;
+        }
+        m_world_dirty.store(false, std::memory_order_release);
+    }
 } // namespace Engine
 
 #include "__generated__/TransformComponent.h.inc"
@@ -2,21 +2,37 @@
 #define FRAMEWORK_COMPONENT_TRANSFORMCOMPONENT_TRANSFORMCOMPONENT_INCLUDED
 
 #include <Core/Math/Transform.h>
+#include <Core/Math/TransformHierarchy.h>
 #include <Framework/component/Component.h>
 #include <Reflection/macros.h>
+#include <atomic>
 #include <glm.hpp>
 
 namespace Engine {
     class Transform;
     class GameObject;
 
+    /**
+     * @brief Component holding the local transform of a GameObject.
+     *
+     * The local-to-world transform is cached and recomputed lazily. Changing
+     * the local transform or the parent of the GameObject invalidates the
+     * cache of this component and of all its descendants.
+     *
+     * Local transform changes are also reported to the Scene, which mirrors
+     * all transforms in a TransformHierarchy for batched world matrix updates.
+     *
+     * Transforms must not be modified from thread-safe Ticks, which asserts in
+     * debug builds, as invalidating the cache touches the descendants. They may
+     * be read from there: filling the cache is serialized.
+     */
     class REFL_SER_CLASS(REFL_WHITELIST) TransformComponent : public Component {
         REFL_SER_BODY(TransformComponent)
     public:
         REFL_ENABLE TransformComponent(const GameObject &parent);
         virtual ~TransformComponent();
 
-        void Tick() override;
+        void Awake() override;
 
         void SetTransform(const Transform &transform);
 
@@ -25,11 +41,50 @@ namespace Engine {
         const Transform &GetTransform() const;
 
         /// @brief Get the transform that transform local coordinate to parent local coordinate
+        ///
+        /// The cached world transform is invalidated on every call, as the
+        /// returned reference is expected to be modified immediately.
+        /// Do not hold the reference across frames.
         /// @return Transform
         Transform &GetTransformRef();
 
+        /// @brief Get the transform that transform local coordinate to world coordinate
+        /// @return Transform composed from all ancestors
+        const Transform &GetWorldTransform() const;
+
+        /// @brief Get the matrix that transform local coordinate to world coordinate
+        /// @return Product of the local matrices of all ancestors and this component
+        const glm::mat4 &GetWorldTransformMatrix() const;
+
+        /// @brief Invalidate the cached world transform of this component and all its descendants.
+        void MarkWorldTransformDirty() noexcept;
+
+        /// @brief Report an in-place modification of the local transform.
+        /// Invalidates the cached world transform and queues the change for the scene transform hierarchy.
+        void MarkLocalTransformDirty() noexcept;
+
+        /// @brief Get the index of this component in the scene transform hierarchy.
+        /// @return The node index, or TransformHierarchy::INVALID_NODE if not yet added.
+        uint32_t GetHierarchyNode() const noexcept;
+
+        /// @brief Check whether the cached world transform needs recomputation.
+        bool IsWorldTransformDirty() const noexcept;
+
     public:
         REFL_SER_ENABLE Transform m_transform{};
+
+    private:
+        friend class Scene;
+
+        void UpdateWorldTransform() const;
+
+        uint32_t m_hierarchy_node{TransformHierarchy::INVALID_NODE};
+        bool m_local_change_queued{false};
+
+        mutable Transform m_world_transform{};
+        mutable glm::mat4 m_world_matrix{1.0f};
+        // Written with the release order after filling the cache, which may happen on worker threads.
+        mutable std::atomic<bool> m_world_dirty{true};
     };
 } // namespace Engine
 
@@ -1,4 +1,5 @@
 #include "GameObject.h"
+#include <Core/PoolAllocator.h>
 #include <Framework/component/Component.h>
 #include <Framework/component/TransformComponent/TransformComponent.h>
 #include <Framework/object/GameObject.h>
@@ -11,6 +12,23 @@ namespace Engine {
     GameObject::GameObject(Scene *scene) : m_scene(scene) {
     }
 
+    void *GameObject::operator new(size_t size) {
+        return PoolAllocator::Allocate(size);
+    }
+
+    void *GameObject::operator new(size_t size, std::align_val_t alignment) {
+        // Over-aligned types are not pooled.
+        return ::operator new(size, alignment);
+    }
+
+    void GameObject::operator delete(void *ptr, size_t size) noexcept {
+        PoolAllocator::Deallocate(ptr, size);
+    }
+
+    void GameObject::operator delete(void *ptr, size_t size, std::align_val_t alignment) noexcept {
+        ::operator delete(ptr, size, alignment);
+    }
+
     const Transform &GameObject::GetTransform() const {
         return m_scene->GetComponent<TransformComponent>(m_transformComponent)->GetTransform();
     }
@@ -19,10 +37,12 @@ namespace Engine {
     }
 
     Transform GameObject::GetWorldTransform() {
-        if (m_parentGameObject.IsValid()) {
-            return m_scene->GetGameObject(m_parentGameObject)->GetWorldTransform() * GetTransform();
-        }
-        return GetTransform();
+        return GetTransformComponent()->GetWorldTransform();
+    }
+
+    TransformComponent *GameObject::GetTransformComponent() const {
+        // The handle always refers to a TransformComponent, so skip the dynamic_cast.
+        return static_cast<TransformComponent *>(m_scene->GetComponent(m_transformComponent));
     }
 
     void GameObject::SetTransform(const Transform &transform) {
@@ -54,6 +74,11 @@ namespace Engine {
                 new_children.push_back(m_handle);
             }
         }
+
+        if (auto transform = GetTransformComponent()) {
+            transform->MarkWorldTransformDirty();
+        }
+        m_scene->MarkTransformHierarchyDirty();
     }
 
     ObjectHandle GameObject::GetParent() const noexcept {
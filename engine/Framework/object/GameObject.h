@@ -7,6 +7,7 @@
 #include <Reflection/serialization_smart_pointer.h>
 #include <Reflection/serialization_vector.h>
 #include <memory>
+#include <new>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,15 @@ namespace Engine {
         GameObject &operator=(const GameObject &other) = delete;
         GameObject &operator=(GameObject &&other) = delete;
 
+        /**
+         * @brief Allocate GameObjects from the size-class pools of PoolAllocator,
+         * so that GameObjects created in a batch are contiguous in memory.
+         */
+        static void *operator new(size_t size);
+        static void *operator new(size_t size, std::align_val_t alignment);
+        static void operator delete(void *ptr, size_t size) noexcept;
+        static void operator delete(void *ptr, size_t size, std::align_val_t alignment) noexcept;
+
         /**
          * @brief Add a component of type T to the GameObject.
          * @tparam T T must be derived from Component
@@ -67,11 +77,18 @@ namespace Engine {
 
         /**
          * @brief Get the world Transform of the GameObject.
-         * This will traverse the parent GameObject tree to get the world Transform.
-         * @return The reference to the world Transform.
+         * The world Transform is cached in the TransformComponent, and the parent
+         * GameObject tree is only traversed when the cache is invalidated.
+         * @return The world Transform.
          */
         REFL_ENABLE Transform GetWorldTransform();
 
+        /**
+         * @brief Get the TransformComponent of the GameObject.
+         * @return The pointer to the TransformComponent. nullptr if not found.
+         */
+        TransformComponent *GetTransformComponent() const;
+
         /**
          * @brief Set the parent GameObject of the GameObject.
          * @param parent The parent GameObject handle.
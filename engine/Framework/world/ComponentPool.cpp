@@ -0,0 +1,50 @@
+#include "ComponentPool.h"
+
+#include <cassert>
+
+namespace Engine {
+    ComponentPool::ComponentPool(std::type_index type, ProbeFunc probe) : m_type(type), m_probe(probe) {
+    }
+
+    std::type_index ComponentPool::GetType() const noexcept {
+        return m_type;
+    }
+
+    bool ComponentPool::Probe(Component *component) const {
+        return m_probe(component);
+    }
+
+    void ComponentPool::Insert(uint32_t slot, Component *component) {
+        if (slot >= m_sparse.size()) {
+            m_sparse.resize(slot + 1, INVALID_DENSE_INDEX);
+        }
+        assert(m_sparse[slot] == INVALID_DENSE_INDEX && "Component is already in the pool.");
+        m_sparse[slot] = static_cast<uint32_t>(m_dense.size());
+        m_dense.push_back(component);
+        m_dense_slots.push_back(slot);
+    }
+
+    void ComponentPool::Remove(uint32_t slot) noexcept {
+        if (slot >= m_sparse.size() || m_sparse[slot] == INVALID_DENSE_INDEX) return;
+        uint32_t dense = m_sparse[slot];
+        uint32_t last = static_cast<uint32_t>(m_dense.size() - 1);
+        if (dense != last) {
+            m_dense[dense] = m_dense[last];
+            m_dense_slots[dense] = m_dense_slots[last];
+            m_sparse[m_dense_slots[dense]] = dense;
+        }
+        m_dense.pop_back();
+        m_dense_slots.pop_back();
+        m_sparse[slot] = INVALID_DENSE_INDEX;
+    }
+
+    void ComponentPool::Clear() noexcept {
+        m_sparse.clear();
+        m_dense.clear();
+        m_dense_slots.clear();
+    }
+
+    const std::vector<Component *> &ComponentPool::GetComponents() const noexcept {
+        return m_dense;
+    }
+} // namespace Engine
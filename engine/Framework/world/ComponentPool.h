@@ -0,0 +1,123 @@
+#ifndef FRAMEWORK_WORLD_COMPONENTPOOL_INCLUDED
+#define FRAMEWORK_WORLD_COMPONENTPOOL_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <typeindex>
+#include <vector>
+
+namespace Engine {
+    class Component;
+
+    /**
+     * @brief A dense list of all committed Components of a type, including Components of derived types.
+     *
+     * The pool is a sparse set indexed by the slot index of the Component handle, so insertion
+     * and removal are O(1) and iteration touches only the pooled Components. The order is not
+     * preserved across removals.
+     */
+    class ComponentPool {
+    public:
+        // Tell whether a Component is an instance of the pooled type. Used for unreflected types.
+        using ProbeFunc = bool (*)(Component *);
+
+        ComponentPool(std::type_index type, ProbeFunc probe);
+
+        /**
+         * @brief Get the type of the pool.
+         */
+        std::type_index GetType() const noexcept;
+
+        /**
+         * @brief Check whether a Component is an instance of the pooled type by `dynamic_cast`.
+         */
+        bool Probe(Component *component) const;
+
+        /**
+         * @brief Add a Component to the pool.
+         * @param slot The slot index of the Component handle.
+         * @param component The Component pointer.
+         */
+        void Insert(uint32_t slot, Component *component);
+
+        /**
+         * @brief Remove a Component from the pool. Does nothing if the slot is not in the pool.
+         * @param slot The slot index of the Component handle.
+         */
+        void Remove(uint32_t slot) noexcept;
+
+        /**
+         * @brief Remove all Components from the pool.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief Get the pooled Components.
+         */
+        const std::vector<Component *> &GetComponents() const noexcept;
+
+    protected:
+        static constexpr uint32_t INVALID_DENSE_INDEX = 0xFFFFFFFFu;
+
+        std::type_index m_type;
+        ProbeFunc m_probe;
+
+        std::vector<uint32_t> m_sparse{};
+        std::vector<Component *> m_dense{};
+        std::vector<uint32_t> m_dense_slots{};
+    };
+
+    /**
+     * @brief A view over a ComponentPool yielding references of the pooled type.
+     * @tparam T The pooled type.
+     */
+    template <typename T>
+    class ComponentView {
+    public:
+        class Iterator {
+        public:
+            using Base = std::vector<Component *>::const_iterator;
+
+            explicit Iterator(Base it) : m_it(it) {
+            }
+
+            T &operator*() const {
+                return *static_cast<T *>(*m_it);
+            }
+            Iterator &operator++() {
+                ++m_it;
+                return *this;
+            }
+            bool operator==(const Iterator &other) const {
+                return m_it == other.m_it;
+            }
+            bool operator!=(const Iterator &other) const {
+                return m_it != other.m_it;
+            }
+
+        private:
+            Base m_it;
+        };
+
+        explicit ComponentView(const std::vector<Component *> &components) : m_components(components) {
+        }
+
+        Iterator begin() const {
+            return Iterator(m_components.begin());
+        }
+        Iterator end() const {
+            return Iterator(m_components.end());
+        }
+        size_t size() const noexcept {
+            return m_components.size();
+        }
+        bool empty() const noexcept {
+            return m_components.empty();
+        }
+
+    private:
+        const std::vector<Component *> &m_components;
+    };
+} // namespace Engine
+
+#endif // FRAMEWORK_WORLD_COMPONENTPOOL_INCLUDED
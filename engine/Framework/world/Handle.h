@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <type_traits>
 
 namespace Engine {
     namespace Serialization {
@@ -17,74 +18,91 @@ namespace Engine {
          * @brief Base class for all handles.
          * Handles are used to identify GameObjects and Components in the scene.
          * It contains the scene ID and the ID of the GameObject or Component.
-         * IDs are usually assigned in integer order
+         * IDs are slot map keys of the scene, which pack a slot index and a generation.
+         *
+         * Handles are trivially copyable 8-byte values: the scene ID is stored in the high 32 bits
+         * and the ID in the low 32 bits of a single integer, so handle arrays are dense and
+         * comparing or hashing a handle is a single integer operation.
          */
         class HandleBase {
         public:
-            HandleBase() = default;
-            HandleBase(uint32_t ID);
-            virtual ~HandleBase() = default;
+            constexpr HandleBase() noexcept = default;
+            constexpr HandleBase(uint32_t ID) noexcept : m_value(ID) {
+            }
 
             /**
              * @brief Get the scene ID.
              * @return The scene ID.
              */
-            virtual uint32_t GetSceneID() const noexcept;
+            constexpr uint32_t GetSceneID() const noexcept {
+                return static_cast<uint32_t>(m_value >> 32);
+            }
 
             /**
              * @brief Get the ID of the GameObject or Component.
              * @return The ID of the GameObject or Component.
              */
-            virtual uint32_t GetID() const noexcept;
+            constexpr uint32_t GetID() const noexcept {
+                return static_cast<uint32_t>(m_value);
+            }
+
+            /**
+             * @brief Get the packed value of the handle, with the scene ID in the high 32 bits.
+             * @return The packed value.
+             */
+            constexpr uint64_t GetValue() const noexcept {
+                return m_value;
+            }
 
             /**
              * @brief Check if the handle is valid (ID is not zero).
              * @return True if the handle is valid, False otherwise.
              */
-            virtual bool IsValid() const noexcept;
+            constexpr bool IsValid() const noexcept {
+                return GetID() != 0;
+            }
 
             /**
-             * @brief Reset the handle to a null handle (ID is zero).
+             * @brief Reset the handle to a null handle (ID is zero). The scene ID is kept.
              */
-            virtual void Reset() noexcept;
+            constexpr void Reset() noexcept {
+                m_value &= ~uint64_t{0xFFFFFFFFu};
+            }
 
             /**
              * @brief Check if the handles are equal.
-             * Only check the ID. Ignore the scene ID.
+             * Both the scene ID and the ID are compared.
              * @param other The other handle to compare with.
              * @return True if the handles are equal, False otherwise.
              */
-            bool operator==(const HandleBase &other) const noexcept;
-
-            /**
-             * @brief Custom serialization function.
-             * Save the ID only. Ignore the scene ID.
-             */
-            virtual void save_to_archive(Engine::Serialization::Archive &archive) const;
-
-            /**
-             * @brief Custom deserialization function.
-             * Load the ID only. Ignore the scene ID.
-             */
-            virtual void load_from_archive(Engine::Serialization::Archive &) = 0;
+            constexpr bool operator==(const HandleBase &other) const noexcept {
+                return m_value == other.m_value;
+            }
 
         protected:
-            uint32_t m_sceneID{};
-            uint32_t m_ID{};
+            uint64_t m_value{};
 
-            HandleBase(uint32_t sceneID, uint32_t ID);
+            constexpr HandleBase(uint32_t sceneID, uint32_t ID) noexcept :
+                m_value(static_cast<uint64_t>(sceneID) << 32 | ID) {
+            }
         };
     } // namespace detail
 
     /**
      * @brief Handle for GameObjects.
      * It contains the scene ID and the ID of the GameObject.
-     * IDs are usually assigned in integer order
+     * The ID is a key of the scene slot map: the slot index in the low `SlotMap::INDEX_BITS` bits
+     * and the generation of the slot in the remaining high bits.
+     * Handles are equal only if they refer to the same slot of the same scene in the same generation,
+     * so the handle of a removed GameObject never equals the handle of one reusing its slot.
+     * IDs do not follow creation order, as slots are recycled. Compare `GetValue()` only for an
+     * arbitrary but stable order, e.g. in sorted containers.
      */
     class ObjectHandle : public detail::HandleBase {
     public:
-        ObjectHandle() = default;
-        ObjectHandle(uint32_t ID);
+        constexpr ObjectHandle() noexcept = default;
+        constexpr ObjectHandle(uint32_t ID) noexcept : detail::HandleBase(ID) {
+        }
 
         /**
          * @brief Get the GameObject associated with the handle.
@@ -94,27 +112,27 @@ namespace Engine {
          */
         GameObject *GetGameObject() const;
 
-        /**
-         * @brief Custom deserialization function.
-         * Use HandleResolver to load handle.
-         * HandleResolver can manage the ObjectHandle in different scenes.
-         */
-        virtual void load_from_archive(Engine::Serialization::Archive &archive) override;
-
     protected:
         friend class Scene;
-        ObjectHandle(uint32_t sceneID, uint32_t ID);
+        constexpr ObjectHandle(uint32_t sceneID, uint32_t ID) noexcept : detail::HandleBase(sceneID, ID) {
+        }
     };
 
     /**
      * @brief Handle for Components.
      * It contains the scene ID and the ID of the Component.
-     * IDs are usually assigned in integer order
+     * The ID is a key of the scene slot map: the slot index in the low `SlotMap::INDEX_BITS` bits
+     * and the generation of the slot in the remaining high bits.
+     * Handles are equal only if they refer to the same slot of the same scene in the same generation,
+     * so the handle of a removed Component never equals the handle of one reusing its slot.
+     * IDs do not follow creation order, as slots are recycled. Compare `GetValue()` only for an
+     * arbitrary but stable order, e.g. in sorted containers.
      */
     class ComponentHandle : public detail::HandleBase {
     public:
-        ComponentHandle() = default;
-        ComponentHandle(uint32_t ID);
+        constexpr ComponentHandle() noexcept = default;
+        constexpr ComponentHandle(uint32_t ID) noexcept : detail::HandleBase(ID) {
+        }
 
         /**
          * @brief Get the Component associated with the handle.
@@ -124,30 +142,47 @@ namespace Engine {
          */
         Component *GetComponent() const;
 
-        /**
-         * @brief Custom deserialization function.
-         * Use HandleResolver to load handle.
-         * HandleResolver can manage the ComponentHandle in different scenes.
-         */
-        virtual void load_from_archive(Engine::Serialization::Archive &archive) override;
-
     protected:
         friend class Scene;
-        ComponentHandle(uint32_t sceneID, uint32_t ID);
+        constexpr ComponentHandle(uint32_t sceneID, uint32_t ID) noexcept : detail::HandleBase(sceneID, ID) {
+        }
     };
+
+    static_assert(sizeof(ObjectHandle) == 8 && std::is_trivially_copyable_v<ObjectHandle>);
+    static_assert(sizeof(ComponentHandle) == 8 && std::is_trivially_copyable_v<ComponentHandle>);
+
+    /**
+     * @brief Custom serialization function.
+     * Save the ID only. Ignore the scene ID.
+     */
+    void save_to_archive(const detail::HandleBase &handle, Serialization::Archive &archive);
+
+    /**
+     * @brief Custom deserialization function.
+     * Use HandleResolver to load handle.
+     * HandleResolver can manage the ObjectHandle in different scenes.
+     */
+    void load_from_archive(ObjectHandle &handle, Serialization::Archive &archive);
+
+    /**
+     * @brief Custom deserialization function.
+     * Use HandleResolver to load handle.
+     * HandleResolver can manage the ComponentHandle in different scenes.
+     */
+    void load_from_archive(ComponentHandle &handle, Serialization::Archive &archive);
 } // namespace Engine
 
 namespace std {
     template <>
     struct hash<Engine::ObjectHandle> {
         size_t operator()(const Engine::ObjectHandle &p) const noexcept {
-            return std::hash<uint64_t>()((uint64_t)p.GetSceneID() << 32 | p.GetID());
+            return std::hash<uint64_t>()(p.GetValue());
         }
     };
     template <>
     struct hash<Engine::ComponentHandle> {
         size_t operator()(const Engine::ComponentHandle &p) const noexcept {
-            return std::hash<uint64_t>()((uint64_t)p.GetSceneID() << 32 | p.GetID());
+            return std::hash<uint64_t>()(p.GetValue());
         }
     };
 } // namespace std
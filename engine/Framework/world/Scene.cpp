@@ -2,15 +2,31 @@
 #include <Asset/Scene/SceneAsset.h>
 #include <Core/Delegate/Delegate.h>
 #include <Core/Functional/EventQueue.h>
+#include <Core/Math/TransformHierarchy.h>
 #include <Framework/component/TransformComponent/TransformComponent.h>
 #include <Framework/object/GameObject.h>
+#include <Framework/world/TickScheduler.h>
 #include <Framework/world/WorldSystem.h>
 #include <Reflection/Type.h>
 #include <algorithm>
 
+namespace {
+    // Grow geometrically, so that reserving small batches repeatedly stays amortized O(1).
+    template <typename V>
+    void ReserveAdditional(V &vector, size_t count) {
+        size_t required = vector.size() + count;
+        if (required > vector.capacity()) {
+            vector.reserve(std::max(required, vector.capacity() * 2));
+        }
+    }
+} // namespace
+
 namespace Engine {
-    Scene::Scene(uint32_t sceneID, bool enable_rendering) : m_sceneID(sceneID), m_enable_rendering(enable_rendering) {
+    Scene::Scene(uint32_t sceneID, bool enable_rendering) :
+        m_sceneID(sceneID), m_game_objects(), m_components(), m_enable_rendering(enable_rendering) {
         m_event_queue = std::make_unique<EventQueue>(*this);
+        m_transform_hierarchy = std::make_unique<TransformHierarchy>();
+        m_tick_scheduler = std::make_unique<TickScheduler>();
     }
 
     Scene::~Scene() {
@@ -29,16 +45,46 @@ namespace Engine {
 
     GameObject &Scene::CreateGameObject() {
         auto go_ptr = std::unique_ptr<GameObject>(new GameObject(this));
-        auto handle = NextAvailableGameObjectHandle();
+        auto handle = AllocateGameObjectHandle(go_ptr.get());
         auto &ret = *go_ptr;
         go_ptr->m_handle = handle;
-        m_go_map[handle] = go_ptr.get();
         auto &transform_component = go_ptr->template AddComponent<TransformComponent>();
         go_ptr->m_transformComponent = transform_component.m_handle;
         m_go_add_queue.push_back(std::move(go_ptr));
         return ret;
     }
 
+    std::vector<ObjectHandle> Scene::CreateGameObjectBatch(uint32_t count, uint32_t extra_components) {
+        size_t component_count = size_t{count} * (extra_components + 1);
+        m_game_objects.ReserveAdditional(m_go_add_queue.size() + count);
+        m_components.ReserveAdditional(m_comp_add_queue.size() + component_count);
+        ReserveAdditional(m_go_add_queue, count);
+        ReserveAdditional(m_comp_add_queue, component_count);
+        // Init events are queued when the batch is flushed.
+        m_event_queue->Reserve(component_count);
+        PoolAllocator::Reserve(sizeof(GameObject), count);
+        PoolAllocator::Reserve(sizeof(TransformComponent), count);
+        {
+            // Every TransformComponent queues a local transform change when it is awoken.
+            std::lock_guard lock(m_changed_transforms_mutex);
+            ReserveAdditional(m_changed_transforms, count);
+        }
+
+        std::vector<ObjectHandle> handles{};
+        handles.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            auto go_ptr = std::unique_ptr<GameObject>(new GameObject(this));
+            auto handle = AllocateGameObjectHandle(go_ptr.get());
+            go_ptr->m_handle = handle;
+            go_ptr->m_components.reserve(extra_components + 1);
+            auto &transform_component = go_ptr->template AddComponent<TransformComponent>();
+            go_ptr->m_transformComponent = transform_component.m_handle;
+            m_go_add_queue.push_back(std::move(go_ptr));
+            handles.push_back(handle);
+        }
+        return handles;
+    }
+
     Component &Scene::CreateComponent(GameObject &parent, const Reflection::Type &type) {
         auto comp_var = type.CreateInstance(parent);
         comp_var.SetNeedFree(false);
@@ -50,10 +96,9 @@ namespace Engine {
         auto comp_ptr = std::unique_ptr<Component>(static_cast<Component *>(ptr));
         comp_ptr->m_scene = this;
         comp_ptr->m_parentGameObject = objectHandle;
-        auto handle = NextAvailableComponentHandle();
+        auto handle = AllocateComponentHandle(comp_ptr.get());
         auto &ret = *comp_ptr;
         comp_ptr->m_handle = handle;
-        m_comp_map[handle] = comp_ptr.get();
         if (auto obj = this->GetGameObject(objectHandle)) {
             obj->m_components.push_back(handle);
         }
@@ -70,8 +115,12 @@ namespace Engine {
     }
 
     void Scene::FlushCmdQueue() {
+        if (!m_go_add_queue.empty() || !m_go_remove_queue.empty()) {
+            m_transform_hierarchy_dirty = true;
+        }
         for (auto &go_ptr : m_go_add_queue) {
-            m_game_objects.push_back(std::move(go_ptr));
+            auto handle = go_ptr->GetHandle();
+            m_game_objects.Commit(handle.GetID(), std::move(go_ptr));
         }
         m_go_add_queue.clear();
         for (auto handle : m_go_remove_queue) {
@@ -92,40 +141,46 @@ namespace Engine {
             for (auto child_handle : go_ptr->m_childGameObject) {
                 if (auto *child_go = this->GetGameObject(child_handle)) {
                     child_go->m_parentGameObject.Reset();
+                    if (auto *child_transform = child_go->GetTransformComponent()) {
+                        child_transform->MarkWorldTransformDirty();
+                    }
                 }
             }
 
             for (auto comp : go_ptr->m_components) {
                 this->RemoveComponent(comp);
             }
-            m_go_map.erase(handle);
-            m_game_objects.erase(
-                std::remove_if(
-                    m_game_objects.begin(),
-                    m_game_objects.end(),
-                    [&handle](const std::unique_ptr<GameObject> &obj) { return obj->GetHandle() == handle; }
-                ),
-                m_game_objects.end()
-            );
+            m_game_objects.Erase(handle.GetID());
         }
         m_go_remove_queue.clear();
 
         for (auto &comp_ptr : m_comp_add_queue) {
             comp_ptr->Awake();
-            m_event_queue->AddEvent(comp_ptr->GetHandle(), &Component::Init);
-            m_components.push_back(std::move(comp_ptr));
+            auto handle = comp_ptr->GetHandle();
+            uint32_t slot = SlotMap<Component>::GetIndex(handle.GetID());
+            auto callbacks = GetComponentCallbacks(*comp_ptr);
+            if (callbacks.init) {
+                m_event_queue->AddEvent(*comp_ptr, ComponentEvent::Init);
+            }
+            if (callbacks.tick) {
+                m_tick_scheduler->Add(slot, comp_ptr.get());
+            }
+            for (auto *pool : GetPoolMembership(*comp_ptr)) {
+                pool->Insert(slot, comp_ptr.get());
+            }
+            m_components.Commit(handle.GetID(), std::move(comp_ptr));
         }
         m_comp_add_queue.clear();
         for (auto handle : m_comp_remove_queue) {
-            m_comp_map.erase(handle);
-            m_components.erase(
-                std::remove_if(
-                    m_components.begin(),
-                    m_components.end(),
-                    [&handle](const std::unique_ptr<Component> &comp) { return comp->GetHandle() == handle; }
-                ),
-                m_components.end()
-            );
+            auto comp_ptr = m_components.Erase(handle.GetID());
+            if (comp_ptr == nullptr) {
+                continue;
+            }
+            uint32_t slot = SlotMap<Component>::GetIndex(handle.GetID());
+            m_tick_scheduler->Remove(slot);
+            for (auto *pool : GetPoolMembership(*comp_ptr)) {
+                pool->Remove(slot);
+            }
         }
         m_comp_remove_queue.clear();
     }
@@ -139,84 +194,232 @@ namespace Engine {
     }
 
     GameObject *Scene::GetGameObject(ObjectHandle handle) const {
-        auto it = m_go_map.find(handle);
-        if (it == m_go_map.end()) {
-            return nullptr;
-        }
-        return it->second;
+        return m_game_objects.Get(handle.GetID());
     }
 
     Component *Scene::GetComponent(ComponentHandle handle) const {
-        auto it = m_comp_map.find(handle);
-        if (it == m_comp_map.end()) {
-            return nullptr;
-        }
-        return it->second;
+        return m_components.Get(handle.GetID());
     }
 
     GameObject &Scene::GetGameObjectRef(ObjectHandle handle) const {
-        auto it = m_go_map.find(handle);
-        if (it == m_go_map.end()) {
+        auto ptr = m_game_objects.Get(handle.GetID());
+        if (ptr == nullptr) {
             throw std::runtime_error("GameObject not found.");
         }
-        return *it->second;
+        return *ptr;
     }
 
     Component &Scene::GetComponentRef(ComponentHandle handle) const {
-        auto it = m_comp_map.find(handle);
-        if (it == m_comp_map.end()) {
+        auto ptr = m_components.Get(handle.GetID());
+        if (ptr == nullptr) {
             throw std::runtime_error("Component not found.");
         }
-        return *it->second;
+        return *ptr;
     }
 
     const std::vector<std::unique_ptr<GameObject>> &Scene::GetGameObjects() const {
-        return m_game_objects;
+        return m_game_objects.GetDense();
     }
 
     const std::vector<std::unique_ptr<Component>> &Scene::GetComponents() const {
-        return m_components;
+        return m_components.GetDense();
     }
 
     void Scene::AddInitEvent() {
-        for (auto &comp : m_components) {
-            m_event_queue->AddEvent(comp->GetHandle(), &Component::Init);
+        for (auto &comp : m_components.GetDense()) {
+            if (GetComponentCallbacks(*comp).init) {
+                m_event_queue->AddEvent(*comp, ComponentEvent::Init);
+            }
         }
     }
 
     void Scene::AddTickEvent() {
-        for (auto &comp : m_components) {
-            m_event_queue->AddEvent(comp->GetHandle(), &Component::Tick);
-        }
+        m_event_queue->AddSceneTickEvent();
+    }
+
+    void Scene::TickComponents() {
+        // Commands are queued during ticks, so the registered Components are stable while ticking.
+        m_tick_scheduler->Tick();
+    }
+
+    void Scene::SetTickJobSystem(JobSystem *job_system) noexcept {
+        m_tick_scheduler->SetJobSystem(job_system);
+    }
+
+    JobSystem *Scene::GetTickJobSystem() const noexcept {
+        return m_tick_scheduler->GetJobSystem();
+    }
+
+    size_t Scene::GetTickableComponentCount() const noexcept {
+        return m_tick_scheduler->GetComponentCount();
     }
 
     void Scene::Clear() {
         ClearEventQueue();
-        m_game_objects.clear();
-        m_components.clear();
-        m_go_map.clear();
-        m_comp_map.clear();
+        m_game_objects.Clear();
+        m_components.Clear();
+        m_tick_scheduler->Clear();
+        for (auto &[type, pool] : m_component_pools) {
+            pool->Clear();
+        }
         m_go_add_queue.clear();
         m_go_remove_queue.clear();
         m_comp_add_queue.clear();
         m_comp_remove_queue.clear();
+        m_transform_hierarchy->Clear();
+        m_changed_transforms.clear();
+        m_transform_hierarchy_dirty = true;
+    }
+
+    void Scene::UpdateTransformHierarchy() {
+        auto &hierarchy = *m_transform_hierarchy;
+        if (m_transform_hierarchy_dirty) {
+            // Nodes of GameObjects that kept their parent and local transform keep their world matrices,
+            // so adding, removing or reparenting objects only recomputes the affected subtrees.
+            hierarchy.BeginRebuild();
+            hierarchy.Reserve(m_game_objects.Size());
+
+            // Breadth-first traversal from the roots, so that parents precede their children.
+            std::vector<std::pair<GameObject *, uint32_t>> queue{};
+            queue.reserve(m_game_objects.Size());
+            for (auto &go : m_game_objects.GetDense()) {
+                if (!go->m_parentGameObject.IsValid() || !this->GetGameObject(go->m_parentGameObject)) {
+                    queue.emplace_back(go.get(), TransformHierarchy::NO_PARENT);
+                }
+            }
+            // Transforms of the new nodes, by node index.
+            std::vector<TransformComponent *> nodes{};
+            nodes.reserve(m_game_objects.Size());
+            for (size_t head = 0; head < queue.size(); head++) {
+                auto [go, parent_node] = queue[head];
+                auto *transform = go->GetTransformComponent();
+                if (transform == nullptr) continue;
+                transform->m_hierarchy_node =
+                    hierarchy.AddNode(parent_node, transform->GetTransform(), transform->m_hierarchy_node);
+                nodes.push_back(transform);
+                for (auto child_handle : go->m_childGameObject) {
+                    if (auto *child_go = this->GetGameObject(child_handle)) {
+                        queue.emplace_back(child_go, transform->m_hierarchy_node);
+                    }
+                }
+            }
+            // Nodes not reached in the traversal must not keep indices from the previous build.
+            for (auto &go : m_game_objects.GetDense()) {
+                auto *transform = go->GetTransformComponent();
+                if (transform && (transform->m_hierarchy_node >= nodes.size()
+                                  || nodes[transform->m_hierarchy_node] != transform)) {
+                    transform->m_hierarchy_node = TransformHierarchy::INVALID_NODE;
+                }
+            }
+            m_transform_hierarchy_dirty = false;
+        }
+
+        for (auto handle : m_changed_transforms) {
+            // Only TransformComponents are queued, so skip the dynamic_cast.
+            auto *transform = static_cast<TransformComponent *>(this->GetComponent(handle));
+            if (transform == nullptr) continue;
+            transform->m_local_change_queued = false;
+            if (transform->m_hierarchy_node < hierarchy.GetNodeCount()) {
+                hierarchy.SetLocalTransform(transform->m_hierarchy_node, transform->GetTransform());
+            }
+        }
+        m_changed_transforms.clear();
+
+        hierarchy.UpdateWorldMatrices();
+    }
+
+    const TransformHierarchy &Scene::GetTransformHierarchy() const noexcept {
+        return *m_transform_hierarchy;
+    }
+
+    void Scene::MarkTransformHierarchyDirty() noexcept {
+        m_transform_hierarchy_dirty = true;
+    }
+
+    void Scene::NotifyLocalTransformChanged(ComponentHandle handle) {
+        std::lock_guard lock(m_changed_transforms_mutex);
+        m_changed_transforms.push_back(handle);
     }
 
     bool Scene::IsRenderingEnabled() const noexcept {
         return m_enable_rendering;
     }
 
-    ComponentHandle Scene::NextAvailableComponentHandle() {
-        while (m_comp_map.find(ComponentHandle(m_sceneID, m_comp_id_gen)) != m_comp_map.end() || m_comp_id_gen == 0) {
-            m_comp_id_gen++;
+    ComponentPool &Scene::GetComponentPool(std::type_index type, ComponentPool::ProbeFunc probe) {
+        auto it = m_component_pools.find(type);
+        if (it != m_component_pools.end()) {
+            return *it->second;
         }
-        return ComponentHandle(m_sceneID, m_comp_id_gen++);
+
+        auto &pool = *(m_component_pools[type] = std::make_unique<ComponentPool>(type, probe));
+        // Cached memberships do not know about the new pool.
+        m_pool_membership.clear();
+        const auto &components = m_components.GetDense();
+        const auto &keys = m_components.GetDenseKeys();
+        for (size_t i = 0; i < components.size(); i++) {
+            const auto &membership = GetPoolMembership(*components[i]);
+            if (std::find(membership.begin(), membership.end(), &pool) != membership.end()) {
+                pool.Insert(SlotMap<Component>::GetIndex(keys[i]), components[i].get());
+            }
+        }
+        return pool;
+    }
+
+    const std::vector<ComponentPool *> &Scene::GetPoolMembership(Component &component) {
+        std::type_index dynamic_type(typeid(component));
+        auto it = m_pool_membership.find(dynamic_type);
+        if (it != m_pool_membership.end()) {
+            return it->second;
+        }
+
+        auto &membership = m_pool_membership[dynamic_type];
+        const auto &types = Reflection::Type::s_index_type_map;
+        auto dynamic_reflected = types.find(dynamic_type);
+        for (auto &[type, pool] : m_component_pools) {
+            bool match = false;
+            auto pool_reflected = types.find(type);
+            if (type == dynamic_type) {
+                match = true;
+            } else if (dynamic_reflected != types.end() && pool_reflected != types.end()
+                       && dynamic_reflected->second->IsReflectable() && pool_reflected->second->IsReflectable()) {
+                auto base_type = pool_reflected->second;
+                match = dynamic_reflected->second->IsDerivedFrom(base_type);
+            } else {
+                match = pool->Probe(&component);
+            }
+            if (match) membership.push_back(pool.get());
+        }
+        return membership;
     }
 
-    ObjectHandle Scene::NextAvailableGameObjectHandle() {
-        while (m_go_map.find(ObjectHandle(m_sceneID, m_go_id_gen)) != m_go_map.end() || m_go_id_gen == 0) {
-            m_go_id_gen++;
+    Scene::ComponentCallbacks Scene::GetComponentCallbacks(Component &component) {
+        std::type_index dynamic_type(typeid(component));
+        auto it = m_component_callbacks.find(dynamic_type);
+        if (it != m_component_callbacks.end()) {
+            return it->second;
+        }
+
+        auto &callbacks = m_component_callbacks[dynamic_type];
+        const auto &types = Reflection::Type::s_index_type_map;
+        auto dynamic_reflected = types.find(dynamic_type);
+        auto component_reflected = types.find(std::type_index(typeid(Component)));
+        // Overrides in types unknown to the reflection system cannot be ruled out.
+        if (dynamic_reflected != types.end() && component_reflected != types.end()
+            && dynamic_reflected->second->IsReflectable() && component_reflected->second->IsReflectable()) {
+            auto base_type = component_reflected->second;
+            if (dynamic_reflected->second->IsDerivedFrom(base_type)) {
+                callbacks.init = dynamic_reflected->second->OverridesMethod("Init");
+                callbacks.tick = dynamic_reflected->second->OverridesMethod("Tick");
+            }
         }
-        return ObjectHandle(m_sceneID, m_go_id_gen++);
+        return callbacks;
+    }
+
+    ComponentHandle Scene::AllocateComponentHandle(Component *ptr) {
+        return ComponentHandle(m_sceneID, m_components.Allocate(ptr));
+    }
+
+    ObjectHandle Scene::AllocateGameObjectHandle(GameObject *ptr) {
+        return ObjectHandle(m_sceneID, m_game_objects.Allocate(ptr));
     }
 } // namespace Engine
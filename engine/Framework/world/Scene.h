@@ -1,9 +1,14 @@
 #ifndef FRAMEWORK_WORLD_SCENE_INCLUDED
 #define FRAMEWORK_WORLD_SCENE_INCLUDED
 
+#include "ComponentPool.h"
 #include "Handle.h"
+#include <Core/PoolAllocator.h>
+#include <Core/SlotMap.h>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <typeindex>
 #include <unordered_map>
 #include <vector>
 
@@ -13,6 +18,9 @@ namespace Engine {
     class EventQueue;
     class Component;
     class SceneAsset;
+    class TransformHierarchy;
+    class TickScheduler;
+    class JobSystem;
     namespace Reflection {
         class Type;
     }
@@ -26,6 +34,15 @@ namespace Engine {
      * A Scene can be gotten by its ID from WorldSystem.
      * Creation and deletion operations about GameObjects and Components are queued and
      * processed via Scene::FlushCmdQueue() for safe lifetime management.
+     *
+     * GameObjects and Components are stored in generational slot maps. Handle IDs pack
+     * a slot index and a generation, so lookups and removals are O(1), and handles to
+     * removed objects are never resolved to objects created later in the same slot.
+     *
+     * Committed Components are also kept in per-type pools, which are created on the first
+     * query of a type by Scene::View() or Scene::ForEach(). A pool of type T contains
+     * Components of T and all types derived from T, so systems iterating over one type do not
+     * have to scan and cast every Component in the scene.
      */
     class Scene {
     protected:
@@ -59,10 +76,29 @@ namespace Engine {
         void AddInitEvent();
 
         /**
-         * @brief Add the tick events of all Components in the scene to the scene event queue.
+         * @brief Add the tick event of the scene to the scene event queue.
+         * When processed, all Components tick in the order given by their ComponentTickTraits.
          */
         void AddTickEvent();
 
+        /**
+         * @brief Set the job system ticking thread-safe Components.
+         * Parallel ticking is disabled with nullptr, which is the default.
+         * The job system must outlive the scene, or be reset before it is destroyed.
+         */
+        void SetTickJobSystem(JobSystem *job_system) noexcept;
+
+        /**
+         * @brief Get the count of committed Components that are ticked every frame.
+         * Components whose type does not override Component::Tick() are not ticked.
+         */
+        size_t GetTickableComponentCount() const noexcept;
+
+        /**
+         * @brief Get the job system ticking thread-safe Components.
+         */
+        JobSystem *GetTickJobSystem() const noexcept;
+
         /**
          * @brief Create a new GameObject in the scene.
          * The adding operation is queued and processed via Scene::FlushCmdQueue().
@@ -70,6 +106,28 @@ namespace Engine {
          */
         GameObject &CreateGameObject();
 
+        /**
+         * @brief Create GameObjects in bulk.
+         * Each GameObject gets a TransformComponent and one Component of each type in Ts, in that order.
+         * Handles, queue storage and pooled memory are reserved once for the whole batch, so the
+         * GameObjects and the Components of each type are mostly contiguous in memory.
+         * The adding operation is queued and processed via Scene::FlushCmdQueue().
+         * @param count The count of GameObjects to create.
+         * @tparam Ts Ts must be derived from Component
+         * @return The handles of the created GameObjects.
+         */
+        template <typename... Ts>
+        std::vector<ObjectHandle> CreateGameObjects(uint32_t count) {
+            static_assert((std::is_base_of<Component, Ts>::value && ...), "Ts must be derived from Component");
+            ((alignof(Ts) <= PoolAllocator::GRANULARITY ? PoolAllocator::Reserve(sizeof(Ts), count) : void()), ...);
+            auto handles = CreateGameObjectBatch(count, static_cast<uint32_t>(sizeof...(Ts)));
+            for (auto handle : handles) {
+                GameObject &parent = *m_game_objects.Get(handle.GetID());
+                (AddComponent(parent, new Ts(parent)), ...);
+            }
+            return handles;
+        }
+
         /**
          * @brief Create a new Component in the scene.
          * The adding operation is queued and processed via Scene::FlushCmdQueue().
@@ -171,16 +229,44 @@ namespace Engine {
 
         /**
          * @brief Get all GameObjects in the scene.
+         * The order is not preserved across removals.
          * @return A vector of pointers to the GameObjects.
          */
         const std::vector<std::unique_ptr<GameObject>> &GetGameObjects() const;
 
         /**
          * @brief Get all Components in the scene.
+         * The order is not preserved across removals.
          * @return A vector of pointers to the Components.
          */
         const std::vector<std::unique_ptr<Component>> &GetComponents() const;
 
+        /**
+         * @brief Get a view over all committed Components of type T, including derived types.
+         * Components waiting in the command queue are not included.
+         * The view is invalidated by Scene::FlushCmdQueue() and Scene::Clear().
+         * @tparam T T must be derived from Component
+         * @return The view yielding references to T.
+         */
+        template <typename T>
+        ComponentView<T> View() {
+            return ComponentView<T>(GetComponentPool<T>().GetComponents());
+        }
+
+        /**
+         * @brief Call a function on all committed Components of type T, including derived types.
+         * Components created or removed by the function are queued as usual,
+         * so they do not affect the iteration.
+         * @tparam T T must be derived from Component
+         * @param func A callable accepting T &.
+         */
+        template <typename T, typename F>
+        void ForEach(F &&func) {
+            for (auto *component : GetComponentPool<T>().GetComponents()) {
+                func(*static_cast<T *>(component));
+            }
+        }
+
         Scene(const Scene &) = delete;
         Scene &operator=(const Scene &) = delete;
         Scene(Scene &&) = delete;
@@ -191,6 +277,34 @@ namespace Engine {
          */
         void Clear();
 
+        /**
+         * @brief Bring the transform hierarchy of the scene up to date.
+         * The hierarchy is rebuilt if GameObjects were added, removed or reparented, in which case
+         * only the nodes whose parent changed are recomputed, along with the queued local transform changes.
+         * World matrices of changed nodes and their descendants are then recomputed in one pass.
+         */
+        void UpdateTransformHierarchy();
+
+        /**
+         * @brief Get the transform hierarchy of the scene.
+         * Node indices are stored in TransformComponent::GetHierarchyNode().
+         * @return The reference to the transform hierarchy.
+         */
+        const TransformHierarchy &GetTransformHierarchy() const noexcept;
+
+        /**
+         * @brief Mark the structure of the transform hierarchy as changed.
+         * The hierarchy will be rebuilt in the next Scene::UpdateTransformHierarchy().
+         */
+        void MarkTransformHierarchyDirty() noexcept;
+
+        /**
+         * @brief Queue a local transform change to be applied in the next Scene::UpdateTransformHierarchy().
+         * Thread-safe, although transforms must not be modified from thread-safe Ticks.
+         * @param handle The handle of the changed TransformComponent.
+         */
+        void NotifyLocalTransformChanged(ComponentHandle handle);
+
         /**
          * @brief Check if rendering is enabled for the scene.
          * @return True if rendering is enabled, False otherwise.
@@ -205,16 +319,30 @@ namespace Engine {
         std::vector<std::unique_ptr<Component>> m_comp_add_queue{};
         std::vector<ComponentHandle> m_comp_remove_queue{};
 
-        std::vector<std::unique_ptr<GameObject>> m_game_objects{};
-        std::vector<std::unique_ptr<Component>> m_components{};
+        // Slot maps resolve both queued and committed objects, but only own the committed ones.
+        // They are constructed in Scene.cpp where GameObject and Component are complete.
+        SlotMap<GameObject> m_game_objects;
+        SlotMap<Component> m_components;
 
-        std::unordered_map<ObjectHandle, GameObject *> m_go_map{};
-        std::unordered_map<ComponentHandle, Component *> m_comp_map{};
+        // Per-type pools of committed Components, keyed by the queried type.
+        std::unordered_map<std::type_index, std::unique_ptr<ComponentPool>> m_component_pools{};
+        // Pools that Components of a dynamic type belong to, cached on the first Component of the type.
+        std::unordered_map<std::type_index, std::vector<ComponentPool *>> m_pool_membership{};
+
+        // Which callbacks Components of a dynamic type override, cached on the first Component of the type.
+        struct ComponentCallbacks {
+            bool init{true};
+            bool tick{true};
+        };
+        std::unordered_map<std::type_index, ComponentCallbacks> m_component_callbacks{};
 
         std::unique_ptr<EventQueue> m_event_queue{};
+        std::unique_ptr<TickScheduler> m_tick_scheduler{};
 
-        uint32_t m_comp_id_gen{0};
-        uint32_t m_go_id_gen{0};
+        std::unique_ptr<TransformHierarchy> m_transform_hierarchy{};
+        std::vector<ComponentHandle> m_changed_transforms{};
+        std::mutex m_changed_transforms_mutex{};
+        bool m_transform_hierarchy_dirty{true};
 
         // Determine whether the components in the scene should be registered to the render system and processed in the rendering pipeline.
         // Currently only main scene in WorldSystem can enable rendering.
@@ -223,6 +351,13 @@ namespace Engine {
     protected:
         // GameObject need to access AddComponent function
         friend class GameObject;
+        // EventQueue runs the tick event of the scene
+        friend class EventQueue;
+
+        /**
+         * @brief Tick all committed Components with the tick scheduler of the scene.
+         */
+        void TickComponents();
 
         /**
          * @brief Add a Component to the GameObject.
@@ -233,16 +368,58 @@ namespace Engine {
         Component &AddComponent(GameObject &parent, Component *ptr);
 
         /**
-         * @brief Get the next available Component handle of this scene.
-         * @return The next available Component handle.
+         * @brief Create GameObjects with their TransformComponents, reserving storage for the whole batch.
+         * @param count The count of GameObjects.
+         * @param extra_components The count of Components to be added to each GameObject besides the TransformComponent.
+         * @return The handles of the created GameObjects.
+         */
+        std::vector<ObjectHandle> CreateGameObjectBatch(uint32_t count, uint32_t extra_components);
+
+        /**
+         * @brief Allocate a Component handle of this scene.
+         * @param ptr The Component to be associated with the handle.
+         * @return The allocated Component handle.
+         */
+        ComponentHandle AllocateComponentHandle(Component *ptr);
+
+        /**
+         * @brief Allocate a GameObject handle of this scene.
+         * @param ptr The GameObject to be associated with the handle.
+         * @return The allocated GameObject handle.
+         */
+        ObjectHandle AllocateGameObjectHandle(GameObject *ptr);
+
+        /**
+         * @brief Get the pool of type T, creating and filling it if it does not exist.
+         */
+        template <typename T>
+        ComponentPool &GetComponentPool() {
+            static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
+            return GetComponentPool(std::type_index(typeid(T)), [](Component *component) {
+                return dynamic_cast<T *>(component) != nullptr;
+            });
+        }
+
+        /**
+         * @brief Get the pool of a type, creating and filling it if it does not exist.
+         * @param type The pooled type.
+         * @param probe The fallback used to match Components whose type is not reflected.
+         */
+        ComponentPool &GetComponentPool(std::type_index type, ComponentPool::ProbeFunc probe);
+
+        /**
+         * @brief Get the pools that a Component belongs to.
+         * Pools are matched by the base type info of the reflection system,
+         * or by the probe of the pool if either type is not reflected.
          */
-        ComponentHandle NextAvailableComponentHandle();
+        const std::vector<ComponentPool *> &GetPoolMembership(Component &component);
 
         /**
-         * @brief Get the next available GameObject handle of this scene.
-         * @return The next available GameObject handle.
+         * @brief Get which of Init() and Tick() a Component overrides.
+         * Overrides are looked up in the reflection system. Components whose type, or one of whose
+         * base types, is not reflected are assumed to override both.
          */
-        ObjectHandle NextAvailableGameObjectHandle();
+        ComponentCallbacks GetComponentCallbacks(Component &component);
     };
 } // namespace Engine
 
@@ -0,0 +1,133 @@
+#include "TickScheduler.h"
+#include <Core/Jobs/JobSystem.h>
+#include <Framework/component/Component.h>
+
+#include <cassert>
+#include <limits>
+#include <utility>
+
+namespace Engine {
+    namespace {
+        // Components are claimed in chunks, so that one job amortizes the scheduling overhead.
+        constexpr size_t TICK_CHUNK_SIZE = 64;
+
+        thread_local bool t_in_parallel_tick{false};
+    } // namespace
+
+    TickScheduler::TickScheduler() : m_groups(std::numeric_limits<uint8_t>::max() + 1) {
+    }
+
+    void TickScheduler::SetJobSystem(JobSystem *job_system) noexcept {
+        m_job_system = job_system;
+    }
+
+    JobSystem *TickScheduler::GetJobSystem() const noexcept {
+        return m_job_system;
+    }
+
+    TickScheduler::TickList &TickScheduler::GetList(const Entry &entry) noexcept {
+        auto &group = m_groups[entry.group];
+        return entry.parallel ? group.parallel : group.serial;
+    }
+
+    void TickScheduler::Add(uint32_t slot, Component *component) {
+        if (slot >= m_entries.size()) {
+            m_entries.resize(slot + 1);
+        }
+        auto &entry = m_entries[slot];
+        assert(entry.position == INVALID_POSITION && "Slot is already registered.");
+
+        auto traits = component->GetTickTraits();
+        auto &group = m_groups[traits.group];
+        if (group.parallel.components.empty() && group.serial.components.empty()) {
+            m_active_groups_dirty = true;
+        }
+        entry.group = traits.group;
+        // Thread-safe Components are batched even without a job system, so that the order does not depend on
+        // the thread count.
+        entry.parallel = traits.thread_safe;
+        auto &list = GetList(entry);
+        entry.position = static_cast<uint32_t>(list.components.size());
+        list.components.push_back(component);
+        list.slots.push_back(slot);
+        m_component_count++;
+    }
+
+    void TickScheduler::Remove(uint32_t slot) {
+        if (slot >= m_entries.size() || m_entries[slot].position == INVALID_POSITION) return;
+        auto &entry = m_entries[slot];
+        auto &list = GetList(entry);
+        uint32_t last = static_cast<uint32_t>(list.components.size() - 1);
+        if (entry.position != last) {
+            list.components[entry.position] = list.components[last];
+            list.slots[entry.position] = list.slots[last];
+            m_entries[list.slots[entry.position]].position = entry.position;
+        }
+        list.components.pop_back();
+        list.slots.pop_back();
+        entry.position = INVALID_POSITION;
+        m_component_count--;
+
+        auto &group = m_groups[entry.group];
+        if (group.parallel.components.empty() && group.serial.components.empty()) {
+            m_active_groups_dirty = true;
+        }
+    }
+
+    void TickScheduler::Clear() {
+        for (auto group : m_active_groups) {
+            m_groups[group] = TickGroup{};
+        }
+        m_active_groups.clear();
+        m_active_groups_dirty = false;
+        m_entries.clear();
+        m_component_count = 0;
+    }
+
+    size_t TickScheduler::GetComponentCount() const noexcept {
+        return m_component_count;
+    }
+
+    void TickScheduler::Tick() {
+        if (m_active_groups_dirty) {
+            m_active_groups.clear();
+            for (size_t i = 0; i < m_groups.size(); i++) {
+                if (!m_groups[i].parallel.components.empty() || !m_groups[i].serial.components.empty()) {
+                    m_active_groups.push_back(static_cast<uint8_t>(i));
+                }
+            }
+            m_active_groups_dirty = false;
+        }
+
+        for (auto group_index : m_active_groups) {
+            auto &group = m_groups[group_index];
+            RunParallel(group.parallel.components);
+            for (auto *component : group.serial.components) {
+                component->Tick();
+            }
+        }
+    }
+
+    bool TickScheduler::IsInParallelTick() noexcept {
+        return t_in_parallel_tick;
+    }
+
+    void TickScheduler::RunParallel(const std::vector<Component *> &components) {
+        if (m_job_system == nullptr || components.size() <= TICK_CHUNK_SIZE) {
+            t_in_parallel_tick = true;
+            for (auto *component : components) {
+                component->Tick();
+            }
+            t_in_parallel_tick = false;
+            return;
+        }
+        m_job_system->ParallelFor(components.size(), TICK_CHUNK_SIZE, [&components](size_t begin, size_t end) {
+            // Restored afterwards, as the calling thread runs chunks while waiting for the others.
+            bool was_in_parallel_tick = std::exchange(t_in_parallel_tick, true);
+            for (size_t i = begin; i < end; i++) {
+                components[i]->Tick();
+            }
+            t_in_parallel_tick = was_in_parallel_tick;
+        });
+    }
+} // namespace Engine
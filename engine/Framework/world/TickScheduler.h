@@ -0,0 +1,115 @@
+#ifndef FRAMEWORK_WORLD_TICKSCHEDULER_INCLUDED
+#define FRAMEWORK_WORLD_TICKSCHEDULER_INCLUDED
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Engine {
+    class Component;
+    class JobSystem;
+
+    /**
+     * @brief Runs Component::Tick() of the tickable Components of a scene, grouped by their ComponentTickTraits.
+     *
+     * Components are registered by the scene when they are committed, and only Components whose
+     * type overrides Tick() are registered, so Components without a Tick() add no per-frame cost.
+     * The traits of a Component are read once on registration.
+     *
+     * Groups are processed in ascending order with a barrier between them. Within a group,
+     * thread-safe Components are first distributed across the threads of the job system,
+     * then the other Components tick on the calling thread in registration order. Removals
+     * swap the last Component of a list into the gap. Without a job system, everything ticks
+     * on the calling thread in the same order, so the result does not depend on the thread
+     * count as long as the thread-safety traits are honest.
+     */
+    class TickScheduler {
+    public:
+        TickScheduler();
+        ~TickScheduler() = default;
+
+        TickScheduler(const TickScheduler &) = delete;
+        TickScheduler &operator=(const TickScheduler &) = delete;
+
+        /**
+         * @brief Set the job system ticking thread-safe Components. nullptr disables parallel ticking.
+         */
+        void SetJobSystem(JobSystem *job_system) noexcept;
+
+        /**
+         * @brief Get the job system ticking thread-safe Components.
+         */
+        JobSystem *GetJobSystem() const noexcept;
+
+        /**
+         * @brief Register a Component to be ticked.
+         * @param slot The slot index of the Component handle.
+         * @param component The Component pointer.
+         */
+        void Add(uint32_t slot, Component *component);
+
+        /**
+         * @brief Unregister a Component. Does nothing if the slot is not registered.
+         * @param slot The slot index of the Component handle.
+         */
+        void Remove(uint32_t slot);
+
+        /**
+         * @brief Unregister all Components.
+         */
+        void Clear();
+
+        /**
+         * @brief Get the count of registered Components.
+         */
+        size_t GetComponentCount() const noexcept;
+
+        /**
+         * @brief Tick all registered Components. Blocks until every Component has ticked.
+         */
+        void Tick();
+
+        /**
+         * @brief Check whether the calling thread is ticking thread-safe Components.
+         * Also true when they tick on the calling thread, so misuse is caught regardless of the thread count.
+         */
+        static bool IsInParallelTick() noexcept;
+
+    protected:
+        struct TickList {
+            std::vector<Component *> components{};
+            // Slot indices of the Components, parallel to components.
+            std::vector<uint32_t> slots{};
+        };
+
+        struct TickGroup {
+            TickList parallel{};
+            TickList serial{};
+        };
+
+        // Where a registered slot is stored.
+        struct Entry {
+            uint32_t position{INVALID_POSITION};
+            uint8_t group{0};
+            bool parallel{false};
+        };
+
+        static constexpr uint32_t INVALID_POSITION = 0xFFFFFFFFu;
+
+        TickList &GetList(const Entry &entry) noexcept;
+        void RunParallel(const std::vector<Component *> &components);
+
+        // Indexed by group number.
+        std::vector<TickGroup> m_groups;
+        // Groups with registered Components in ascending order, rebuilt when a group becomes empty or non-empty.
+        std::vector<uint8_t> m_active_groups{};
+        bool m_active_groups_dirty{false};
+        // Indexed by slot.
+        std::vector<Entry> m_entries{};
+        size_t m_component_count{0};
+
+        JobSystem *m_job_system{nullptr};
+    };
+} // namespace Engine
+
+#endif // FRAMEWORK_WORLD_TICKSCHEDULER_INCLUDED
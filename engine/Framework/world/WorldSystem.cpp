@@ -1,6 +1,7 @@
 #include "WorldSystem.h"
 #include <Core/Delegate/Delegate.h>
 #include <Core/Functional/EventQueue.h>
+#include <Core/Math/TransformHierarchy.h>
 #include <Framework/component/RenderComponent/CameraComponent.h>
 #include <Framework/component/RenderComponent/LightComponent.h>
 #include <Framework/component/RenderComponent/RendererComponent.h>
@@ -30,23 +31,21 @@ namespace Engine {
     void WorldSystem::UpdateLightData(RenderSystemState::SceneDataManager &scene_data_manager) {
         std::vector<LightComponent *> casting_light;
         std::vector<LightComponent *> non_casting_light;
-        for (auto &comp : m_main_scene->GetComponents()) {
-            auto ptr = dynamic_cast<LightComponent *>(comp.get());
-            if (ptr) {
-                if (ptr->m_cast_shadow) {
-                    if (ptr->m_type == LightType::Directional) {
-                        casting_light.push_back(ptr);
-                    } else {
-                        SDL_LogWarn(
-                            SDL_LOG_CATEGORY_APPLICATION, "Shadow casting point light and spot light are not supported."
-                        );
-                    }
+        for (auto &light : m_main_scene->View<LightComponent>()) {
+            auto ptr = &light;
+            if (ptr->m_cast_shadow) {
+                if (ptr->m_type == LightType::Directional) {
+                    casting_light.push_back(ptr);
                 } else {
-                    if (ptr->m_type != LightType::Spot) {
-                        non_casting_light.push_back(ptr);
-                    } else {
-                        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Spot light is not supported.");
-                    }
+                    SDL_LogWarn(
+                        SDL_LOG_CATEGORY_APPLICATION, "Shadow casting point light and spot light are not supported."
+                    );
+                }
+            } else {
+                if (ptr->m_type != LightType::Spot) {
+                    non_casting_light.push_back(ptr);
+                } else {
+                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Spot light is not supported.");
                 }
             }
         }
@@ -83,12 +82,15 @@ namespace Engine {
 
     void WorldSystem::UpdateRendererData(RenderSystem &render_system) {
         auto &scene = GetMainSceneRef();
+        scene.UpdateTransformHierarchy();
+        const auto &hierarchy = scene.GetTransformHierarchy();
 
-        for (auto &comp : scene.GetComponents()) {
-            if (auto *renderer_comp = dynamic_cast<RendererComponent *>(comp.get())) {
-                renderer_comp->PreRenderUpdate();
-            }
-        }
+        RendererList handles{};
+        std::vector<glm::mat4> matrices{};
+        scene.ForEach<RendererComponent>([&](RendererComponent &renderer_comp) {
+            renderer_comp.CollectModelMatrixUpdates(hierarchy, handles, matrices);
+        });
+        render_system.GetRendererManager().UpdateModelMatrices(handles, matrices);
 
         UpdateLightData(render_system.GetSceneDataManager());
     }
@@ -8,6 +8,7 @@
 #include <Core/Functional/EventQueue.h>
 #include <Core/Functional/SDLWindow.h>
 #include <Core/Functional/Time.h>
+#include <Core/Jobs/JobSystem.h>
 #include <Framework/world/WorldSystem.h>
 #include <Render/FullRenderSystem.h>
 #include <UserInterface/GUISystem.h>
@@ -45,8 +46,14 @@ namespace Engine {
         std::dynamic_pointer_cast<FileSystemDatabase>(this->asset_database)->LoadBuiltinAssets(path);
     }
 
-    void MainClass::LoadProject(const std::filesystem::path &path) {
+    void MainClass::LoadProject(
+        const std::filesystem::path &path, const std::function<void(size_t, size_t)> &pipeline_progress
+    ) {
         std::dynamic_pointer_cast<FileSystemDatabase>(this->asset_database)->LoadProjectAssets(path / "assets");
+        // Pipelines are created lazily on first use, so the cache is in place before any project pipeline.
+        this->renderer->GetPipelineCache().Load(path / "cache" / "pipeline_cache.bin");
+        // Unlike the cache, the manifest does not depend on the device, and can be shared with the project.
+        this->renderer->GetPipelineManifest().Load(path / "pipeline_manifest.json");
 
         nlohmann::json project_config;
         std::ifstream file(path / "project.config");
@@ -60,6 +67,9 @@ namespace Engine {
         GUID default_level_guid(project_config["default_level"].get<std::string>());
         auto level_asset = dynamic_cast<LevelAsset *>(this->asset_manager->LoadAssetImmediately(default_level_guid));
         level_asset->LoadToWorld();
+
+        // Create pipelines recorded in previous runs before the first frame.
+        this->renderer->GetPipelineManifest().Preheat(*this->renderer, pipeline_progress);
     }
 
     void MainClass::Initialize(
@@ -72,10 +82,13 @@ namespace Engine {
         if (sdl_window_flags == 0)
             sdl_window_flags = SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY;
         if (opt->instantQuit) return;
+        this->job_system = std::make_shared<JobSystem>();
         this->window = std::make_shared<SDLWindow>(opt->title.c_str(), opt->resol_x, opt->resol_y, sdl_window_flags);
         this->time = std::make_shared<TimeSystem>();
         this->renderer = std::make_shared<RenderSystem>(this->window);
+        this->renderer->SetJobSystem(this->job_system.get());
         this->world = std::make_shared<WorldSystem>();
+        this->world->GetMainSceneRef().SetTickJobSystem(this->job_system.get());
         this->asset_database = std::make_shared<FileSystemDatabase>();
         this->asset_manager = std::make_shared<AssetManager>();
         this->gui = std::make_shared<GUISystem>();
@@ -145,12 +158,17 @@ namespace Engine {
         return shader_compiler;
     }
 
+    std::shared_ptr<JobSystem> MainClass::GetJobSystem() const {
+        return job_system;
+    }
+
     void MainClass::SetRenderGraph(std::unique_ptr<RenderGraph> &render_graph, uint32_t final_color_attachment_id) {
         this->render_graph = std::move(render_graph);
         this->m_final_color_attachment_id = final_color_attachment_id;
     }
 
     void MainClass::RunOneFrame() {
+        this->job_system->RunMainThreadJobs();
         // TODO: asynchronous execution
         this->asset_manager->LoadAssetsInQueue();
 
@@ -5,6 +5,7 @@
 
 #include <SDL3/SDL.h>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -22,6 +23,7 @@ namespace Engine {
 
     class ComplexRenderGraphBuilder;
     class RenderGraph;
+    class JobSystem;
 
     class MainClass {
     public:
@@ -46,7 +48,16 @@ namespace Engine {
         );
 
         void LoadBuiltinAssets(const std::filesystem::path &path);
-        void LoadProject(const std::filesystem::path &path);
+        /**
+         * @brief Load the assets and the default level of a project, and preheat
+         * the pipelines recorded in its pipeline manifest.
+         *
+         * @param pipeline_progress Called with the count of preheated pipelines
+         * and the count of all pipelines to preheat, e.g. to update a loading screen.
+         */
+        void LoadProject(
+            const std::filesystem::path &path, const std::function<void(size_t, size_t)> &pipeline_progress = {}
+        );
         void MainLoop();
         void LoopFinite(uint64_t max_frame_count = 0u, float max_time_seconds = 0.0f);
 
@@ -59,10 +70,13 @@ namespace Engine {
         std::shared_ptr<GUISystem> GetGUISystem() const;
         std::shared_ptr<Input> GetInputSystem() const;
         std::shared_ptr<ShaderCompiler> GetShaderCompiler() const;
+        std::shared_ptr<JobSystem> GetJobSystem() const;
 
         void SetRenderGraph(std::unique_ptr<RenderGraph> &render_graph, uint32_t final_color_attachment_id);
 
     protected:
+        // Declared first so that it is destroyed last, after every system that may schedule jobs.
+        std::shared_ptr<JobSystem> job_system{};
         // XXX: window must destroyed before renderer. Because the window has some AllocatedImage2D. So the permutation
         // of renderer and window can not be changed.
         std::shared_ptr<RenderSystem> renderer{};
@@ -1,4 +1,5 @@
 #include "Type.h"
+#include <algorithm>
 #include <cassert>
 #include <cstdarg>
 
@@ -46,6 +47,25 @@ namespace Engine {
             return false;
         }
 
+        bool Type::DeclaresVirtualMethod(const std::string &name) const {
+            return std::find(m_virtual_methods.begin(), m_virtual_methods.end(), name) != m_virtual_methods.end();
+        }
+
+        bool Type::InheritsVirtualMethod(const std::string &name) const {
+            for (const auto &bt : m_base_type) {
+                if (bt->DeclaresVirtualMethod(name) || bt->InheritsVirtualMethod(name)) return true;
+            }
+            return false;
+        }
+
+        bool Type::OverridesMethod(const std::string &name) const {
+            if (DeclaresVirtualMethod(name) && InheritsVirtualMethod(name)) return true;
+            for (const auto &bt : m_base_type) {
+                if (bt->OverridesMethod(name)) return true;
+            }
+            return false;
+        }
+
         Type::TypeKind Type::GetTypeKind() const {
             return m_kind;
         }
@@ -72,6 +92,10 @@ namespace Engine {
             m_base_type.push_back(base_type);
         }
 
+        void Type::AddVirtualMethod(const std::string &name) {
+            if (!DeclaresVirtualMethod(name)) m_virtual_methods.push_back(name);
+        }
+
         void Type::AddField(
             const std::shared_ptr<const Type> field_type, const std::string &name, const WrapperFieldFunc &field
         ) {
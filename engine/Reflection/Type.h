@@ -67,12 +67,17 @@ namespace Engine {
                 const std::string &name, bool is_constructor = false
             ) const;
 
+            // Check if one of the base types declares a virtual method
+            bool InheritsVirtualMethod(const std::string &name) const;
+
         protected:
             std::vector<std::shared_ptr<const Type>> m_base_type{};
             WrapperDeleter m_deleter = nullptr;
             std::unordered_map<std::string, std::shared_ptr<const Field>> m_fields{};
             std::unordered_map<std::string, std::shared_ptr<const ArrayField>> m_array_fields{};
             std::unordered_map<std::string, std::shared_ptr<const Method>> m_methods{};
+            // Names of virtual methods declared by the type, including non-reflected ones
+            std::vector<std::string> m_virtual_methods{};
 
             std::string m_name{};
             // The size of the type in bytes
@@ -113,6 +118,11 @@ namespace Engine {
             /// @param base_type
             void AddBaseType(std::shared_ptr<const Type> base_type);
 
+            /// @brief Record a virtual method declared by the type, whether it is reflected or not.
+            /// Called by the generated code for every virtual method found by the parser.
+            /// @param name the name of the method
+            void AddVirtualMethod(const std::string &name);
+
             /// @brief Add a field to the type.
             /// @param field_type the type of the field
             /// @param name
@@ -156,6 +166,19 @@ namespace Engine {
              * @return true if the type is derived from base_type, false otherwise
              */
             bool IsDerivedFrom(std::shared_ptr<const Type> &base_type) const;
+            /**
+             * @brief Check if the type declares a virtual method.
+             * @param name the name of the method
+             * @return true if the type itself declares the method, false otherwise
+             */
+            bool DeclaresVirtualMethod(const std::string &name) const;
+            /**
+             * @brief Check if the type or one of its base types overrides a virtual method of a base type.
+             * Only reflected base types are taken into account.
+             * @param name the name of the method
+             * @return true if the method is overridden below the type declaring it first, false otherwise
+             */
+            bool OverridesMethod(const std::string &name) const;
             /**
              * @brief Get the kind of the type.
              * @return TypeKind enum value representing the kind of the type
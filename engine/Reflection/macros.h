@@ -45,6 +45,15 @@ public:
     REFL_ENABLE class_name(Engine::Serialization::SerializationMarker marker);                                         \
     REFL_ENABLE class_name() = default;
 
+/// Declare the tick scheduling traits of a Component class. Place it after REFL_SER_BODY.
+/// Components tick in ascending group order. Thread-safe Components of a group may tick concurrently on worker threads
+/// when parallel ticking is enabled for the scene, see Engine::ComponentTickTraits.
+#define REFL_TICK_TRAITS(group, thread_safe)                                                                           \
+public:                                                                                                                \
+    REFL_DISABLE virtual Engine::ComponentTickTraits GetTickTraits() const noexcept override {                         \
+        return Engine::ComponentTickTraits{group, thread_safe};                                                        \
+    }
+
 namespace Engine {
     namespace Reflection {
         class Registrar;
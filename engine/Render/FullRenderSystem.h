@@ -12,6 +12,8 @@
 #include "Render/RenderSystem/DeviceInterface.h"
 #include "Render/RenderSystem/FrameManager.h"
 #include "Render/RenderSystem/ImmutableResourceCache.h"
+#include "Render/RenderSystem/PipelineCache.h"
+#include "Render/RenderSystem/PipelineManifest.h"
 #include "Render/RenderSystem/RendererManager.h"
 #include "Render/RenderSystem/ResizableRTTManager.h"
 #include "Render/RenderSystem/SceneDataManager.h"
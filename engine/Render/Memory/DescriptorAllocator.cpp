@@ -0,0 +1,132 @@
+#include "DescriptorAllocator.h"
+
+#include "Render/DebugUtils.h"
+#include "Render/RenderSystem.h"
+#include "Render/RenderSystem/FrameManager.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <format>
+
+namespace Engine {
+    struct DescriptorAllocator::impl {
+        RenderSystem &m_system;
+        vk::DescriptorSetLayout m_layout;
+        std::vector<vk::DescriptorSetLayoutBinding> m_bindings;
+        std::string m_name;
+
+        std::vector<vk::UniqueDescriptorPool> m_pools{};
+        // Set capacity of the last pool, and count of sets allocated from it.
+        uint32_t m_last_pool_capacity{0};
+        uint32_t m_last_pool_allocated{0};
+
+        // Freed sets with the frame they were freed in, oldest first.
+        std::deque<std::pair<vk::DescriptorSet, uint64_t>> m_freed{};
+
+        uint32_t m_capacity{0};
+        uint32_t m_allocated{0};
+
+        impl(
+            RenderSystem &system,
+            vk::DescriptorSetLayout layout,
+            std::span<const vk::DescriptorSetLayoutBinding> bindings,
+            const std::string &name
+        ) : m_system(system), m_layout(layout), m_bindings(bindings.begin(), bindings.end()), m_name(name) {
+        }
+
+        void CreatePool() {
+            uint32_t capacity = ComputePoolCapacity(static_cast<uint32_t>(m_pools.size()));
+            auto sizes = ComputePoolSizes(m_bindings, capacity);
+
+            vk::Device device = m_system.GetDevice();
+            vk::DescriptorPoolCreateInfo dpci{vk::DescriptorPoolCreateFlags{}, capacity, sizes};
+            m_pools.push_back(device.createDescriptorPoolUnique(dpci));
+            DEBUG_SET_NAME_TEMPLATE(
+                device, m_pools.back().get(), std::format("Descriptor Pool {} - {}", m_pools.size() - 1, m_name)
+            );
+
+            m_last_pool_capacity = capacity;
+            m_last_pool_allocated = 0;
+            m_capacity += capacity;
+        }
+    };
+
+    DescriptorAllocator::DescriptorAllocator(
+        RenderSystem &system,
+        vk::DescriptorSetLayout layout,
+        std::span<const vk::DescriptorSetLayoutBinding> bindings,
+        const std::string &name
+    ) : pimpl(std::make_unique<impl>(system, layout, bindings, name)) {
+        assert(layout);
+    }
+
+    DescriptorAllocator::~DescriptorAllocator() = default;
+
+    vk::DescriptorSet DescriptorAllocator::Allocate() {
+        auto &freed = pimpl->m_freed;
+        uint64_t frame = pimpl->m_system.GetFrameManager().GetTotalFrame();
+        if (!freed.empty() && IsRecyclable(freed.front().second, frame)) {
+            auto set = freed.front().first;
+            freed.pop_front();
+            return set;
+        }
+
+        if (pimpl->m_pools.empty() || pimpl->m_last_pool_allocated == pimpl->m_last_pool_capacity) {
+            pimpl->CreatePool();
+        }
+        vk::DescriptorSetAllocateInfo dsai{pimpl->m_pools.back().get(), 1, &pimpl->m_layout};
+        auto set = pimpl->m_system.GetDevice().allocateDescriptorSets(dsai)[0];
+        pimpl->m_last_pool_allocated++;
+        pimpl->m_allocated++;
+        return set;
+    }
+
+    void DescriptorAllocator::Free(vk::DescriptorSet set) noexcept {
+        if (!set) return;
+        pimpl->m_freed.emplace_back(set, pimpl->m_system.GetFrameManager().GetTotalFrame());
+    }
+
+    vk::DescriptorSetLayout DescriptorAllocator::GetLayout() const noexcept {
+        return pimpl->m_layout;
+    }
+
+    DescriptorAllocator::Statistics DescriptorAllocator::GetStatistics() const noexcept {
+        uint32_t freed = static_cast<uint32_t>(pimpl->m_freed.size());
+        return Statistics{
+            .pool_count = static_cast<uint32_t>(pimpl->m_pools.size()),
+            .capacity = pimpl->m_capacity,
+            .allocated = pimpl->m_allocated,
+            .live = pimpl->m_allocated - freed,
+            .freed = freed
+        };
+    }
+
+    std::vector<vk::DescriptorPoolSize> DescriptorAllocator::ComputePoolSizes(
+        std::span<const vk::DescriptorSetLayoutBinding> bindings, uint32_t set_count
+    ) {
+        std::vector<vk::DescriptorPoolSize> sizes;
+        for (const auto &binding : bindings) {
+            if (binding.descriptorCount == 0) continue;
+            auto itr = std::find_if(sizes.begin(), sizes.end(), [&binding](const vk::DescriptorPoolSize &size) {
+                return size.type == binding.descriptorType;
+            });
+            if (itr == sizes.end()) {
+                sizes.push_back(vk::DescriptorPoolSize{binding.descriptorType, 0});
+                itr = std::prev(sizes.end());
+            }
+            itr->descriptorCount += binding.descriptorCount * set_count;
+        }
+        return sizes;
+    }
+
+    uint32_t DescriptorAllocator::ComputePoolCapacity(uint32_t pool_count) noexcept {
+        // Each pool is twice as large as the previous one. The shift is clamped, as the cap is reached long before.
+        uint64_t capacity = uint64_t{INITIAL_SETS_PER_POOL} << std::min(pool_count, 32u);
+        return static_cast<uint32_t>(std::min<uint64_t>(capacity, MAX_SETS_PER_POOL));
+    }
+
+    bool DescriptorAllocator::IsRecyclable(uint64_t freed_frame, uint64_t frame) noexcept {
+        return freed_frame + RenderSystemState::FrameManager::FRAMES_IN_FLIGHT <= frame;
+    }
+} // namespace Engine
@@ -0,0 +1,99 @@
+#ifndef RENDER_MEMORY_DESCRIPTORALLOCATOR_INCLUDED
+#define RENDER_MEMORY_DESCRIPTORALLOCATOR_INCLUDED
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace Engine {
+    class RenderSystem;
+
+    /**
+     * @brief Allocator of descriptor sets of one descriptor set layout.
+     *
+     * Sets are allocated from a chain of descriptor pools sized for the layout,
+     * so that a pool is exhausted exactly when its set count is reached. A new
+     * pool twice as large as the last one, up to `MAX_SETS_PER_POOL`, is created
+     * when all pools are exhausted.
+     *
+     * Freed sets are not returned to their pools, but recycled by later
+     * allocations after `FRAMES_IN_FLIGHT` frames, as frames in flight may
+     * still read them. Recycled sets keep their old contents and must be
+     * written before use.
+     */
+    class DescriptorAllocator {
+    public:
+        struct Statistics {
+            uint32_t pool_count;
+            /// Count of sets all pools can hold.
+            uint32_t capacity;
+            /// Count of sets allocated from pools, i.e. live and freed sets.
+            uint32_t allocated;
+            /// Count of sets handed out and not freed.
+            uint32_t live;
+            /// Count of freed sets, including ones that frames in flight may still read.
+            uint32_t freed;
+        };
+
+        static constexpr uint32_t INITIAL_SETS_PER_POOL = 32;
+        static constexpr uint32_t MAX_SETS_PER_POOL = 1024;
+
+        /**
+         * @param layout The layout of all sets to allocate.
+         * @param bindings The bindings `layout` was created with, used to size the pools.
+         */
+        DescriptorAllocator(
+            RenderSystem &system,
+            vk::DescriptorSetLayout layout,
+            std::span<const vk::DescriptorSetLayoutBinding> bindings,
+            const std::string &name = ""
+        );
+        ~DescriptorAllocator();
+
+        DescriptorAllocator(const DescriptorAllocator &) = delete;
+        void operator=(const DescriptorAllocator &) = delete;
+
+        /**
+         * @brief Allocate a descriptor set, recycling a freed one if possible.
+         */
+        vk::DescriptorSet Allocate();
+
+        /**
+         * @brief Free a descriptor set allocated from this allocator.
+         * It is recycled after `FRAMES_IN_FLIGHT` frames.
+         */
+        void Free(vk::DescriptorSet set) noexcept;
+
+        vk::DescriptorSetLayout GetLayout() const noexcept;
+
+        Statistics GetStatistics() const noexcept;
+
+        /**
+         * @brief Compute the descriptor counts needed by a pool to hold `set_count` sets
+         * of a layout, one entry per descriptor type.
+         */
+        static std::vector<vk::DescriptorPoolSize> ComputePoolSizes(
+            std::span<const vk::DescriptorSetLayoutBinding> bindings, uint32_t set_count
+        );
+
+        /**
+         * @brief Compute the set count of the pool created after `pool_count` pools.
+         */
+        static uint32_t ComputePoolCapacity(uint32_t pool_count) noexcept;
+
+        /**
+         * @brief Check whether a set freed in frame `freed_frame` can be recycled in frame `frame`,
+         * i.e. whether all frames in flight that may read it have finished.
+         */
+        static bool IsRecyclable(uint64_t freed_frame, uint64_t frame) noexcept;
+
+    private:
+        struct impl;
+        std::unique_ptr<impl> pimpl;
+    };
+} // namespace Engine
+
+#endif // RENDER_MEMORY_DESCRIPTORALLOCATOR_INCLUDED
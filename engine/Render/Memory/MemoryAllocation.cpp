@@ -7,20 +7,22 @@ namespace Engine {
     struct ImageAllocation::impl {
         vk::Image image;
         ImageMemoryType type;
+        bool owns_memory;
     };
 
     void ImageAllocation::Destory() noexcept {
         if (pimpl) {
             if (pimpl->image) {
-                vmaDestroyImage(GetAllocator(), pimpl->image, GetAllocation());
+                // Only the image is destroyed if the memory is owned by a memory block.
+                vmaDestroyImage(GetAllocator(), pimpl->image, pimpl->owns_memory ? GetAllocation() : nullptr);
             }
             pimpl.reset();
         }
     }
 
     ImageAllocation::ImageAllocation(
-        vk::Image image, VmaAllocation allocation, VmaAllocator allocator, ImageMemoryType type
-    ) : VmaMemoryAllocation(allocation, allocator), pimpl(std::make_unique<impl>(image, type)) {
+        vk::Image image, VmaAllocation allocation, VmaAllocator allocator, ImageMemoryType type, bool owns_memory
+    ) : VmaMemoryAllocation(allocation, allocator), pimpl(std::make_unique<impl>(image, type, owns_memory)) {
     }
     ImageAllocation::~ImageAllocation() {
         Destory();
@@ -128,4 +130,36 @@ namespace Engine {
 
         return pimpl->type;
     }
+
+    struct MemoryBlockAllocation::impl {
+        size_t size;
+    };
+    void MemoryBlockAllocation::Destroy() noexcept {
+        if (pimpl) {
+            vmaFreeMemory(GetAllocator(), GetAllocation());
+            pimpl.reset();
+        }
+    }
+    MemoryBlockAllocation::MemoryBlockAllocation(VmaAllocation allocation, VmaAllocator allocator, size_t size) :
+        VmaMemoryAllocation(allocation, allocator), pimpl(std::make_unique<impl>(size)) {
+    }
+    MemoryBlockAllocation::~MemoryBlockAllocation() {
+        Destroy();
+    }
+    MemoryBlockAllocation::MemoryBlockAllocation(MemoryBlockAllocation &&other) noexcept :
+        VmaMemoryAllocation(std::move(other)), pimpl(nullptr) {
+        std::swap(pimpl, other.pimpl);
+    }
+    MemoryBlockAllocation &MemoryBlockAllocation::operator=(MemoryBlockAllocation &&other) noexcept {
+        if (&other != this) {
+            this->Destroy();
+            this->VmaMemoryAllocation::operator=(std::move(other));
+            std::swap(this->pimpl, other.pimpl);
+        }
+        return *this;
+    }
+    size_t MemoryBlockAllocation::GetSize() const noexcept {
+        assert(pimpl);
+        return pimpl->size;
+    }
 } // namespace Engine
@@ -80,8 +80,19 @@ namespace Engine {
         void Destory() noexcept;
 
     public:
-        /// @brief Create an image allocation, called from `Engine::RenderSystemState::AllocatorState`.
-        ImageAllocation(vk::Image image, VmaAllocation allocation, VmaAllocator allocator, ImageMemoryType type);
+        /**
+         * @brief Create an image allocation, called from `Engine::RenderSystemState::AllocatorState`.
+         *
+         * @param owns_memory Whether the memory is freed with the image. Images aliasing
+         * a `MemoryBlockAllocation` do not own their memory.
+         */
+        ImageAllocation(
+            vk::Image image,
+            VmaAllocation allocation,
+            VmaAllocator allocator,
+            ImageMemoryType type,
+            bool owns_memory = true
+        );
 
         ~ImageAllocation();
 
@@ -184,6 +195,57 @@ namespace Engine {
         /// @brief Query the memory type specified on creation.
         BufferType GetMemoryType() const noexcept;
     };
+
+    /**
+     * @brief A block of device memory allocated without any resource.
+     *
+     * Multiple images can be created over the same block at different or even
+     * overlapping offsets, as long as they are not used at the same time. This
+     * is used to alias memory of transient render targets.
+     *
+     * Use `Engine::RenderSystemState::AllocatorState` to perform memory
+     * allocation. The block must outlive the images created over it.
+     *
+     * @invariant This class, once created, is guaranteed to hold a vaild memory
+     * allocation until moved or destructed.
+     */
+    class MemoryBlockAllocation : private VmaMemoryAllocation {
+        struct impl;
+        std::unique_ptr<impl> pimpl;
+
+        /// @brief Free the memory, and reset the pointer.
+        void Destroy() noexcept;
+
+    public:
+        /// @brief Create a memory block allocation, called from `Engine::RenderSystemState::AllocatorState`.
+        MemoryBlockAllocation(VmaAllocation allocation, VmaAllocator allocator, size_t size);
+        ~MemoryBlockAllocation();
+
+        MemoryBlockAllocation(const MemoryBlockAllocation &) = delete;
+        MemoryBlockAllocation &operator=(const MemoryBlockAllocation &) = delete;
+
+        /**
+         * @brief Construct an allocation from another allocation.
+         *
+         * The other allocation will be invaild after moving. Calling any method
+         * invokes undefined behavior.
+         */
+        MemoryBlockAllocation(MemoryBlockAllocation &&other) noexcept;
+
+        /**
+         * @brief Acquire an allocation from another allocation.
+         *
+         * The other allocation will be invaild after moving. Calling any method
+         * invokes undefined behavior.
+         */
+        MemoryBlockAllocation &operator=(MemoryBlockAllocation &&other) noexcept;
+
+        using VmaMemoryAllocation::GetAllocation;
+        using VmaMemoryAllocation::GetAllocator;
+
+        /// @brief Get the size of the block in bytes.
+        size_t GetSize() const noexcept;
+    };
 } // namespace Engine
 
 #endif // RENDER_MEMORY_MEMORYALLOCATION_INCLUDED
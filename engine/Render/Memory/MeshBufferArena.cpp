@@ -0,0 +1,321 @@
+#include "MeshBufferArena.h"
+
+#include "Core/RangeAllocator.h"
+#include "Core/SlotMap.h"
+#include "Render/Memory/DeviceBuffer.h"
+#include "Render/RenderSystem.h"
+#include "Render/RenderSystem/FrameManager.h"
+#include "Render/RenderSystem/SubmissionHelper.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+    struct MeshBufferArena::impl {
+        struct VertexPool {
+            VertexAttribute attributes;
+            uint32_t capacity;
+            // Offset in bytes and stride of every attribute stream.
+            std::vector<uint64_t> stream_offsets;
+            std::vector<uint64_t> strides;
+            RangeAllocator allocator;
+            std::unique_ptr<DeviceBuffer> buffer;
+        };
+
+        struct IndexPool {
+            uint32_t capacity;
+            RangeAllocator allocator;
+            std::unique_ptr<DeviceBuffer> buffer;
+        };
+
+        RenderSystem &m_system;
+        std::vector<VertexPool> m_vertex_pools{};
+        std::vector<IndexPool> m_index_pools{};
+        SlotMap<Range> m_ranges{};
+
+        // Ranges and buffers that may still be read by frames in flight, with their countdown.
+        std::vector<std::pair<Range, int32_t>> m_pending_frees{};
+        std::vector<std::pair<std::unique_ptr<DeviceBuffer>, int32_t>> m_retired_buffers{};
+
+        // Bumped whenever live allocations move.
+        uint32_t m_generation{0};
+
+        impl(RenderSystem &system) : m_system(system) {
+        }
+
+        std::unique_ptr<DeviceBuffer> CreateVertexBuffer(const VertexPool &pool) const {
+            return DeviceBuffer::CreateUnique(
+                m_system.GetAllocatorState(),
+                {BufferTypeBits::Vertex, BufferTypeBits::CopyTo, BufferTypeBits::CopyFrom},
+                size_t{pool.capacity} * pool.attributes.GetTotalPerVertexSize(),
+                "Mesh Vertex Pool"
+            );
+        }
+
+        std::unique_ptr<DeviceBuffer> CreateIndexBuffer(const IndexPool &pool) const {
+            return DeviceBuffer::CreateUnique(
+                m_system.GetAllocatorState(),
+                {BufferTypeBits::Index, BufferTypeBits::CopyTo, BufferTypeBits::CopyFrom},
+                size_t{pool.capacity} * sizeof(uint32_t),
+                "Mesh Index Pool"
+            );
+        }
+
+        std::pair<uint32_t, uint32_t> AllocateVertices(VertexAttribute attributes, uint32_t count) {
+            for (uint32_t i = 0; i < m_vertex_pools.size(); i++) {
+                auto &pool = m_vertex_pools[i];
+                if (!(pool.attributes == attributes)) continue;
+                if (count == 0) return {i, 0};
+                uint64_t offset = pool.allocator.Allocate(count);
+                if (offset != RangeAllocator::INVALID_OFFSET) return {i, static_cast<uint32_t>(offset)};
+            }
+
+            uint32_t capacity = std::max(VERTICES_PER_POOL, count);
+            VertexPool pool{attributes, capacity, {}, {}, RangeAllocator{capacity}, nullptr};
+            auto factors = attributes.EnumerateOffsetFactor();
+            for (size_t k = 0; k < factors.size(); k++) {
+                uint64_t next = k + 1 < factors.size() ? factors[k + 1] : attributes.GetTotalPerVertexSize();
+                pool.stream_offsets.push_back(factors[k] * capacity);
+                pool.strides.push_back(next - factors[k]);
+            }
+            pool.buffer = CreateVertexBuffer(pool);
+            uint64_t offset = count ? pool.allocator.Allocate(count) : 0;
+            assert(offset == 0);
+            m_vertex_pools.push_back(std::move(pool));
+            return {static_cast<uint32_t>(m_vertex_pools.size() - 1), static_cast<uint32_t>(offset)};
+        }
+
+        std::pair<uint32_t, uint32_t> AllocateIndices(uint32_t count) {
+            for (uint32_t i = 0; i < m_index_pools.size(); i++) {
+                if (count == 0) return {i, 0};
+                uint64_t offset = m_index_pools[i].allocator.Allocate(count);
+                if (offset != RangeAllocator::INVALID_OFFSET) return {i, static_cast<uint32_t>(offset)};
+            }
+
+            uint32_t capacity = std::max(INDICES_PER_POOL, count);
+            IndexPool pool{capacity, RangeAllocator{capacity}, nullptr};
+            pool.buffer = CreateIndexBuffer(pool);
+            uint64_t offset = count ? pool.allocator.Allocate(count) : 0;
+            assert(offset == 0);
+            m_index_pools.push_back(std::move(pool));
+            return {static_cast<uint32_t>(m_index_pools.size() - 1), static_cast<uint32_t>(offset)};
+        }
+
+        void ReleaseRange(const Range &range) {
+            if (range.vertex_count) {
+                m_vertex_pools[range.vertex_pool].allocator.Free(range.base_vertex, range.vertex_count);
+            }
+            if (range.index_count) {
+                m_index_pools[range.index_pool].allocator.Free(range.first_index, range.index_count);
+            }
+        }
+
+        void RetireBuffer(std::unique_ptr<DeviceBuffer> buffer) {
+            m_retired_buffers.emplace_back(std::move(buffer), RenderSystemState::FrameManager::FRAMES_IN_FLIGHT);
+        }
+
+        // Live ranges matching a predicate.
+        template <typename Pred>
+        std::vector<Range *> CollectRanges(Pred in_pool) {
+            std::vector<Range *> ranges;
+            for (const auto &range : m_ranges.GetDense()) {
+                if (in_pool(*range)) ranges.push_back(range.get());
+            }
+            return ranges;
+        }
+
+        void DefragmentVertexPool(uint32_t index, RenderSystemState::SubmissionHelper &helper) {
+            auto &pool = m_vertex_pools[index];
+            // Pending ranges are not copied, as only frames in flight read them from the old buffer.
+            for (auto &[range, countdown] : m_pending_frees) {
+                if (range.vertex_pool == index) range.vertex_count = 0;
+            }
+
+            auto ranges = CollectRanges([index](const Range &r) { return r.vertex_pool == index && r.vertex_count; });
+            std::vector<RangeAllocator::Relocation> relocations;
+            relocations.reserve(ranges.size());
+            for (const auto *range : ranges) relocations.push_back({range->base_vertex, range->vertex_count, 0});
+            pool.allocator.Compact(relocations);
+
+            auto new_buffer = CreateVertexBuffer(pool);
+            std::vector<RenderSystemState::SubmissionHelper::BufferCopyRegion> regions;
+            regions.reserve(ranges.size() * pool.strides.size());
+            for (size_t i = 0; i < ranges.size(); i++) {
+                const auto &relocation = relocations[i];
+                for (size_t k = 0; k < pool.strides.size(); k++) {
+                    regions.push_back(
+                        {pool.stream_offsets[k] + relocation.offset * pool.strides[k],
+                         pool.stream_offsets[k] + relocation.new_offset * pool.strides[k],
+                         relocation.size * pool.strides[k]}
+                    );
+                }
+                ranges[i]->base_vertex = static_cast<uint32_t>(relocation.new_offset);
+            }
+            helper.EnqueueBufferCopy(*pool.buffer, *new_buffer, regions);
+            RetireBuffer(std::exchange(pool.buffer, std::move(new_buffer)));
+            m_generation++;
+        }
+
+        void DefragmentIndexPool(uint32_t index, RenderSystemState::SubmissionHelper &helper) {
+            auto &pool = m_index_pools[index];
+            for (auto &[range, countdown] : m_pending_frees) {
+                if (range.index_pool == index) range.index_count = 0;
+            }
+
+            auto ranges = CollectRanges([index](const Range &r) { return r.index_pool == index && r.index_count; });
+            std::vector<RangeAllocator::Relocation> relocations;
+            relocations.reserve(ranges.size());
+            for (const auto *range : ranges) relocations.push_back({range->first_index, range->index_count, 0});
+            pool.allocator.Compact(relocations);
+
+            auto new_buffer = CreateIndexBuffer(pool);
+            std::vector<RenderSystemState::SubmissionHelper::BufferCopyRegion> regions;
+            regions.reserve(ranges.size());
+            for (size_t i = 0; i < ranges.size(); i++) {
+                const auto &relocation = relocations[i];
+                regions.push_back(
+                    {relocation.offset * sizeof(uint32_t),
+                     relocation.new_offset * sizeof(uint32_t),
+                     relocation.size * sizeof(uint32_t)}
+                );
+                ranges[i]->first_index = static_cast<uint32_t>(relocation.new_offset);
+            }
+            helper.EnqueueBufferCopy(*pool.buffer, *new_buffer, regions);
+            RetireBuffer(std::exchange(pool.buffer, std::move(new_buffer)));
+            m_generation++;
+        }
+    };
+
+    MeshBufferArena::MeshBufferArena(RenderSystem &system) : pimpl(std::make_unique<impl>(system)) {
+    }
+
+    MeshBufferArena::~MeshBufferArena() = default;
+
+    MeshBufferArena::Allocation MeshBufferArena::Allocate(
+        VertexAttribute attributes, uint32_t vertex_count, uint32_t index_count
+    ) {
+        auto [vertex_pool, base_vertex] = pimpl->AllocateVertices(attributes, vertex_count);
+        auto [index_pool, first_index] = pimpl->AllocateIndices(index_count);
+
+        auto range =
+            std::make_unique<Range>(vertex_pool, base_vertex, vertex_count, index_pool, first_index, index_count);
+        auto key = pimpl->m_ranges.Allocate(range.get());
+        pimpl->m_ranges.Commit(key, std::move(range));
+        return key;
+    }
+
+    void MeshBufferArena::Free(Allocation allocation) noexcept {
+        auto range = pimpl->m_ranges.Erase(allocation);
+        if (!range) return;
+        pimpl->m_pending_frees.emplace_back(*range, RenderSystemState::FrameManager::FRAMES_IN_FLIGHT);
+    }
+
+    void MeshBufferArena::EnqueueUpload(
+        Allocation allocation,
+        RenderSystemState::SubmissionHelper &helper,
+        std::span<const std::byte> vertices,
+        std::span<const std::byte> indices
+    ) {
+        const auto &range = GetRange(allocation);
+        if (range.vertex_count) {
+            const auto &pool = pimpl->m_vertex_pools[range.vertex_pool];
+            assert(vertices.size_bytes() == size_t{range.vertex_count} * pool.attributes.GetTotalPerVertexSize());
+            // Streams of the mesh are contiguous in the source, and land at the base vertex of each pool stream.
+            size_t source_offset = 0;
+            for (size_t k = 0; k < pool.strides.size(); k++) {
+                size_t size = range.vertex_count * pool.strides[k];
+                helper.EnqueueBufferSubmission(
+                    *pool.buffer,
+                    vertices.subspan(source_offset, size),
+                    pool.stream_offsets[k] + range.base_vertex * pool.strides[k]
+                );
+                source_offset += size;
+            }
+        }
+        if (range.index_count) {
+            assert(indices.size_bytes() == size_t{range.index_count} * sizeof(uint32_t));
+            helper.EnqueueBufferSubmission(
+                *pimpl->m_index_pools[range.index_pool].buffer, indices, range.first_index * sizeof(uint32_t)
+            );
+        }
+    }
+
+    const MeshBufferArena::Range &MeshBufferArena::GetRange(Allocation allocation) const noexcept {
+        const auto *range = pimpl->m_ranges.Get(allocation);
+        assert(range && "Invalid mesh buffer allocation.");
+        return *range;
+    }
+
+    void MeshBufferArena::FillVertexBufferBindings(
+        Allocation allocation, IVertexBasedRenderer::VertexBufferBindings &bindings
+    ) const {
+        const auto &pool = pimpl->m_vertex_pools[GetRange(allocation).vertex_pool];
+        for (size_t k = 0; k < pool.stream_offsets.size(); k++) {
+            bindings.push_back({pool.buffer.get(), pool.stream_offsets[k], pool.capacity * pool.strides[k]});
+        }
+    }
+
+    IVertexBasedRenderer::BufferBindingInfo MeshBufferArena::GetIndexBufferBinding(
+        Allocation allocation
+    ) const noexcept {
+        const auto &pool = pimpl->m_index_pools[GetRange(allocation).index_pool];
+        return {pool.buffer.get(), 0, pool.capacity * sizeof(uint32_t)};
+    }
+
+    void MeshBufferArena::TickFrame() {
+        auto &pending = pimpl->m_pending_frees;
+        for (size_t i = 0; i < pending.size();) {
+            if (--pending[i].second > 0) {
+                i++;
+                continue;
+            }
+            pimpl->ReleaseRange(pending[i].first);
+            pending[i] = pending.back();
+            pending.pop_back();
+        }
+
+        std::erase_if(pimpl->m_retired_buffers, [](auto &retired) { return --retired.second <= 0; });
+    }
+
+    bool MeshBufferArena::IsFragmented() const noexcept {
+        auto fragmented = [](const auto &pool) {
+            return pool.allocator.GetFreeRangeCount() > MAX_FREE_RANGES_PER_POOL;
+        };
+        return std::any_of(pimpl->m_vertex_pools.begin(), pimpl->m_vertex_pools.end(), fragmented)
+               || std::any_of(pimpl->m_index_pools.begin(), pimpl->m_index_pools.end(), fragmented);
+    }
+
+    void MeshBufferArena::Defragment(RenderSystemState::SubmissionHelper &helper) {
+        for (uint32_t i = 0; i < pimpl->m_vertex_pools.size(); i++) {
+            if (pimpl->m_vertex_pools[i].allocator.GetFreeRangeCount() > 1) pimpl->DefragmentVertexPool(i, helper);
+        }
+        for (uint32_t i = 0; i < pimpl->m_index_pools.size(); i++) {
+            if (pimpl->m_index_pools[i].allocator.GetFreeRangeCount() > 1) pimpl->DefragmentIndexPool(i, helper);
+        }
+    }
+
+    uint32_t MeshBufferArena::GetGeneration() const noexcept {
+        return pimpl->m_generation;
+    }
+
+    MeshBufferArena::Statistics MeshBufferArena::GetStatistics() const noexcept {
+        Statistics stats{};
+        stats.vertex_pool_count = static_cast<uint32_t>(pimpl->m_vertex_pools.size());
+        stats.index_pool_count = static_cast<uint32_t>(pimpl->m_index_pools.size());
+        stats.allocation_count = static_cast<uint32_t>(pimpl->m_ranges.Size());
+        for (const auto &pool : pimpl->m_vertex_pools) {
+            uint64_t vertex_size = pool.attributes.GetTotalPerVertexSize();
+            stats.reserved_bytes += pool.capacity * vertex_size;
+            stats.used_bytes += pool.allocator.GetUsedSize() * vertex_size;
+            stats.free_range_count += pool.allocator.GetFreeRangeCount();
+        }
+        for (const auto &pool : pimpl->m_index_pools) {
+            stats.reserved_bytes += pool.capacity * sizeof(uint32_t);
+            stats.used_bytes += pool.allocator.GetUsedSize() * sizeof(uint32_t);
+            stats.free_range_count += pool.allocator.GetFreeRangeCount();
+        }
+        return stats;
+    }
+} // namespace Engine
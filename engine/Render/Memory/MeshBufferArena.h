@@ -0,0 +1,152 @@
+#ifndef RENDER_MEMORY_MESHBUFFERARENA_INCLUDED
+#define RENDER_MEMORY_MESHBUFFERARENA_INCLUDED
+
+#include "Render/Renderer/IVertexBasedRenderer.h"
+#include "Render/Renderer/VertexAttribute.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace Engine {
+    class RenderSystem;
+    class DeviceBuffer;
+
+    namespace RenderSystemState {
+        class SubmissionHelper;
+    }
+
+    /**
+     * @brief Suballocator of vertex and index data of static meshes from a few large device buffers.
+     *
+     * Vertices are allocated from vertex pools, each serving one vertex attribute format.
+     * A pool of capacity C is laid out as one mesh of C vertices would be, i.e. every
+     * attribute has its own contiguous stream. A mesh placed at base vertex b is therefore
+     * drawn with the bindings of its pool and a vertex offset of b. Indices are allocated
+     * from index pools shared by all formats, and are drawn with a first index. Meshes
+     * placed in the same pools share all bindings, so that their draws can be batched.
+     *
+     * Ranges are allocated with a best-fit `RangeAllocator`, and new pools are created
+     * when the existing ones are full. Freed ranges are recycled after `FRAMES_IN_FLIGHT`
+     * frames, as frames in flight may still read them.
+     */
+    class MeshBufferArena {
+    public:
+        /// @brief Key of an allocation. Zero is the null key.
+        using Allocation = uint32_t;
+
+        /// @brief Vertices and indices occupied by an allocation, in elements.
+        struct Range {
+            uint32_t vertex_pool;
+            uint32_t base_vertex;
+            uint32_t vertex_count;
+            uint32_t index_pool;
+            uint32_t first_index;
+            uint32_t index_count;
+        };
+
+        struct Statistics {
+            uint32_t vertex_pool_count;
+            uint32_t index_pool_count;
+            uint32_t allocation_count;
+            /// Total size of the pool buffers in bytes.
+            uint64_t reserved_bytes;
+            /// Size of the allocated ranges in bytes, including ones pending to be freed.
+            uint64_t used_bytes;
+            /// Count of free ranges in all pools. Many free ranges indicate fragmentation.
+            uint64_t free_range_count;
+        };
+
+        /// Vertex capacity of a vertex pool. Larger meshes get a pool of their own.
+        static constexpr uint32_t VERTICES_PER_POOL = 1u << 18;
+        /// Index capacity of an index pool. Larger meshes get a pool of their own.
+        static constexpr uint32_t INDICES_PER_POOL = 1u << 20;
+        /// A pool with more free ranges than this is fragmented, see `IsFragmented()`.
+        static constexpr size_t MAX_FREE_RANGES_PER_POOL = 64;
+
+        MeshBufferArena(RenderSystem &system);
+        ~MeshBufferArena();
+
+        MeshBufferArena(const MeshBufferArena &) = delete;
+        void operator=(const MeshBufferArena &) = delete;
+
+        /**
+         * @brief Allocate vertices and indices of a mesh, creating pools as needed.
+         * @return The key of the allocation, which is never null.
+         */
+        Allocation Allocate(VertexAttribute attributes, uint32_t vertex_count, uint32_t index_count);
+
+        /**
+         * @brief Free an allocation. Its ranges are recycled after `FRAMES_IN_FLIGHT` frames,
+         * but its key becomes invalid immediately.
+         */
+        void Free(Allocation allocation) noexcept;
+
+        /**
+         * @brief Enqueue the upload of the data of an allocation.
+         *
+         * @param vertices Vertex attributes of all vertices, laid out as
+         * `MeshAsset::Submesh::WriteVertexAttributeBuffer` writes them.
+         * @param indices Indices as 32-bit unsigned integers, relative to the first vertex of the mesh.
+         */
+        void EnqueueUpload(
+            Allocation allocation,
+            RenderSystemState::SubmissionHelper &helper,
+            std::span<const std::byte> vertices,
+            std::span<const std::byte> indices
+        );
+
+        const Range &GetRange(Allocation allocation) const noexcept;
+
+        /**
+         * @brief Fill vertex buffer bindings of an allocation, one per attribute stream.
+         * Bindings are the same for all allocations in the same vertex pool.
+         */
+        void FillVertexBufferBindings(
+            Allocation allocation, IVertexBasedRenderer::VertexBufferBindings &bindings
+        ) const;
+
+        /**
+         * @brief Get the index buffer binding of an allocation.
+         * Bindings are the same for all allocations in the same index pool.
+         */
+        IVertexBasedRenderer::BufferBindingInfo GetIndexBufferBinding(Allocation allocation) const noexcept;
+
+        /**
+         * @brief Advance the countdown of freed ranges and retired buffers. Called once per frame.
+         */
+        void TickFrame();
+
+        /**
+         * @brief Check whether any pool has more than `MAX_FREE_RANGES_PER_POOL` free ranges.
+         */
+        bool IsFragmented() const noexcept;
+
+        /**
+         * @brief Compact fragmented pools.
+         *
+         * Live ranges of every pool with more than one free range are copied to the
+         * front of a new buffer, and the ranges of their allocations are updated. The
+         * old buffers are released after `FRAMES_IN_FLIGHT` frames.
+         *
+         * The render system calls it at the start of a frame if the arena is fragmented,
+         * so that the copies are submitted before the draws of the frame.
+         */
+        void Defragment(RenderSystemState::SubmissionHelper &helper);
+
+        /**
+         * @brief Get the generation of the arena, which changes whenever `Defragment()`
+         * moves allocations. Bindings and ranges cached by users are stale if it changed.
+         */
+        uint32_t GetGeneration() const noexcept;
+
+        Statistics GetStatistics() const noexcept;
+
+    private:
+        struct impl;
+        std::unique_ptr<impl> pimpl;
+    };
+} // namespace Engine
+
+#endif // RENDER_MEMORY_MESHBUFFERARENA_INCLUDED
@@ -2,76 +2,85 @@
 
 #include "Render/RenderSystem/AllocatorState.h"
 
+namespace {
+    Engine::Texture::TextureDesc ToTextureDesc(const Engine::RenderTargetTexture::RenderTargetTextureDesc &texture) {
+        using namespace Engine;
+        assert(texture.multisample == 1 && "Unimplemented multisampling feature.");
+        return Texture::TextureDesc{
+            .dimensions = texture.dimensions,
+            .width = texture.width,
+            .height = texture.height,
+            .depth = texture.depth,
+            .format = static_cast<ImageUtils::ImageFormat>(static_cast<int>(texture.format)),
+            .memory_type =
+                {(texture.format == RenderTargetTexture::RenderTargetTextureDesc::RTTFormat::D32SFLOAT)
+                     ? ImageMemoryTypeBits::DefaultDepthAttachment
+                     : ImageMemoryTypeBits::DefaultColorAttachment},
+            .mipmap_levels = texture.mipmap_levels,
+            .array_layers = texture.array_layers,
+            .is_cube_map = texture.is_cube_map
+        };
+    }
+} // namespace
+
 namespace Engine {
     RenderTargetTexture::RenderTargetTexture(
         RenderSystem &system, TextureDesc texture, SamplerDesc sampler, const std::string &name
     ) : Texture(system, texture, sampler, name) {
     }
-    RenderTargetTexture RenderTargetTexture::Create(
-        RenderSystem &system, RenderTargetTextureDesc texture, SamplerDesc sampler, const std::string &name
-    ) {
-        assert(texture.multisample == 1 && "Unimplemented multisampling feature.");
-        auto ret = RenderTargetTexture(
-            system,
-            TextureDesc{
-                .dimensions = texture.dimensions,
-                .width = texture.width,
-                .height = texture.height,
-                .depth = texture.depth,
-                .format = static_cast<ImageUtils::ImageFormat>(static_cast<int>(texture.format)),
-                .memory_type =
-                    {(texture.format == RenderTargetTextureDesc::RTTFormat::D32SFLOAT)
-                         ? ImageMemoryTypeBits::DefaultDepthAttachment
-                         : ImageMemoryTypeBits::DefaultColorAttachment},
-                .mipmap_levels = texture.mipmap_levels,
-                .array_layers = texture.array_layers,
-                .is_cube_map = texture.is_cube_map
-            },
-            sampler,
-            name
-        );
-
-        ret.support_random_access = system.GetAllocatorState().QueryFormatFeatures(
-            ImageUtils::GetVkFormat(ret.GetTextureDescription().format), vk::FormatFeatureFlagBits::eStorageImage
+    RenderTargetTexture::RenderTargetTexture(
+        RenderSystem &system,
+        TextureDesc texture,
+        SamplerDesc sampler,
+        const MemoryBlockAllocation &block,
+        size_t offset,
+        const std::string &name
+    ) : Texture(system, texture, sampler, block, offset, name) {
+    }
+    void RenderTargetTexture::QueryFormatSupport(RenderSystem &system) {
+        support_random_access = system.GetAllocatorState().QueryFormatFeatures(
+            ImageUtils::GetVkFormat(GetTextureDescription().format), vk::FormatFeatureFlagBits::eStorageImage
         );
 
-        ret.support_atomic_access = system.GetAllocatorState().QueryFormatFeatures(
-            ImageUtils::GetVkFormat(ret.GetTextureDescription().format), vk::FormatFeatureFlagBits::eStorageImageAtomic
+        support_atomic_access = system.GetAllocatorState().QueryFormatFeatures(
+            ImageUtils::GetVkFormat(GetTextureDescription().format), vk::FormatFeatureFlagBits::eStorageImageAtomic
         );
-
+    }
+    RenderTargetTexture RenderTargetTexture::Create(
+        RenderSystem &system, RenderTargetTextureDesc texture, SamplerDesc sampler, const std::string &name
+    ) {
+        auto ret = RenderTargetTexture(system, ToTextureDesc(texture), sampler, name);
+        ret.QueryFormatSupport(system);
         return ret;
     }
     std::unique_ptr<RenderTargetTexture> RenderTargetTexture::CreateUnique(
         RenderSystem &system, RenderTargetTextureDesc texture, SamplerDesc sampler, const std::string &name
     ) {
-        auto ret = std::unique_ptr<RenderTargetTexture>(new RenderTargetTexture(
-            system,
-            TextureDesc{
-                .dimensions = texture.dimensions,
-                .width = texture.width,
-                .height = texture.height,
-                .depth = texture.depth,
-                .format = static_cast<ImageUtils::ImageFormat>(static_cast<int>(texture.format)),
-                .memory_type =
-                    {(texture.format == RenderTargetTextureDesc::RTTFormat::D32SFLOAT)
-                         ? ImageMemoryTypeBits::DefaultDepthAttachment
-                         : ImageMemoryTypeBits::DefaultColorAttachment},
-                .mipmap_levels = texture.mipmap_levels,
-                .array_layers = texture.array_layers,
-                .is_cube_map = texture.is_cube_map
-            },
-            sampler,
-            name
-        ));
-        ret->support_random_access = system.GetAllocatorState().QueryFormatFeatures(
-            ImageUtils::GetVkFormat(ret->GetTextureDescription().format), vk::FormatFeatureFlagBits::eStorageImage
+        auto ret = std::unique_ptr<RenderTargetTexture>(
+            new RenderTargetTexture(system, ToTextureDesc(texture), sampler, name)
         );
-
-        ret->support_atomic_access = system.GetAllocatorState().QueryFormatFeatures(
-            ImageUtils::GetVkFormat(ret->GetTextureDescription().format), vk::FormatFeatureFlagBits::eStorageImageAtomic
+        ret->QueryFormatSupport(system);
+        return ret;
+    }
+    std::unique_ptr<RenderTargetTexture> RenderTargetTexture::CreateUniqueAliased(
+        RenderSystem &system,
+        RenderTargetTextureDesc texture,
+        SamplerDesc sampler,
+        const MemoryBlockAllocation &block,
+        size_t offset,
+        const std::string &name
+    ) {
+        auto ret = std::unique_ptr<RenderTargetTexture>(
+            new RenderTargetTexture(system, ToTextureDesc(texture), sampler, block, offset, name)
         );
+        ret->QueryFormatSupport(system);
         return ret;
     }
+    vk::MemoryRequirements RenderTargetTexture::QueryMemoryRequirements(
+        RenderSystem &system, RenderTargetTextureDesc texture
+    ) {
+        return Texture::QueryMemoryRequirements(system, ToTextureDesc(texture));
+    }
     bool RenderTargetTexture::SupportRandomAccess() const noexcept {
         return support_random_access;
     }
@@ -65,6 +65,17 @@ namespace Engine {
         RenderTargetTexture(
             RenderSystem &system, TextureDesc texture, SamplerDesc sampler, const std::string &name = ""
         );
+        RenderTargetTexture(
+            RenderSystem &system,
+            TextureDesc texture,
+            SamplerDesc sampler,
+            const MemoryBlockAllocation &block,
+            size_t offset,
+            const std::string &name = ""
+        );
+
+        /// @brief Query format features, called by named constructors.
+        void QueryFormatSupport(RenderSystem &system);
 
         bool support_random_access{false}, support_atomic_access{false};
 
@@ -84,6 +95,30 @@ namespace Engine {
             RenderSystem &system, RenderTargetTextureDesc texture, SamplerDesc sampler, const std::string &name = ""
         );
 
+        /**
+         * @brief Create a render target texture over a memory block at the given offset.
+         *
+         * The texture does not own its memory, and the block must outlive it. Used
+         * to alias memory of transient render targets whose lifetimes do not
+         * overlap.
+         *
+         * @see `QueryMemoryRequirements()`
+         */
+        static std::unique_ptr<RenderTargetTexture> CreateUniqueAliased(
+            RenderSystem &system,
+            RenderTargetTextureDesc texture,
+            SamplerDesc sampler,
+            const MemoryBlockAllocation &block,
+            size_t offset,
+            const std::string &name = ""
+        );
+
+        /**
+         * @brief Query the memory requirements of a render target texture, without
+         * creating it.
+         */
+        static vk::MemoryRequirements QueryMemoryRequirements(RenderSystem &system, RenderTargetTextureDesc texture);
+
         bool SupportRandomAccess() const noexcept override;
         bool SupportAtomicOperation() const noexcept override;
     };
@@ -1,6 +1,7 @@
 #include "ShaderResourceBinding.h"
 
 #include "Render/Hasher.hpp"
+#include "Render/Memory/DescriptorAllocator.h"
 #include "Render/Memory/ShaderParameters/ShaderInterface.h"
 #include "Render/Memory/ShaderParameters/ShaderParameterLayout.h"
 
@@ -49,6 +50,18 @@ namespace Engine {
             // XXX: use a LRU cache instead of unordered map here, to mitigate memory leak.
             std::unordered_map<size_t, vk::DescriptorSet>>
             descriptor_sets{};
+
+        // Allocators of the sets of each layout hash, if they are not allocated from pools directly.
+        std::unordered_map<size_t, std::shared_ptr<DescriptorAllocator>> allocators{};
+
+        void FreeDescriptorSets(size_t layout_hash) noexcept {
+            auto itr = allocators.find(layout_hash);
+            if (itr == allocators.end()) return;
+            for (const auto &[content_hash, set] : descriptor_sets[layout_hash]) {
+                itr->second->Free(set);
+            }
+            descriptor_sets[layout_hash].clear();
+        }
     };
 
     ShaderResourceBinding::ShaderResourceBinding(RenderSystemState::ImmutableResourceCache &irc) :
@@ -56,7 +69,11 @@ namespace Engine {
         pimpl->irc = &irc;
     }
 
-    ShaderResourceBinding::~ShaderResourceBinding() noexcept = default;
+    ShaderResourceBinding::~ShaderResourceBinding() noexcept {
+        for (const auto &[layout_hash, allocator] : pimpl->allocators) {
+            pimpl->FreeDescriptorSets(layout_hash);
+        }
+    }
 
     void ShaderResourceBinding::BindBuffer(
         const std::string &name, const DeviceBuffer &buf, size_t offset, size_t size
@@ -81,6 +98,32 @@ namespace Engine {
         vk::DescriptorPool pool,
         bool enforce_dynamic_uniform,
         bool enforce_dynamic_storage
+    ) {
+        return GetOrCreateDescriptorSet(set_id, s, d, pool, nullptr, enforce_dynamic_uniform, enforce_dynamic_storage);
+    }
+
+    vk::DescriptorSet ShaderResourceBinding::GetDescriptorSet(
+        uint32_t set_id,
+        const ShdrRfl::SPLayout &s,
+        vk::Device d,
+        const std::shared_ptr<DescriptorAllocator> &allocator,
+        bool enforce_dynamic_uniform,
+        bool enforce_dynamic_storage
+    ) {
+        assert(allocator);
+        return GetOrCreateDescriptorSet(
+            set_id, s, d, nullptr, allocator, enforce_dynamic_uniform, enforce_dynamic_storage
+        );
+    }
+
+    vk::DescriptorSet ShaderResourceBinding::GetOrCreateDescriptorSet(
+        uint32_t set_id,
+        const ShdrRfl::SPLayout &s,
+        vk::Device d,
+        vk::DescriptorPool pool,
+        const std::shared_ptr<DescriptorAllocator> &allocator,
+        bool enforce_dynamic_uniform,
+        bool enforce_dynamic_storage
     ) {
         // First calculate a hash from currently bound resources.
         RenderResourceHasher h;
@@ -181,9 +224,19 @@ namespace Engine {
             vk::DescriptorSetLayoutCreateInfo{vk::DescriptorSetLayoutCreateFlags{}, dslb}
         );
         // Allocate descriptor set
-        assert(pool);
-        vk::DescriptorSetAllocateInfo dsai{pool, {dsl}};
-        auto descriptor = d.allocateDescriptorSets(dsai)[0];
+        vk::DescriptorSet descriptor{};
+        if (allocator) {
+            assert(allocator->GetLayout() == dsl);
+            // Sets of previous contents are recycled instead of being kept forever. Contents
+            // switching back and forth reallocate, but no set leaks.
+            pimpl->allocators[layout_hash] = allocator;
+            pimpl->FreeDescriptorSets(layout_hash);
+            descriptor = allocator->Allocate();
+        } else {
+            assert(pool);
+            vk::DescriptorSetAllocateInfo dsai{pool, {dsl}};
+            descriptor = d.allocateDescriptorSets(dsai)[0];
+        }
         pimpl->descriptor_sets[layout_hash][content_hash] = descriptor;
 
         size_t image_write_count{0}, buffer_write_count{0};
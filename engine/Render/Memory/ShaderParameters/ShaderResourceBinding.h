@@ -11,6 +11,7 @@
 namespace Engine {
 
     class DeviceBuffer;
+    class DescriptorAllocator;
     class Texture;
 
     namespace RenderSystemState {
@@ -32,9 +33,12 @@ namespace Engine {
      * As indicated by the interface, this class holds no ownership of
      * resources.
      *
-     * As per Vulkan best practice, descriptor sets are not de-allocated. So
-     * changes to descriptor sets (i.e. resetting texture or buffer references)
-     * can lead to memory leak if too frequent.
+     * As per Vulkan best practice, descriptor sets allocated from pools are
+     * not de-allocated. So changes to descriptor sets (i.e. resetting texture
+     * or buffer references) can lead to memory leak if too frequent. Sets
+     * allocated from a `DescriptorAllocator` are instead returned to it when
+     * they are replaced by a set of new contents, or when this object is
+     * destroyed.
      *
      * Using this class with `StructuredBuffer` together is recommended.
      * The other class handles trivial uniform buffer variables (e.g. floats,
@@ -91,6 +95,33 @@ namespace Engine {
             bool enforce_dynamic_uniform = false,
             bool enforce_dynamic_storage = false
         );
+
+        /**
+         * @overload
+         *
+         * The set is allocated from the allocator, which must be created with the
+         * layout of the set. Only the set of the current contents is kept per
+         * layout, sets of previous contents are freed to the allocator.
+         */
+        vk::DescriptorSet GetDescriptorSet(
+            uint32_t set_id,
+            const ShdrRfl::SPLayout &s,
+            vk::Device d,
+            const std::shared_ptr<DescriptorAllocator> &allocator,
+            bool enforce_dynamic_uniform = false,
+            bool enforce_dynamic_storage = false
+        );
+
+    private:
+        vk::DescriptorSet GetOrCreateDescriptorSet(
+            uint32_t set_id,
+            const ShdrRfl::SPLayout &s,
+            vk::Device d,
+            vk::DescriptorPool pool,
+            const std::shared_ptr<DescriptorAllocator> &allocator,
+            bool enforce_dynamic_uniform,
+            bool enforce_dynamic_storage
+        );
     };
 } // namespace Engine
 
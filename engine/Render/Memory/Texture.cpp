@@ -15,6 +15,35 @@ namespace {
         return d.dimensions == 1 ? vk::ImageType::e1D : (d.dimensions == 2 ? vk::ImageType::e2D : vk::ImageType::e3D);
     }
 
+    Engine::RenderSystemState::AllocatorState::ImageAllocationDescription GetImageAllocationDescription(
+        const Engine::Texture::TextureDesc &texture
+    ) {
+        auto dimension = texture.dimensions;
+        auto [width, height, depth] = std::tie(texture.width, texture.height, texture.depth);
+        auto mipLevels = texture.mipmap_levels;
+        auto arrayLayers = texture.array_layers;
+
+        // Some prelimary checks
+        assert(1 <= dimension && dimension <= 3);
+        assert(width >= 1 && height >= 1 && depth >= 1);
+        assert(dimension != 1 || (height == 1 && depth == 1));
+        assert(dimension != 2 || (depth == 1));
+        assert(mipLevels >= 1);
+        assert(arrayLayers >= 1);
+        assert(!texture.is_cube_map || arrayLayers == 6);
+
+        return Engine::RenderSystemState::AllocatorState::ImageAllocationDescription{
+            texture.memory_type,
+            GetImageType(texture),
+            vk::Extent3D{width, height, depth},
+            Engine::ImageUtils::GetVkFormat(texture.format),
+            mipLevels,
+            arrayLayers,
+            texture.is_cube_map,
+            vk::SampleCountFlagBits::e1
+        };
+    }
+
     constexpr vk::ImageViewType GetImageViewType(
         const Engine::Texture::TextureDesc &d, const Engine::TextureSubresourceRange &r
     ) {
@@ -141,34 +170,28 @@ namespace Engine {
         pimpl(std::make_unique<impl>()) {
 
         auto &allocator = system.GetAllocatorState();
-        auto dimension = texture.dimensions;
-        auto [width, height, depth] = std::tie(texture.width, texture.height, texture.depth);
-        auto mipLevels = texture.mipmap_levels;
-        auto arrayLayers = texture.array_layers;
+        pimpl->device = system.GetDevice();
+        pimpl->m_image = allocator.AllocateImageUnique(GetImageAllocationDescription(texture), name);
+        pimpl->m_tdesc = texture;
+        pimpl->m_name = name;
 
-        // Some prelimary checks
-        assert(1 <= dimension && dimension <= 3);
-        assert(width >= 1 && height >= 1 && depth >= 1);
-        assert(dimension != 1 || (height == 1 && depth == 1));
-        assert(dimension != 2 || (depth == 1));
-        assert(mipLevels >= 1);
-        assert(arrayLayers >= 1);
-        assert(!texture.is_cube_map || arrayLayers == 6);
+        pimpl->m_sampler = system.GetIRCache().GetSampler(sampler);
+        pimpl->m_sdesc = sampler;
+    }
+
+    Texture::Texture(
+        RenderSystem &system,
+        TextureDesc texture,
+        SamplerDesc sampler,
+        const MemoryBlockAllocation &block,
+        size_t offset,
+        const std::string &name
+    ) : pimpl(std::make_unique<impl>()) {
 
-        auto dim = dimension == 1 ? vk::ImageType::e1D : (dimension == 2 ? vk::ImageType::e2D : vk::ImageType::e3D);
+        auto &allocator = system.GetAllocatorState();
         pimpl->device = system.GetDevice();
-        pimpl->m_image = allocator.AllocateImageUnique(
-            RenderSystemState::AllocatorState::ImageAllocationDescription{
-                texture.memory_type,
-                dim,
-                vk::Extent3D{width, height, depth},
-                ImageUtils::GetVkFormat(texture.format),
-                mipLevels,
-                arrayLayers,
-                texture.is_cube_map,
-                vk::SampleCountFlagBits::e1
-            },
-            name
+        pimpl->m_image = std::make_unique<ImageAllocation>(
+            allocator.AllocateAliasingImage(GetImageAllocationDescription(texture), block, offset, name)
         );
         pimpl->m_tdesc = texture;
         pimpl->m_name = name;
@@ -183,6 +206,10 @@ namespace Engine {
 
     Texture::~Texture() = default;
 
+    vk::MemoryRequirements Texture::QueryMemoryRequirements(RenderSystem &system, const TextureDesc &texture) {
+        return system.GetAllocatorState().QueryImageMemoryRequirements(GetImageAllocationDescription(texture));
+    }
+
     const Texture::TextureDesc &Texture::GetTextureDescription() const noexcept {
         return pimpl->m_tdesc;
     }
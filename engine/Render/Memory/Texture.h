@@ -8,11 +8,13 @@ namespace vk {
     class Image;
     class ImageView;
     class Sampler;
+    struct MemoryRequirements;
 } // namespace vk
 
 namespace Engine {
     class RenderSystem;
     class AllocatedMemory;
+    class MemoryBlockAllocation;
     class DeviceBuffer;
     class TextureSubresourceRange;
 
@@ -41,6 +43,21 @@ namespace Engine {
 
         Texture(RenderSystem &system, TextureDesc texture, SamplerDesc sampler, const std::string &name = "");
 
+        /**
+         * @brief Create a texture over a memory block at the given offset, instead of
+         * allocating its own memory.
+         *
+         * The block must outlive the texture.
+         */
+        Texture(
+            RenderSystem &system,
+            TextureDesc texture,
+            SamplerDesc sampler,
+            const MemoryBlockAllocation &block,
+            size_t offset,
+            const std::string &name = ""
+        );
+
     public:
         Texture(const Texture &) = delete;
         void operator=(const Texture &) = delete;
@@ -50,6 +67,12 @@ namespace Engine {
         Texture &operator=(Texture &&) noexcept = delete;
 
         virtual ~Texture();
+
+        /**
+         * @brief Query the memory requirements of a texture, without creating it.
+         */
+        static vk::MemoryRequirements QueryMemoryRequirements(RenderSystem &system, const TextureDesc &texture);
+
         /**
          * @brief Get the description struct of this texture.
          */
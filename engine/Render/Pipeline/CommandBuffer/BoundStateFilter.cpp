@@ -0,0 +1,121 @@
+#include "BoundStateFilter.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Engine {
+    bool BoundStateFilter::ShouldBindPipeline(vk::Pipeline pipeline, vk::PipelineLayout layout) noexcept {
+        if (pipeline == m_pipeline && layout == m_pipeline_layout) return Count(false);
+        m_pipeline = pipeline;
+        m_pipeline_layout = layout;
+        m_statistics.pipeline_binds++;
+        return Count(true);
+    }
+
+    bool BoundStateFilter::ShouldBindVertexBuffers(
+        std::span<const vk::Buffer> buffers, std::span<const vk::DeviceSize> offsets
+    ) noexcept {
+        assert(buffers.size() == offsets.size());
+        if (buffers.size() > MAX_VERTEX_BUFFERS) {
+            m_vertex_buffers.clear();
+            m_vertex_offsets.clear();
+            return Count(true);
+        }
+        // Bindings beyond the new ones stay bound, so a prefix of the bound buffers suffices.
+        if (buffers.size() <= m_vertex_buffers.size()
+            && std::equal(buffers.begin(), buffers.end(), m_vertex_buffers.begin())
+            && std::equal(offsets.begin(), offsets.end(), m_vertex_offsets.begin())) {
+            return Count(false);
+        }
+
+        size_t bound = std::max(buffers.size(), m_vertex_buffers.size());
+        m_vertex_buffers.resize(bound);
+        m_vertex_offsets.resize(bound);
+        std::copy(buffers.begin(), buffers.end(), m_vertex_buffers.begin());
+        std::copy(offsets.begin(), offsets.end(), m_vertex_offsets.begin());
+        return Count(true);
+    }
+
+    bool BoundStateFilter::ShouldBindIndexBuffer(
+        vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType type
+    ) noexcept {
+        if (buffer == m_index_buffer && offset == m_index_offset && type == m_index_type) return Count(false);
+        m_index_buffer = buffer;
+        m_index_offset = offset;
+        m_index_type = type;
+        return Count(true);
+    }
+
+    bool BoundStateFilter::ShouldBindDescriptorSet(
+        vk::PipelineLayout layout,
+        uint32_t set,
+        vk::DescriptorSet descriptor_set,
+        std::span<const uint32_t> dynamic_offsets
+    ) noexcept {
+        if (set >= MAX_DESCRIPTOR_SETS) {
+            m_statistics.descriptor_set_binds++;
+            return Count(true);
+        }
+        if (dynamic_offsets.size() > MAX_DYNAMIC_OFFSETS) {
+            for (uint32_t s = set; s < MAX_DESCRIPTOR_SETS; s++) m_descriptor_sets[s] = {};
+            m_statistics.descriptor_set_binds++;
+            return Count(true);
+        }
+        auto &state = m_descriptor_sets[set];
+        if (state.set && state.set == descriptor_set && state.layout == layout
+            && std::equal(
+                dynamic_offsets.begin(),
+                dynamic_offsets.end(),
+                state.dynamic_offsets.begin(),
+                state.dynamic_offsets.end()
+            )) {
+            return Count(false);
+        }
+
+        state.layout = layout;
+        state.set = descriptor_set;
+        state.dynamic_offsets.clear();
+        for (auto offset : dynamic_offsets) state.dynamic_offsets.push_back(offset);
+        for (uint32_t higher = set + 1; higher < MAX_DESCRIPTOR_SETS; higher++) {
+            m_descriptor_sets[higher] = {};
+        }
+        m_statistics.descriptor_set_binds++;
+        return Count(true);
+    }
+
+    bool BoundStateFilter::ShouldPushConstants(vk::PipelineLayout layout, std::span<const std::byte> data) noexcept {
+        if (data.size() > MAX_PUSH_CONSTANT_SIZE) {
+            m_push_constant_layout = vk::PipelineLayout{};
+            m_push_constants.clear();
+            return Count(true);
+        }
+        if (layout == m_push_constant_layout
+            && std::equal(data.begin(), data.end(), m_push_constants.begin(), m_push_constants.end())) {
+            return Count(false);
+        }
+
+        m_push_constant_layout = layout;
+        m_push_constants.resize(data.size());
+        std::copy(data.begin(), data.end(), m_push_constants.begin());
+        return Count(true);
+    }
+
+    vk::PipelineLayout BoundStateFilter::GetPipelineLayout() const noexcept {
+        return m_pipeline_layout;
+    }
+
+    void BoundStateFilter::Invalidate() noexcept {
+        auto statistics = m_statistics;
+        *this = BoundStateFilter{};
+        m_statistics = statistics;
+    }
+
+    BoundStateFilter::Statistics BoundStateFilter::GetStatistics() const noexcept {
+        return m_statistics;
+    }
+
+    bool BoundStateFilter::Count(bool should_record) noexcept {
+        (should_record ? m_statistics.recorded : m_statistics.skipped)++;
+        return should_record;
+    }
+} // namespace Engine
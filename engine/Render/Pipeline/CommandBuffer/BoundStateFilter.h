@@ -0,0 +1,111 @@
+#ifndef PIPELINE_COMMANDBUFFER_BOUNDSTATEFILTER_INCLUDED
+#define PIPELINE_COMMANDBUFFER_BOUNDSTATEFILTER_INCLUDED
+
+#include "Core/InlineVector.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vulkan/vulkan.hpp>
+
+namespace Engine {
+    /**
+     * @brief Filter of redundant state changes recorded to a graphics command buffer.
+     *
+     * It tracks the pipeline, vertex buffers, index buffer, descriptor sets and
+     * push constants bound to a command buffer. Before recording a state change,
+     * ask the corresponding `ShouldXXX` method: it returns false if the state is
+     * already bound, and otherwise records the new state and returns true, in
+     * which case the command must be recorded.
+     *
+     * The filter only knows about commands that went through it. Call
+     * `Invalidate()` after recording commands to the command buffer directly.
+     * States beyond the limits below are not tracked, and always recorded.
+     */
+    class BoundStateFilter {
+    public:
+        static constexpr uint32_t MAX_VERTEX_BUFFERS = 16;
+        static constexpr uint32_t MAX_DESCRIPTOR_SETS = 4;
+        static constexpr uint32_t MAX_DYNAMIC_OFFSETS = 8;
+        /// Guaranteed minimum of `maxPushConstantsSize`.
+        static constexpr uint32_t MAX_PUSH_CONSTANT_SIZE = 128;
+
+        struct Statistics {
+            /// Count of state changes that must be recorded.
+            uint64_t recorded;
+            /// Count of state changes skipped as redundant.
+            uint64_t skipped;
+            /// Count of recorded pipeline binds, included in `recorded`.
+            uint64_t pipeline_binds;
+            /// Count of recorded descriptor set binds, included in `recorded`.
+            uint64_t descriptor_set_binds;
+        };
+
+        bool ShouldBindPipeline(vk::Pipeline pipeline, vk::PipelineLayout layout) noexcept;
+
+        bool ShouldBindVertexBuffers(
+            std::span<const vk::Buffer> buffers, std::span<const vk::DeviceSize> offsets
+        ) noexcept;
+
+        bool ShouldBindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType type) noexcept;
+
+        /**
+         * @brief Check a descriptor set binding.
+         *
+         * A set is only considered bound if it was bound with the same pipeline
+         * layout and dynamic offsets. Binding a set forgets all sets of higher
+         * indices, as they may be disturbed by an incompatible layout.
+         */
+        bool ShouldBindDescriptorSet(
+            vk::PipelineLayout layout,
+            uint32_t set,
+            vk::DescriptorSet descriptor_set,
+            std::span<const uint32_t> dynamic_offsets
+        ) noexcept;
+
+        /**
+         * @brief Check a push constant update of all graphics stages starting from offset zero.
+         *
+         * Push constants are only considered pushed if they were pushed with the
+         * same pipeline layout and the same content.
+         */
+        bool ShouldPushConstants(vk::PipelineLayout layout, std::span<const std::byte> data) noexcept;
+
+        /// @brief Get the layout of the bound pipeline, or a null handle if no pipeline is bound.
+        vk::PipelineLayout GetPipelineLayout() const noexcept;
+
+        /// @brief Forget all bound states, so that the next state changes are all recorded.
+        void Invalidate() noexcept;
+
+        Statistics GetStatistics() const noexcept;
+
+    protected:
+        bool Count(bool should_record) noexcept;
+
+        struct DescriptorSetState {
+            vk::PipelineLayout layout{};
+            vk::DescriptorSet set{};
+            InlineVector<uint32_t, MAX_DYNAMIC_OFFSETS> dynamic_offsets{};
+        };
+
+        vk::Pipeline m_pipeline{};
+        vk::PipelineLayout m_pipeline_layout{};
+
+        InlineVector<vk::Buffer, MAX_VERTEX_BUFFERS> m_vertex_buffers{};
+        InlineVector<vk::DeviceSize, MAX_VERTEX_BUFFERS> m_vertex_offsets{};
+
+        vk::Buffer m_index_buffer{};
+        vk::DeviceSize m_index_offset{};
+        vk::IndexType m_index_type{};
+
+        std::array<DescriptorSetState, MAX_DESCRIPTOR_SETS> m_descriptor_sets{};
+
+        vk::PipelineLayout m_push_constant_layout{};
+        InlineVector<std::byte, MAX_PUSH_CONSTANT_SIZE> m_push_constants{};
+
+        Statistics m_statistics{};
+    };
+} // namespace Engine
+
+#endif // PIPELINE_COMMANDBUFFER_BOUNDSTATEFILTER_INCLUDED
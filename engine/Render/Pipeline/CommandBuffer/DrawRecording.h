@@ -0,0 +1,138 @@
+#ifndef PIPELINE_COMMANDBUFFER_DRAWRECORDING_INCLUDED
+#define PIPELINE_COMMANDBUFFER_DRAWRECORDING_INCLUDED
+
+#include "Render/Pipeline/CommandBuffer/BoundStateFilter.h"
+#include "Render/RenderSystem/DrawPacket.h"
+
+#include <cassert>
+#include <cstdint>
+#include <glm.hpp>
+#include <span>
+#include <vulkan/vulkan.hpp>
+
+namespace Engine {
+    /**
+     * @brief State changes and draws recorded by `GraphicsCommandBuffer`, filtered by a `BoundStateFilter`.
+     *
+     * They are templated on the command buffer, which is a `vk::CommandBuffer`
+     * in the engine, so that they can also record to a command buffer that only
+     * counts commands, e.g. in benchmarks.
+     */
+    namespace DrawRecording {
+        template <typename CommandBuffer>
+        void BindPipeline(
+            CommandBuffer &cb, BoundStateFilter &filter, vk::Pipeline pipeline, vk::PipelineLayout layout
+        ) {
+            if (filter.ShouldBindPipeline(pipeline, layout)) {
+                cb.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+            }
+        }
+
+        template <typename CommandBuffer>
+        void BindDescriptorSet(
+            CommandBuffer &cb,
+            BoundStateFilter &filter,
+            vk::PipelineLayout layout,
+            uint32_t set,
+            vk::DescriptorSet descriptor_set,
+            std::span<const uint32_t> dynamic_offsets
+        ) {
+            if (filter.ShouldBindDescriptorSet(layout, set, descriptor_set, dynamic_offsets)) {
+                cb.bindDescriptorSets(
+                    vk::PipelineBindPoint::eGraphics,
+                    layout,
+                    set,
+                    1,
+                    &descriptor_set,
+                    static_cast<uint32_t>(dynamic_offsets.size()),
+                    dynamic_offsets.data()
+                );
+            }
+        }
+
+        /**
+         * @brief Bind the pipeline of a material, and its descriptor set to set 2 if it has one.
+         */
+        template <typename CommandBuffer>
+        void BindMaterial(
+            CommandBuffer &cb,
+            BoundStateFilter &filter,
+            vk::Pipeline pipeline,
+            vk::PipelineLayout layout,
+            vk::DescriptorSet material_descriptor_set,
+            std::span<const uint32_t> dynamic_offsets
+        ) {
+            BindPipeline(cb, filter, pipeline, layout);
+            if (material_descriptor_set) {
+                BindDescriptorSet(cb, filter, layout, 2, material_descriptor_set, dynamic_offsets);
+            }
+        }
+
+        template <typename CommandBuffer>
+        void BindVertexBuffers(
+            CommandBuffer &cb,
+            BoundStateFilter &filter,
+            std::span<const vk::Buffer> buffers,
+            std::span<const vk::DeviceSize> offsets
+        ) {
+            if (filter.ShouldBindVertexBuffers(buffers, offsets)) {
+                cb.bindVertexBuffers(0, static_cast<uint32_t>(buffers.size()), buffers.data(), offsets.data());
+            }
+        }
+
+        template <typename CommandBuffer>
+        void BindIndexBuffer(CommandBuffer &cb, BoundStateFilter &filter, vk::Buffer buffer, vk::DeviceSize offset) {
+            if (filter.ShouldBindIndexBuffer(buffer, offset, vk::IndexType::eUint32)) {
+                cb.bindIndexBuffer(buffer, offset, vk::IndexType::eUint32);
+            }
+        }
+
+        template <typename CommandBuffer>
+        void BindPacketBuffers(
+            CommandBuffer &cb, BoundStateFilter &filter, const RenderSystemState::DrawPacket &packet
+        ) {
+            BindVertexBuffers(cb, filter, packet.vertex_buffers, packet.vertex_offsets);
+            BindIndexBuffer(cb, filter, packet.index_buffer, packet.index_offset);
+        }
+
+        /**
+         * @brief Push the model matrix and the camera index to the layout of the bound pipeline.
+         */
+        template <typename CommandBuffer>
+        void PushRendererData(
+            CommandBuffer &cb, BoundStateFilter &filter, const glm::mat4 &model_matrix, int32_t camera_index
+        ) {
+            struct {
+                glm::mat4 m;
+                int32_t i;
+            } push_constants{.m = model_matrix, .i = camera_index};
+
+            vk::PipelineLayout layout = filter.GetPipelineLayout();
+            assert(layout && "A material must be bound before pushing renderer data.");
+            // Instanced draws push the same data over and over.
+            if (filter.ShouldPushConstants(layout, std::as_bytes(std::span{&push_constants, 1}))) {
+                cb.pushConstants(
+                    layout,
+                    vk::ShaderStageFlagBits::eAllGraphics,
+                    0,
+                    sizeof(push_constants),
+                    reinterpret_cast<const void *>(&push_constants)
+                );
+            }
+        }
+
+        template <typename CommandBuffer>
+        void DrawPacketInstances(
+            CommandBuffer &cb,
+            const RenderSystemState::DrawPacket &packet,
+            uint32_t instance_count,
+            uint32_t first_instance
+        ) {
+            cb.drawIndexed(
+                packet.index_count, instance_count, packet.first_index, packet.vertex_offset, first_instance
+            );
+        }
+    } // namespace DrawRecording
+} // namespace Engine
+
+#endif // PIPELINE_COMMANDBUFFER_DRAWRECORDING_INCLUDED
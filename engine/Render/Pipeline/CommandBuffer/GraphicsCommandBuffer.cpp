@@ -3,10 +3,13 @@
 #include "Framework/component/RenderComponent/RendererComponent.h"
 #include "Render/AttachmentUtilsFunc.h"
 #include "Render/Memory/DeviceBuffer.h"
+#include "Render/Memory/IndexedBuffer.h"
+#include "Render/Pipeline/CommandBuffer/DrawRecording.h"
 #include "Render/Pipeline/Material/MaterialInstance.h"
 #include "Render/Pipeline/Material/MaterialLibrary.h"
 #include "Render/RenderSystem.h"
 #include "Render/RenderSystem/CameraManager.h"
+#include "Render/RenderSystem/DrawPacket.h"
 #include "Render/RenderSystem/FrameManager.h"
 #include "Render/RenderSystem/RendererManager.h"
 #include "Render/RenderSystem/Swapchain.h"
@@ -18,7 +21,11 @@
 #include "Render/DebugUtils.h"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <glm.hpp>
+#include <span>
 #include <vulkan/vulkan.hpp>
 
 namespace Engine {
@@ -32,10 +39,11 @@ namespace Engine {
         vk::Extent2D extent,
         const std::string &name
     ) {
-        std::vector<vk::RenderingAttachmentInfo> color_attachment;
+        m_bound_state.Invalidate();
 
+        vk::RenderingAttachmentInfo color_attachment{};
         if (color.texture) {
-            color_attachment.push_back(GetVkAttachmentInfo(color, vk::ImageLayout::eColorAttachmentOptimal));
+            color_attachment = GetVkAttachmentInfo(color, vk::ImageLayout::eColorAttachmentOptimal);
             m_pripr.color_attachment_format[0] = color.texture->GetTextureDescription().format;
             m_pripr.color_attachment_format[1] = ImageUtils::ImageFormat::UNDEFINED;
         } else {
@@ -57,7 +65,8 @@ namespace Engine {
             vk::Rect2D{{0, 0}, extent},
             1,
             0,
-            color_attachment,
+            color.texture ? 1u : 0u,
+            &color_attachment,
             depth.texture ? &depth_attachment : nullptr,
             nullptr
         };
@@ -71,7 +80,9 @@ namespace Engine {
         vk::Extent2D extent,
         const std::string &name
     ) {
-        std::vector<vk::RenderingAttachmentInfo> color_attachment_info(colors.size(), vk::RenderingAttachmentInfo{});
+        m_bound_state.Invalidate();
+
+        std::array<vk::RenderingAttachmentInfo, 8> color_attachment_info{};
         assert(colors.size() < 8 && "At most 8 color rendering targets are supported.");
         for (size_t i = 0; i < colors.size(); i++) {
             color_attachment_info[i] = GetVkAttachmentInfo(colors[i], vk::ImageLayout::eColorAttachmentOptimal);
@@ -94,7 +105,8 @@ namespace Engine {
             vk::Rect2D{{0, 0}, extent},
             1,
             0,
-            color_attachment_info,
+            static_cast<uint32_t>(colors.size()),
+            color_attachment_info.data(),
             depth.texture ? &depth_attachment_info : nullptr,
             nullptr
         };
@@ -104,50 +116,34 @@ namespace Engine {
     }
 
     void GraphicsCommandBuffer::BindSceneResources(const RenderSystemState::SceneDataManager &sdm) {
-        cb.bindDescriptorSets(
-            vk::PipelineBindPoint::eGraphics,
-            sdm.GetCommonPipelineLayout(),
-            0,
-            {sdm.GetLightDescriptorSet(m_inflight_frame_index)},
-            {}
-        );
+        vk::PipelineLayout layout = sdm.GetCommonPipelineLayout();
+        vk::DescriptorSet set = sdm.GetLightDescriptorSet(m_inflight_frame_index);
+        DrawRecording::BindDescriptorSet(cb, m_bound_state, layout, 0, set, {});
     }
 
     void GraphicsCommandBuffer::BindCameraResources(const RenderSystemState::CameraManager &cm) {
-        cb.bindDescriptorSets(
-            vk::PipelineBindPoint::eGraphics,
-            cm.GetCommonPipelineLayout(),
-            1,
-            {cm.GetDescriptorSet(m_inflight_frame_index)},
-            {}
-        );
+        vk::PipelineLayout layout = cm.GetCommonPipelineLayout();
+        vk::DescriptorSet set = cm.GetDescriptorSet(m_inflight_frame_index);
+        DrawRecording::BindDescriptorSet(cb, m_bound_state, layout, 1, set, {});
     }
 
     void GraphicsCommandBuffer::BindMaterial(MaterialInstance &material, MaterialTemplate &tpl) {
-        const auto &pipeline = tpl.GetPipeline();
-        const auto &pipeline_layout = tpl.GetPipelineLayout();
-
-        bool bind_new_pipeline = false;
-        if (!m_bound_material_pipeline.has_value()) {
-            bind_new_pipeline = true;
-        } else if (pipeline != m_bound_material_pipeline.value().first
-                   || pipeline_layout != m_bound_material_pipeline.value().second) {
-            bind_new_pipeline = true;
-        }
-        if (bind_new_pipeline) {
-            cb.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
-            m_bound_material_pipeline = std::make_pair(pipeline, pipeline_layout);
-        }
+        this->BindMaterial(material, tpl, tpl.GetPipeline(), tpl.GetPipelineLayout());
+    }
 
-        if (!tpl.HasMaterialData()) return;
+    void GraphicsCommandBuffer::BindMaterial(
+        MaterialInstance &material, MaterialTemplate &tpl, vk::Pipeline pipeline, vk::PipelineLayout pipeline_layout
+    ) {
+        if (!tpl.HasMaterialData()) {
+            DrawRecording::BindPipeline(cb, m_bound_state, pipeline, pipeline_layout);
+            return;
+        }
 
         auto dynamic_offsets = material.UpdateGPUInfo(tpl, m_inflight_frame_index);
         auto material_descriptor_set = material.GetDescriptor(tpl, m_inflight_frame_index);
-        if (material_descriptor_set) {
-            cb.bindDescriptorSets(
-                vk::PipelineBindPoint::eGraphics, pipeline_layout, 2, {material_descriptor_set}, dynamic_offsets
-            );
-        }
+        DrawRecording::BindMaterial(
+            cb, m_bound_state, pipeline, pipeline_layout, material_descriptor_set, dynamic_offsets
+        );
     }
 
     void GraphicsCommandBuffer::SetupViewport(float vpWidth, float vpHeight, vk::Rect2D scissor) {
@@ -164,36 +160,86 @@ namespace Engine {
         this->DrawMesh(mesh, model_matrix, m_system.GetCameraManager().GetActiveCameraIndex());
     }
 
-    void GraphicsCommandBuffer::DrawMesh(
-        const IVertexBasedRenderer &mesh, const glm::mat4 &model_matrix, int32_t camera_index
-    ) {
-        auto bindings = mesh.GetVertexAttributeBufferBindings();
-        std::vector<vk::DeviceSize> offsets{};
-        std::vector<vk::Buffer> buffers{};
-        offsets.resize(bindings.size());
-        buffers.resize(bindings.size());
-        for (size_t i = 0; i < bindings.size(); i++) {
-            offsets[i] = bindings[i].offset;
-            buffers[i] = bindings[i].buffer->GetBuffer();
+    void GraphicsCommandBuffer::BindMeshBuffers(const IVertexBasedRenderer &mesh) {
+        constexpr size_t MAX_BINDINGS = IVertexBasedRenderer::MAX_VERTEX_BUFFER_BINDINGS;
+        IVertexBasedRenderer::VertexBufferBindings bindings;
+        mesh.FillVertexAttributeBufferBindings(bindings);
+        InlineVector<vk::Buffer, MAX_BINDINGS> buffers;
+        InlineVector<vk::DeviceSize, MAX_BINDINGS> offsets;
+        for (const auto &binding : bindings) {
+            buffers.push_back(binding.buffer->GetBuffer());
+            offsets.push_back(binding.offset);
         }
+        DrawRecording::BindVertexBuffers(cb, m_bound_state, buffers, offsets);
 
-        cb.bindVertexBuffers(0, buffers, offsets);
         auto indices = mesh.GetIndexBufferBinding();
-        cb.bindIndexBuffer(indices.buffer->GetBuffer(), indices.offset, vk::IndexType::eUint32);
+        DrawRecording::BindIndexBuffer(cb, m_bound_state, indices.buffer->GetBuffer(), indices.offset);
+    }
 
-        struct {
-            glm::mat4 m;
-            int32_t i;
-        } push_constants{.m = model_matrix, .i = camera_index};
+    void GraphicsCommandBuffer::BindPacketBuffers(const RenderSystemState::DrawPacket &packet) {
+        DrawRecording::BindPacketBuffers(cb, m_bound_state, packet);
+    }
 
-        cb.pushConstants(
-            m_bound_material_pipeline.value().second,
-            vk::ShaderStageFlagBits::eAllGraphics,
-            0,
-            sizeof(push_constants),
-            reinterpret_cast<const void *>(&push_constants)
+    void GraphicsCommandBuffer::PushRendererData(const glm::mat4 &model_matrix, int32_t camera_index) {
+        DrawRecording::PushRendererData(cb, m_bound_state, model_matrix, camera_index);
+    }
+
+    void GraphicsCommandBuffer::DrawMesh(
+        const IVertexBasedRenderer &mesh, const glm::mat4 &model_matrix, int32_t camera_index
+    ) {
+        BindMeshBuffers(mesh);
+        PushRendererData(model_matrix, camera_index);
+        cb.drawIndexed(mesh.GetIndexCount(), 1, mesh.GetFirstIndex(), mesh.GetVertexOffset(), 0);
+    }
+
+    void GraphicsCommandBuffer::DrawMeshInstanced(
+        const IVertexBasedRenderer &mesh, uint32_t first_instance, uint32_t instance_count, int32_t camera_index
+    ) {
+        // Instance zero takes its model matrix from the push constants.
+        assert(first_instance > 0);
+        BindMeshBuffers(mesh);
+        PushRendererData(glm::mat4{1.0f}, camera_index);
+        cb.drawIndexed(
+            mesh.GetIndexCount(), instance_count, mesh.GetFirstIndex(), mesh.GetVertexOffset(), first_instance
         );
-        cb.drawIndexed(mesh.GetIndexCount(), 1, 0, 0, 0);
+    }
+
+    void GraphicsCommandBuffer::DrawIndirectBatch(const RenderSystemState::DrawPacket &batch, int32_t camera_index) {
+        using IndirectDrawCommand = RenderSystemState::RendererManager::IndirectDrawCommand;
+        static_assert(sizeof(IndirectDrawCommand) == sizeof(vk::DrawIndexedIndirectCommand));
+
+        auto &renderer_manager = m_system.GetRendererManager();
+        uint32_t count = static_cast<uint32_t>(m_indirect_commands.size());
+        BindPacketBuffers(batch);
+        PushRendererData(glm::mat4{1.0f}, camera_index);
+
+        uint32_t first =
+            renderer_manager.WriteIndirectCommands(m_inflight_frame_index, m_indirect_commands.data(), count);
+        if (first == RenderSystemState::RendererManager::INVALID_INDIRECT_COMMAND) {
+            // The indirect command buffer is full, record the commands directly.
+            for (const auto &command : m_indirect_commands) {
+                cb.drawIndexed(
+                    command.index_count,
+                    command.instance_count,
+                    command.first_index,
+                    command.vertex_offset,
+                    command.first_instance
+                );
+            }
+        } else {
+            const auto &buffer = renderer_manager.GetIndirectBuffer();
+            vk::DeviceSize offset = buffer.GetSliceOffset(m_inflight_frame_index) + first * sizeof(IndirectDrawCommand);
+            uint32_t max_count = renderer_manager.GetMaxDrawIndirectCount();
+            for (uint32_t submitted = 0; submitted < count; submitted += max_count) {
+                cb.drawIndexedIndirect(
+                    buffer.GetBuffer(),
+                    offset + submitted * sizeof(IndirectDrawCommand),
+                    std::min(max_count, count - submitted),
+                    sizeof(IndirectDrawCommand)
+                );
+            }
+        }
+        m_indirect_commands.clear();
     }
 
     void GraphicsCommandBuffer::DrawRenderers(const std::string &tag, const RendererList &renderers) {
@@ -206,30 +252,86 @@ namespace Engine {
         const std::string &tag, const RendererList &renderers, int32_t camera_index, vk::Extent2D extent
     ) {
         auto &renderer_manager = m_system.GetRendererManager();
-        auto &material_manager = m_system.GetRenderResourceManager<RenderSystemState::MaterialInstanceManager>();
 
         BindSceneResources(m_system.GetSceneDataManager());
         BindCameraResources(m_system.GetCameraManager());
 
         vk::Rect2D scissor{{0, 0}, extent};
         this->SetupViewport(extent.width, extent.height, scissor);
-        for (const auto &rid : renderers) {
-            auto material_handle = renderer_manager.GetMaterialResourceHandle(rid);
-            material_manager.EnsureReady(material_handle);
-            auto *mesh = renderer_manager.GetRenderer(rid);
-            auto *material_instance = material_manager.Resolve(material_handle);
-            if (!mesh || !material_instance) continue;
 
-            const glm::mat4 &model_matrix = renderer_manager.GetModelMatrix(rid);
-
-            auto tpl = material_instance->GetLibrary().FindMaterialTemplate(
-                tag, {{mesh->GetVertexAttributeFormat()}, m_pripr}
+        const uint32_t pass = renderer_manager.GetPassID(tag, m_pripr);
+        const bool use_indirect = renderer_manager.SupportsIndirectDraw();
+        // Packet of the first draw batched in m_indirect_commands, sharing its material and bindings.
+        const RenderSystemState::DrawPacket *batch = nullptr;
+        m_indirect_commands.clear();
+
+        bool instance_data_written = false;
+        size_t run_end = 0;
+        for (size_t i = 0; i < renderers.size(); i = run_end) {
+            run_end = i + 1;
+            const auto *packet = renderer_manager.GetDrawPacket(pass, renderers[i]);
+            if (!packet || !packet->material_template) continue;
+
+            // Renderers of the same submesh and material are adjacent in sorted lists.
+            if (packet->supports_instancing) {
+                while (run_end < renderers.size()) {
+                    const auto *next = renderer_manager.GetDrawPacket(pass, renderers[run_end]);
+                    if (!next || next->geometry_id != packet->geometry_id || next->material_id != packet->material_id) {
+                        break;
+                    }
+                    run_end++;
+                }
+            }
+            uint32_t count = static_cast<uint32_t>(run_end - i);
+
+            uint32_t first_instance = 0;
+            if (packet->supports_instancing && (use_indirect || count > 1)) {
+                first_instance = renderer_manager.WriteInstanceData(m_inflight_frame_index, &renderers[i], count);
+                instance_data_written |= (first_instance != 0);
+            }
+
+            if (use_indirect && first_instance) {
+                if (batch
+                    && (packet->material != batch->material || packet->material_template != batch->material_template
+                        || !packet->HasSameBufferBindings(*batch))) {
+                    DrawIndirectBatch(*batch, camera_index);
+                    batch = nullptr;
+                }
+                if (!batch) {
+                    this->BindMaterial(
+                        *packet->material, *packet->material_template, packet->pipeline, packet->pipeline_layout
+                    );
+                    batch = packet;
+                }
+                m_indirect_commands.push_back(
+                    {packet->index_count, count, packet->first_index, packet->vertex_offset, first_instance}
+                );
+                continue;
+            }
+
+            if (batch) {
+                DrawIndirectBatch(*batch, camera_index);
+                batch = nullptr;
+            }
+            this->BindMaterial(
+                *packet->material, *packet->material_template, packet->pipeline, packet->pipeline_layout
             );
-            if (!tpl) continue;
-
-            this->BindMaterial(*material_instance, *tpl);
-            this->DrawMesh(*mesh, model_matrix, camera_index);
+            BindPacketBuffers(*packet);
+            if (first_instance) {
+                // Instance zero takes its model matrix from the push constants.
+                PushRendererData(glm::mat4{1.0f}, camera_index);
+                DrawRecording::DrawPacketInstances(cb, *packet, count, first_instance);
+                continue;
+            }
+            // Not instanced, or the instance buffer is full: one draw per renderer.
+            for (size_t j = i; j < run_end; j++) {
+                PushRendererData(renderer_manager.GetModelMatrix(renderers[j]), camera_index);
+                DrawRecording::DrawPacketInstances(cb, *packet, 1, 0);
+            }
         }
+
+        if (batch) DrawIndirectBatch(*batch, camera_index);
+        if (instance_data_written) renderer_manager.FlushInstanceData(m_inflight_frame_index);
     }
 
     void GraphicsCommandBuffer::EndRendering() {
@@ -245,6 +347,14 @@ namespace Engine {
 
     void GraphicsCommandBuffer::Reset() noexcept {
         cb.reset();
-        m_bound_material_pipeline.reset();
+        m_bound_state.Invalidate();
+    }
+
+    void GraphicsCommandBuffer::InvalidateBoundState() noexcept {
+        m_bound_state.Invalidate();
+    }
+
+    BoundStateFilter::Statistics GraphicsCommandBuffer::GetBoundStateStatistics() const noexcept {
+        return m_bound_state.GetStatistics();
     }
 } // namespace Engine
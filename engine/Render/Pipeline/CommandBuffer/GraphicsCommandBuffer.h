@@ -1,6 +1,7 @@
 #ifndef PIPELINE_COMMANDBUFFER_GRAPHICSCOMMANDBUFFER
 #define PIPELINE_COMMANDBUFFER_GRAPHICSCOMMANDBUFFER
 
+#include "Render/Pipeline/CommandBuffer/BoundStateFilter.h"
 #include "Render/Pipeline/CommandBuffer/TransferCommandBuffer.h"
 #include "Render/Pipeline/PipelineRuntimeInfo.h"
 #include "Render/RenderSystem/RendererManager.h"
@@ -25,6 +26,7 @@ namespace Engine {
     namespace RenderSystemState {
         class SceneDataManager;
         class CameraManager;
+        struct DrawPacket;
     }; // namespace RenderSystemState
 
     namespace AttachmentUtils {
@@ -41,6 +43,10 @@ namespace Engine {
      * only allowed outside a rendering pass. You need to call `EndRendering()` and
 
      * * setup proper barriers with the context before recording these commands.
+     *
+     * Draw recording does not allocate, and state changes identical to the bound
+     * state are skipped, see `DrawRecording`. Call `InvalidateBoundState()` after
+     * recording commands to the underlying `vk::CommandBuffer` directly.
      */
     class GraphicsCommandBuffer : public TransferCommandBuffer {
     public:
@@ -131,9 +137,31 @@ namespace Engine {
         void DrawMesh(const IVertexBasedRenderer &mesh, const glm::mat4 &model_matrix);
         void DrawMesh(const IVertexBasedRenderer &mesh);
 
+        /**
+         * @brief Draw several instances of a mesh in one draw call.
+         *
+         * The model matrices of the instances are read from the instance buffer
+         * of the RendererManager, starting at `first_instance`, which must be
+         * non-zero. The bound material must support instancing.
+         */
+        void DrawMeshInstanced(
+            const IVertexBasedRenderer &mesh, uint32_t first_instance, uint32_t instance_count, int32_t camera_index
+        );
+
         /**
          * @brief Draw renderers in the RendererList with specified pass index.
          *
+         * Draws are recorded from the draw packets cached by the RendererManager
+         * for the tag and the current attachment formats, see `GetPassID()`.
+         *
+         * Consecutive renderers drawing the same submesh with the same material
+         * instance are merged into one instanced draw, if the material template
+         * supports instancing. Sort the list by material to make the most of it.
+         *
+         * If the device supports indirect draws, consecutive instanced draws
+         * sharing the material and the vertex and index buffers are further
+         * batched into one `drawIndexedIndirect` call.
+         *
          * The camera index used in rendering is assumed to be the current active camera.
          */
         void DrawRenderers(const std::string &tag, const RendererList &renderers);
@@ -151,13 +179,38 @@ namespace Engine {
         /// @brief Reset the command buffer.
         void Reset() noexcept override;
 
+        /**
+         * @brief Forget the tracked bound state, so that the next state changes are all recorded.
+         *
+         * Call it after binding pipelines, buffers, descriptor sets or push constants
+         * on the command buffer returned by `GetCommandBuffer()`. Beginning a rendering
+         * pass also invalidates the bound state.
+         */
+        void InvalidateBoundState() noexcept;
+
+        /// @brief Get the counts of recorded and skipped state changes.
+        BoundStateFilter::Statistics GetBoundStateStatistics() const noexcept;
+
     protected:
+        void BindMaterial(
+            MaterialInstance &inst, MaterialTemplate &tpl, vk::Pipeline pipeline, vk::PipelineLayout pipeline_layout
+        );
+        void BindMeshBuffers(const IVertexBasedRenderer &mesh);
+        void BindPacketBuffers(const RenderSystemState::DrawPacket &packet);
+        void PushRendererData(const glm::mat4 &model_matrix, int32_t camera_index);
+
+        /// @brief Submit the indirect commands batched in `m_indirect_commands` with the bindings of `batch`,
+        /// and clear them.
+        void DrawIndirectBatch(const RenderSystemState::DrawPacket &batch, int32_t camera_index);
+
         RenderSystem &m_system;
         uint32_t m_inflight_frame_index;
 
-        std::optional<std::pair<vk::Pipeline, vk::PipelineLayout>> m_bound_material_pipeline{};
+        BoundStateFilter m_bound_state{};
 
         PipelineRuntimeInfoPerRendering m_pripr{};
+
+        std::vector<RenderSystemState::RendererManager::IndirectDrawCommand> m_indirect_commands{};
     };
 } // namespace Engine
 
@@ -8,6 +8,7 @@
 #include "Render/Pipeline/Compute/ComputeResourceBinding.h"
 #include "Render/RenderSystem.h"
 #include "Render/RenderSystem/DeviceInterface.h"
+#include "Render/RenderSystem/PipelineCache.h"
 #include <bitset>
 #include <string>
 #include <unordered_map>
@@ -79,8 +80,7 @@ namespace Engine {
                 vk::PipelineShaderStageCreateFlags{}, vk::ShaderStageFlagBits::eCompute, m_passInfo.shader.get(), "main"
             };
             vk::ComputePipelineCreateInfo cpci{vk::PipelineCreateFlags{}, pssci, m_passInfo.pipeline_layout.get()};
-            auto ret = system.GetDevice().createComputePipelineUnique(nullptr, cpci);
-            m_passInfo.pipeline = std::move(ret.value);
+            m_passInfo.pipeline = system.GetPipelineCache().CreateComputePipeline(cpci);
             DEBUG_SET_NAME_TEMPLATE(
                 system.GetDevice(), m_passInfo.pipeline.get(), std::format("Compute Pipeline {}", name)
             );
@@ -37,6 +37,10 @@ namespace Engine {
             std::unordered_map<uint32_t, std::unique_ptr<IndexedBuffer>> ubos{};
 
             std::array<vk::DescriptorSet, BACK_BUFFERS> desc_set_cache{};
+            // Version of the instance each cached descriptor set and its dynamic offsets were built from.
+            // Zero if never built.
+            std::array<uint64_t, BACK_BUFFERS> desc_set_version{};
+            std::array<DynamicOffsets, BACK_BUFFERS> dynamic_offsets{};
 
             std::bitset<8> _is_ubo_dirty{};
         };
@@ -44,6 +48,13 @@ namespace Engine {
         std::unique_ptr<ShaderResourceBinding> p_srb{};
         std::unique_ptr<StructuredBuffer> p_buffer{};
         std::unordered_map<const MaterialTemplate *, PassInfo> m_pass_infos{};
+        // The pass info used last, to skip the lookup when drawing with the same template repeatedly.
+        // Elements of unordered maps are never moved, so the pointer stays valid.
+        const MaterialTemplate *m_last_template{nullptr};
+        PassInfo *m_last_pass_info{nullptr};
+
+        // Bumped on every assignment. Starts from one so that it never matches a set never built.
+        uint64_t m_version{1};
 
         // A small buffer for uniform buffer staging to avoid random write to UBO.
         std::vector<std::byte> m_buffer{};
@@ -54,6 +65,7 @@ namespace Engine {
             owned_resources;
 
         void SetUboDirtyFlags() noexcept {
+            m_version++;
             for (auto &[k, v] : m_pass_infos) {
                 v._is_ubo_dirty.set();
             }
@@ -152,6 +164,7 @@ namespace Engine {
     }
 
     void MaterialInstance::AssignTexture(const std::string &name, std::shared_ptr<Texture> texture) {
+        this->pimpl->m_version++;
         this->pimpl->owned_resources[name] = texture;
         this->pimpl->p_srb->BindTexture(name, *texture);
     }
@@ -159,42 +172,52 @@ namespace Engine {
     void MaterialInstance::AssignTexture(
         const std::string &name, std::shared_ptr<Texture> texture, TextureSubresourceRange range
     ) {
+        this->pimpl->m_version++;
         this->pimpl->owned_resources[name] = texture;
         this->pimpl->p_srb->BindTexture(name, *texture, range);
     }
 
     void MaterialInstance::AssignBuffer(const std::string &name, std::shared_ptr<const DeviceBuffer> buffer) {
+        this->pimpl->m_version++;
         this->pimpl->owned_resources[name] = buffer;
         this->pimpl->p_srb->BindBuffer(name, *buffer);
     }
 
-    std::vector<uint32_t> MaterialInstance::UpdateGPUInfo(MaterialTemplate &tpl, uint32_t backbuffer) {
+    MaterialInstance::DynamicOffsets MaterialInstance::UpdateGPUInfo(MaterialTemplate &tpl, uint32_t backbuffer) {
         assert(backbuffer < impl::PassInfo::BACK_BUFFERS);
 
         if (!tpl.HasMaterialData()) return {};
 
-        auto itr = pimpl->m_pass_infos.find(&tpl);
-        if (itr == pimpl->m_pass_infos.end()) {
-            SDL_LogVerbose(
-                SDL_LOG_CATEGORY_RENDER,
-                "Lazily allocating descriptor and UBOs for material template %p.",
-                static_cast<const void *>(&tpl)
-            );
-            itr = pimpl->CreatePassInfo(m_system, tpl);
-        }
-        auto &pass_info = itr->second;
-
-        // First prepare descriptor writes
-        std::vector<uint32_t> dynamic_offsets;
-        for (const auto &[k, v] : pass_info.ubos) {
-            pimpl->p_srb->BindBuffer(pass_info.ubo_name_lut[k], *v, 0, v->GetSliceSize());
-            // FIXME: Dynamic offset order might not be correct.
-            dynamic_offsets.push_back(v->GetSliceOffset(backbuffer));
+        if (pimpl->m_last_template != &tpl) {
+            auto itr = pimpl->m_pass_infos.find(&tpl);
+            if (itr == pimpl->m_pass_infos.end()) {
+                SDL_LogVerbose(
+                    SDL_LOG_CATEGORY_RENDER,
+                    "Lazily allocating descriptor and UBOs for material template %p.",
+                    static_cast<const void *>(&tpl)
+                );
+                itr = pimpl->CreatePassInfo(m_system, tpl);
+            }
+            pimpl->m_last_template = &tpl;
+            pimpl->m_last_pass_info = &itr->second;
         }
+        auto &pass_info = *pimpl->m_last_pass_info;
 
-        pass_info.desc_set_cache[backbuffer] = pimpl->p_srb->GetDescriptorSet(
-            2, tpl.GetReflectedShaderInfo(), m_system.GetDevice(), tpl.GetDescriptorPool(), true, false
-        );
+        // First prepare descriptor writes, only if something was assigned since the set was last built.
+        if (pass_info.desc_set_version[backbuffer] != pimpl->m_version) {
+            auto &dynamic_offsets = pass_info.dynamic_offsets[backbuffer];
+            dynamic_offsets.clear();
+            for (const auto &[k, v] : pass_info.ubos) {
+                pimpl->p_srb->BindBuffer(pass_info.ubo_name_lut[k], *v, 0, v->GetSliceSize());
+                // FIXME: Dynamic offset order might not be correct.
+                dynamic_offsets.push_back(v->GetSliceOffset(backbuffer));
+            }
+
+            pass_info.desc_set_cache[backbuffer] = pimpl->p_srb->GetDescriptorSet(
+                2, tpl.GetReflectedShaderInfo(), m_system.GetDevice(), tpl.GetDescriptorAllocator(), true, false
+            );
+            pass_info.desc_set_version[backbuffer] = pimpl->m_version;
+        }
 
         // Then do UBO buffer writes
         if (pass_info._is_ubo_dirty[backbuffer]) {
@@ -214,10 +237,10 @@ namespace Engine {
             pass_info._is_ubo_dirty[backbuffer] = false;
         }
 
-        return dynamic_offsets;
+        return pass_info.dynamic_offsets[backbuffer];
     }
 
-    std::vector<uint32_t> MaterialInstance::UpdateGPUInfo(
+    MaterialInstance::DynamicOffsets MaterialInstance::UpdateGPUInfo(
         const std::string &tag, const PipelineRuntimeInfo &pri, uint32_t backbuffer
     ) {
         auto tpl = GetLibrary().FindMaterialTemplate(tag, pri);
@@ -327,4 +350,8 @@ namespace Engine {
     MaterialLibrary &MaterialInstance::GetLibrary() const {
         return *m_system.GetRenderResourceManager<RenderSystemState::MaterialLibraryManager>().Resolve(m_library);
     }
+
+    uint64_t MaterialInstance::GetVersion() const noexcept {
+        return pimpl->m_version;
+    }
 } // namespace Engine
@@ -2,6 +2,7 @@
 #define PIPELINE_MATERIAL_MATERIALINSTANCE
 
 #include "Asset/InstantiatedFromAsset.h"
+#include "Core/InlineVector.h"
 #include "MaterialTemplate.h"
 #include "Render/Memory/DeviceBuffer.h"
 #include "Render/Resource/RenderResourceHandle.h"
@@ -41,6 +42,11 @@ namespace Engine {
         std::unique_ptr<impl> pimpl;
 
     public:
+        /// Maximal count of dynamic uniform buffers of a material, i.e. the guaranteed
+        /// minimum of `maxDescriptorSetUniformBuffersDynamic`.
+        static constexpr size_t MAX_DYNAMIC_OFFSETS = 8;
+        using DynamicOffsets = InlineVector<uint32_t, MAX_DYNAMIC_OFFSETS>;
+
         MaterialInstance(RenderSystem &system, RenderSystemState::MaterialLibraryHandle library);
         virtual ~MaterialInstance();
 
@@ -60,19 +66,20 @@ namespace Engine {
          * @brief Upload current state of this instance to GPU:
          * Performs descriptor writes and UBO buffer writes.
          *
-         * May perform lazy buffer or descriptor allocations.
+         * May perform lazy buffer or descriptor allocations. Descriptor sets and UBOs
+         * of each back buffer are only rebuilt if the instance was modified since they
+         * were last built, see `GetVersion()`.
          *
          * No action will be performed if the template has no per-material data.
          *
-         * @return A vector containing all dynamic uniform buffer offsets.
+         * @return All dynamic uniform buffer offsets, stored inline.
          * Guaranteed to be sorted by binding numbers.
-         * A zero-sized vector will be returned if the template has no
-         * per-material data.
+         * Empty if the template has no per-material data.
          */
-        std::vector<uint32_t> UpdateGPUInfo(MaterialTemplate &tpl, uint32_t backbuffer);
+        DynamicOffsets UpdateGPUInfo(MaterialTemplate &tpl, uint32_t backbuffer);
 
-        /// @overload std::vector<uint32_t> MaterialInstance::UpdateGPUInfo(MaterialTemplate &tpl, uint32_t backbuffer);
-        std::vector<uint32_t> UpdateGPUInfo(
+        /// @overload DynamicOffsets MaterialInstance::UpdateGPUInfo(MaterialTemplate &tpl, uint32_t backbuffer);
+        DynamicOffsets UpdateGPUInfo(
             const std::string &tag, const PipelineRuntimeInfo &pri, uint32_t backbuffer
         );
 
@@ -109,6 +116,12 @@ namespace Engine {
          * @brief Get the material library assigned to this instance.
          */
         MaterialLibrary &GetLibrary() const;
+
+        /**
+         * @brief Get the version of this instance, which is bumped whenever a variable,
+         * texture or buffer is assigned.
+         */
+        uint64_t GetVersion() const noexcept;
     };
 } // namespace Engine
 
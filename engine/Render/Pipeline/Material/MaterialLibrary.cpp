@@ -1,10 +1,12 @@
 #include "MaterialLibrary.h"
 
 #include "Asset/Material/MaterialTemplateAsset.h"
+#include "Core/Jobs/JobSystem.h"
 #include "Render/DebugUtils.h"
 #include "Render/Memory/ShaderParameters/ShaderParameterLayout.h"
 #include "Render/Pipeline/PipelineRuntimeInfo.h"
 #include "Render/Pipeline/PipelineUtils.hpp"
+#include "Render/RenderSystem/PipelineManifest.h"
 
 #include <SDL3/SDL.h>
 #include <cassert>
@@ -13,27 +15,40 @@
 
 namespace Engine {
     struct MaterialLibrary::impl {
-        static constexpr size_t MAX_MATERIAL_DESCRIPTORS_PER_POOL = 128;
-        static constexpr std::array DEFAULT_MATERIAL_DESCRIPTOR_POOL_SIZE{
-            vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, 128},
-            vk::DescriptorPoolSize{vk::DescriptorType::eUniformBufferDynamic, 128},
-            vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, 128},
-            vk::DescriptorPoolSize{vk::DescriptorType::eStorageBufferDynamic, 128},
-            vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, 128}
-        };
-
         struct PipelineAssetItem {
             AssetRef material_template_asset{};
         };
 
+        /**
+         * @brief A material template created by a job.
+         *
+         * The job no longer touches it once its counter is done, so it can only be
+         * destroyed, and its results read, after `counter.IsDone()` returns true.
+         */
+        struct PendingTemplate {
+            JobSystem *job_system{nullptr};
+            JobCounter counter{};
+            /// Written by the job, read only after the counter is done.
+            std::unique_ptr<MaterialTemplate> result{};
+            bool failed{false};
+
+            /// Check whether the job has finished and failed.
+            bool HasFailed() const noexcept {
+                return counter.IsDone() && failed;
+            }
+        };
+
         struct PipelineBundle {
             /// Shader modules for the pipeline.
             std::vector<vk::UniqueShaderModule> shader_modules{};
+            /// Assets of the shader modules, kept loaded by the material template asset.
+            std::vector<const ShaderAsset *> shader_assets{};
             /// Reflected pipeline info.
             ShdrRfl::SPLayout reflected{};
 
-            /// Descriptor pool for material descriptors (could be null if no material descriptor is found).
-            vk::UniqueDescriptorPool descriptor_pool{};
+            /// Allocator of material descriptors (could be null if no material descriptor is found).
+            /// Shared with material instances holding sets allocated from it.
+            std::shared_ptr<DescriptorAllocator> descriptor_allocator{};
             /// Descriptor set layout for material descriptors (could be null if no material descriptor is found).
             vk::DescriptorSetLayout descriptor_set_layout{};
             /// Material pipeline layout.
@@ -44,11 +59,33 @@ namespace Engine {
                 std::unique_ptr<MaterialTemplate>,
                 PipelineUtils::pipeline_runtime_info_hasher>
                 materials{};
+            /// Templates being created, or that failed to be created, by jobs.
+            std::unordered_map<
+                PipelineRuntimeInfo,
+                std::unique_ptr<PendingTemplate>,
+                PipelineUtils::pipeline_runtime_info_hasher>
+                pending{};
         };
 
         std::unordered_map<std::string, PipelineBundle> pipeline_table{};
         std::unordered_map<std::string, PipelineAssetItem> pipeline_asset_table{};
 
+        // Bumped whenever material templates are destroyed.
+        uint32_t generation{0};
+
+        // Tag of the templates drawn with while others are pending.
+        std::string fallback_tag{};
+
+        // GUID of the asset, recorded in the pipeline manifest.
+        GUID asset_guid{};
+
+        void OnTemplateCreated(
+            RenderSystem &system, const std::string &tag, const PipelineRuntimeInfo &pri, MaterialTemplate *tpl
+        ) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "Created material %p.", static_cast<void *>(tpl));
+            system.GetPipelineManifest().Record(asset_guid, tag, pri);
+        }
+
         MaterialTemplate &GetPipelineOrCreate(
             RenderSystem &system, const std::string &tag, const PipelineRuntimeInfo &pri
         ) {
@@ -65,11 +102,14 @@ namespace Engine {
 
             b.shader_modules.clear();
             b.shader_modules.resize(shader_refs.size());
+            b.shader_assets.clear();
+            b.shader_assets.resize(shader_refs.size());
 
             for (size_t i = 0; i < shader_refs.size(); i++) {
                 assert(shader_refs[i].IsValid() && "Invalid shader asset.");
 
                 auto shader_asset = shader_refs[i].as<ShaderAsset>();
+                b.shader_assets[i] = shader_asset;
                 auto code = shader_asset->binary;
                 b.reflected.Merge(Engine::ShdrRfl::SPLayout::Reflect(code, true));
                 vk::ShaderModuleCreateInfo ci{
@@ -89,8 +129,8 @@ namespace Engine {
          */
         void GenerateDescriptorSetAndPipelineLayout(
             PipelineBundle &b,
+            RenderSystem &system,
             RenderSystemState::ImmutableResourceCache &irc,
-            vk::Device d,
             vk::DescriptorSetLayout scene_descriptors,
             vk::DescriptorSetLayout camera_descriptors,
             const std::string &name
@@ -122,14 +162,10 @@ namespace Engine {
                 vk::PipelineLayoutCreateInfo plci{{}, set_layouts, push_constants};
                 b.pipeline_layout = irc.GetPipelineLayout(plci);
 
-                // Also create a descriptor pool
-                auto dpci = vk::DescriptorPoolCreateInfo{
-                    vk::DescriptorPoolCreateFlags{},
-                    MAX_MATERIAL_DESCRIPTORS_PER_POOL,
-                    DEFAULT_MATERIAL_DESCRIPTOR_POOL_SIZE
-                };
-                b.descriptor_pool = d.createDescriptorPoolUnique(dpci);
-                DEBUG_SET_NAME_TEMPLATE(d, b.descriptor_pool.get(), std::format("Descriptor Pool - Material {}", name));
+                // Also create a descriptor allocator, with pools sized for the layout
+                b.descriptor_allocator = std::make_shared<DescriptorAllocator>(
+                    system, b.descriptor_set_layout, desc_bindings, std::format("Material {}", name)
+                );
             } else {
                 SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Material %s pipeline has no material descriptors.", name.c_str());
 
@@ -143,29 +179,38 @@ namespace Engine {
         }
 
         /**
-         * @brief Create a pipeline, assuming that the asset corresponding to
-         * both the tag and the runtime information.
+         * @brief Compile the shaders and create the layouts of the pipelines of a tag
+         * if not done yet, assuming that the asset corresponding to the tag exists.
          */
-        void CreatePipeline(RenderSystem &system, const std::string &tag, const PipelineRuntimeInfo &pri) {
+        PipelineBundle &PrepareBundle(RenderSystem &system, const std::string &tag, MaterialTemplateAsset *&asset) {
             auto itr = pipeline_asset_table.find(tag);
             assert(itr != pipeline_asset_table.end() && "Pipeline tag not found.");
             assert(itr->second.material_template_asset.IsValid() && "Invalid material template asset.");
 
-            auto asset = itr->second.material_template_asset.as<MaterialTemplateAsset>();
+            asset = itr->second.material_template_asset.as<MaterialTemplateAsset>();
 
-            if (pipeline_table[tag].shader_modules.empty()) {
-                CompileShaderModules(pipeline_table[tag], system.GetDevice(), asset->properties.shaders.shaders);
+            auto &b = pipeline_table[tag];
+            if (b.shader_modules.empty()) {
+                CompileShaderModules(b, system.GetDevice(), asset->properties.shaders.shaders);
                 GenerateDescriptorSetAndPipelineLayout(
-                    pipeline_table[tag],
+                    b,
+                    system,
                     system.GetIRCache(),
-                    system.GetDevice(),
                     system.GetSceneDataManager().GetLightDescriptorSetLayout(),
                     system.GetCameraManager().GetDescriptorSetLayout(),
                     asset->name
                 );
             }
+            return b;
+        }
 
-            const auto &b = pipeline_table[tag];
+        /**
+         * @brief Create a material template from a prepared bundle.
+         * Does not touch the asset manager, and can be called on worker threads.
+         */
+        static std::unique_ptr<MaterialTemplate> CreateTemplate(
+            RenderSystem &system, const PipelineBundle &b, MaterialTemplateAsset &asset, const PipelineRuntimeInfo &pri
+        ) {
             std::vector<vk::ShaderModule> shader_modules;
             std::transform(
                 b.shader_modules.begin(),
@@ -173,41 +218,107 @@ namespace Engine {
                 std::back_inserter(shader_modules),
                 [](const vk::UniqueShaderModule &usm) { return usm.get(); }
             );
-            if (b.descriptor_pool) {
-                pipeline_table[tag].materials[pri] = std::make_unique<MaterialTemplate>(
-                    system,
-                    asset->properties,
-                    shader_modules,
-                    b.pipeline_layout,
-                    b.descriptor_pool.get(),
-                    b.reflected,
-                    pri,
-                    asset->name
-                );
-            } else {
-                pipeline_table[tag].materials[pri] = std::make_unique<MaterialTemplate>(
-                    system, asset->properties, shader_modules, b.pipeline_layout, nullptr, b.reflected, pri, asset->name
+            return std::make_unique<MaterialTemplate>(
+                system,
+                asset.properties,
+                shader_modules,
+                b.shader_assets,
+                b.pipeline_layout,
+                b.descriptor_allocator,
+                b.reflected,
+                pri,
+                asset.name
+            );
+        }
+
+        /**
+         * @brief Create a pipeline, assuming that the asset corresponding to
+         * both the tag and the runtime information.
+         */
+        void CreatePipeline(RenderSystem &system, const std::string &tag, const PipelineRuntimeInfo &pri) {
+            MaterialTemplateAsset *asset{nullptr};
+            auto &b = PrepareBundle(system, tag, asset);
+            b.materials[pri] = CreateTemplate(system, b, *asset, pri);
+            OnTemplateCreated(system, tag, pri, b.materials[pri].get());
+        }
+
+        /**
+         * @brief Create a pipeline in a job. Shaders are compiled on the calling thread
+         * if needed, as the asset manager and the immutable resource cache are not thread-safe.
+         */
+        void SchedulePipeline(
+            RenderSystem &system, JobSystem &job_system, const std::string &tag, const PipelineRuntimeInfo &pri
+        ) {
+            auto &p = *(pipeline_table[tag].pending[pri] = std::make_unique<PendingTemplate>());
+            p.job_system = &job_system;
+
+            MaterialTemplateAsset *asset{nullptr};
+            try {
+                auto &b = PrepareBundle(system, tag, asset);
+                job_system.Schedule(
+                    [&system, &b, &p, asset, pri]() {
+                        try {
+                            p.result = CreateTemplate(system, b, *asset, pri);
+                        } catch (const std::exception &e) {
+                            SDL_LogError(
+                                SDL_LOG_CATEGORY_RENDER, "Cannot create material %s: %s", asset->name.c_str(), e.what()
+                            );
+                            p.failed = true;
+                        }
+                    },
+                    &p.counter
                 );
+            } catch (const std::exception &e) {
+                SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Cannot create pipeline tagged %s: %s", tag.c_str(), e.what());
+                p.failed = true;
             }
+        }
 
-            SDL_LogInfo(
-                SDL_LOG_CATEGORY_RENDER,
-                "Created material %p.",
-                static_cast<void *>(pipeline_table[tag].materials[pri].get())
-            );
+        /**
+         * @brief Move the template created by a finished job into the bundle.
+         * Failed jobs are kept, so that they are not retried.
+         *
+         * @param wait Whether to wait for the job to finish.
+         */
+        void CollectPendingTemplate(
+            RenderSystem &system, const std::string &tag, PipelineBundle &b, const PipelineRuntimeInfo &pri, bool wait
+        ) {
+            auto itr = b.pending.find(pri);
+            if (itr == b.pending.end()) return;
+            auto &p = *itr->second;
+            if (wait) p.job_system->Wait(p.counter);
+            // Erasing the entry destroys the counter, which is only safe once it is done.
+            if (!p.counter.IsDone() || p.failed) return;
+
+            b.materials[pri] = std::move(p.result);
+            b.pending.erase(itr);
+            OnTemplateCreated(system, tag, pri, b.materials[pri].get());
+        }
+
+        /// @brief Wait for all jobs, which reference bundles and assets.
+        void WaitPendingTemplates() {
+            for (auto &[tag, bundle] : pipeline_table) {
+                for (auto &[pri, p] : bundle.pending) {
+                    p->job_system->Wait(p->counter);
+                }
+            }
         }
     };
 
     MaterialLibrary::MaterialLibrary(RenderSystem &s) : m_system(s), pimpl(std::make_unique<impl>()) {
     }
     MaterialLibrary::~MaterialLibrary() {
+        pimpl->WaitPendingTemplates();
     }
     const MaterialTemplate *MaterialLibrary::FindMaterialTemplate(
         const std::string &tag, const PipelineRuntimeInfo &pri
     ) const noexcept {
         auto itr = pimpl->pipeline_table.find(tag);
-        if (itr != pimpl->pipeline_table.end() && itr->second.materials[pri]) {
-            return itr->second.materials[pri].get();
+        if (itr != pimpl->pipeline_table.end()) {
+            pimpl->CollectPendingTemplate(m_system, tag, itr->second, pri, true);
+            if (itr->second.materials[pri]) return itr->second.materials[pri].get();
+            // A job failed to create it.
+            if (itr->second.pending.contains(pri)) return nullptr;
         }
         if (itr == pimpl->pipeline_table.end()) {
             auto inserted = pimpl->pipeline_table.insert({tag, impl::PipelineBundle{}});
@@ -231,8 +342,85 @@ namespace Engine {
         return const_cast<MaterialTemplate *>(std::as_const(*this).FindMaterialTemplate(tag, pri));
     }
 
+    MaterialLibrary::TemplateRequest MaterialLibrary::RequestMaterialTemplate(
+        const std::string &tag, const PipelineRuntimeInfo &pri
+    ) noexcept {
+        auto job_system = m_system.GetJobSystem();
+        if (!job_system) {
+            auto tpl = FindMaterialTemplate(tag, pri);
+            return {tpl ? TemplateStatus::Ready : TemplateStatus::Missing, tpl};
+        }
+
+        if (!pimpl->pipeline_asset_table.contains(tag)) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Cannot find pipeline tagged %s", tag.c_str());
+            return {TemplateStatus::Missing, nullptr};
+        }
+
+        auto &bundle = pimpl->pipeline_table[tag];
+        pimpl->CollectPendingTemplate(m_system, tag, bundle, pri, false);
+        if (auto &tpl = bundle.materials[pri]) return {TemplateStatus::Ready, tpl.get()};
+
+        auto itr = bundle.pending.find(pri);
+        if (itr == bundle.pending.end()) {
+            pimpl->SchedulePipeline(m_system, *job_system, tag, pri);
+            itr = bundle.pending.find(pri);
+        }
+        if (itr->second->HasFailed()) return {TemplateStatus::Missing, nullptr};
+
+        MaterialTemplate *fallback{nullptr};
+        if (!pimpl->fallback_tag.empty() && pimpl->fallback_tag != tag) {
+            fallback = FindMaterialTemplate(pimpl->fallback_tag, pri);
+        }
+        return {TemplateStatus::Pending, fallback};
+    }
+
+    bool MaterialLibrary::PreheatMaterialTemplate(const std::string &tag, const PipelineRuntimeInfo &pri) noexcept {
+        auto job_system = m_system.GetJobSystem();
+        if (!job_system) return FindMaterialTemplate(tag, pri) != nullptr;
+
+        if (!pimpl->pipeline_asset_table.contains(tag)) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Cannot find pipeline tagged %s", tag.c_str());
+            return false;
+        }
+
+        auto &bundle = pimpl->pipeline_table[tag];
+        if (!bundle.materials[pri] && !bundle.pending.contains(pri)) {
+            pimpl->SchedulePipeline(m_system, *job_system, tag, pri);
+        }
+        return true;
+    }
+
+    void MaterialLibrary::SetFallbackTag(const std::string &tag) {
+        pimpl->fallback_tag = tag;
+    }
+
+    const std::string &MaterialLibrary::GetFallbackTag() const noexcept {
+        return pimpl->fallback_tag;
+    }
+
+    uint32_t MaterialLibrary::GetGeneration() const noexcept {
+        return pimpl->generation;
+    }
+
+    DescriptorAllocator::Statistics MaterialLibrary::GetDescriptorStatistics() const noexcept {
+        DescriptorAllocator::Statistics total{};
+        for (const auto &[tag, bundle] : pimpl->pipeline_table) {
+            if (!bundle.descriptor_allocator) continue;
+            auto stats = bundle.descriptor_allocator->GetStatistics();
+            total.pool_count += stats.pool_count;
+            total.capacity += stats.capacity;
+            total.allocated += stats.allocated;
+            total.live += stats.live;
+            total.freed += stats.freed;
+        }
+        return total;
+    }
+
     void MaterialLibrary::Instantiate(MaterialLibraryAsset &asset) {
+        pimpl->WaitPendingTemplates();
         pimpl->pipeline_table.clear();
+        pimpl->generation++;
+        pimpl->asset_guid = asset.GetGUID();
         for (auto &[tag, bundle] : asset.material_bundle) {
             pimpl->pipeline_asset_table[tag] =
                 impl::PipelineAssetItem{.material_template_asset = bundle.material_template};
@@ -5,6 +5,7 @@
 
 #include "Asset/InstantiatedFromAsset.h"
 #include "Asset/Material/MaterialLibraryAsset.h"
+#include "Render/Memory/DescriptorAllocator.h"
 #include "Render/Pipeline/PipelineRuntimeInfo.h"
 #include "Render/Renderer/VertexAttribute.h"
 
@@ -30,6 +31,22 @@ namespace Engine {
         std::unique_ptr<impl> pimpl;
 
     public:
+        enum class TemplateStatus {
+            /// The template is created.
+            Ready,
+            /// The template is being created in the background.
+            Pending,
+            /// The template cannot be created, e.g. the tag is not found.
+            Missing
+        };
+
+        struct TemplateRequest {
+            TemplateStatus status;
+            /// The template if it is ready, the fallback template if it is pending
+            /// and a fallback tag is set, and null otherwise.
+            MaterialTemplate *material_template;
+        };
+
         MaterialLibrary(RenderSystem &system);
         ~MaterialLibrary();
 
@@ -43,6 +60,9 @@ namespace Engine {
          * @note The following tags are reserved:
          *  - `SKYBOX`: reserved for skybox rendering.
          *
+         * The template is created synchronously if needed. If it is being created
+         * in the background, this method waits for it.
+         *
          * @param tag The tag of the material.
          * @param pri Runtime information needed for the pipeline.
          */
@@ -56,11 +76,46 @@ namespace Engine {
         MaterialTemplate *FindMaterialTemplate(const std::string &tag, const PipelineRuntimeInfo &pri) noexcept;
 
         /**
-         * @brief Preheat a certain pipeline.
+         * @brief Search for a material template without blocking on pipeline creation.
          *
-         * @todo unimplemented.
+         * If the template is not created yet, its pipeline is created in a job of the
+         * job system of the render system, and the template is `Pending` until the job
+         * finishes. Shaders are still compiled on the calling thread. Without a job
+         * system, this method behaves like `FindMaterialTemplate()`.
+         */
+        TemplateRequest RequestMaterialTemplate(const std::string &tag, const PipelineRuntimeInfo &pri) noexcept;
+
+        /**
+         * @brief Set the tag of the templates returned by `RequestMaterialTemplate()` in
+         * place of pending ones. The fallback templates are created synchronously.
+         * An empty tag, the default, returns no template for pending ones, so that
+         * their draws are skipped.
+         */
+        void SetFallbackTag(const std::string &tag);
+        const std::string &GetFallbackTag() const noexcept;
+
+        /**
+         * @brief Start creating a material template ahead of its first use.
+         *
+         * With a job system, the template is created in the background like in
+         * `RequestMaterialTemplate()`, and `FindMaterialTemplate()` waits for it.
+         * Otherwise it is created synchronously.
+         *
+         * @return Whether the tag is found.
+         */
+        bool PreheatMaterialTemplate(const std::string &tag, const PipelineRuntimeInfo &pri) noexcept;
+
+        /**
+         * @brief Get the generation of the library, which changes whenever its material
+         * templates are destroyed. Template pointers cached by users are dangling if it changed.
+         */
+        uint32_t GetGeneration() const noexcept;
+
+        /**
+         * @brief Get the usage of the material descriptor allocators of all material
+         * templates of this library, summed up.
          */
-        void PreheatMaterialTemplate(const std::string &tag, const PipelineRuntimeInfo &pri) noexcept;
+        DescriptorAllocator::Statistics GetDescriptorStatistics() const noexcept;
 
         void Instantiate(MaterialLibraryAsset &) override;
     };
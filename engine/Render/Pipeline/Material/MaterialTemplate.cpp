@@ -12,6 +12,7 @@
 #include "Render/Pipeline/PipelineUtils.hpp"
 #include "Render/RenderSystem.h"
 #include "Render/RenderSystem/CameraManager.h"
+#include "Render/RenderSystem/PipelineCache.h"
 #include "Render/RenderSystem/Swapchain.h"
 
 #include "Render/Memory/ShaderParameters/ShaderParameterLayout.h"
@@ -28,9 +29,10 @@ namespace Engine {
             vk::DynamicState::eViewport, vk::DynamicState::eScissor
         };
 
-        vk::DescriptorPool desc_pool{};
+        std::shared_ptr<DescriptorAllocator> desc_allocator{};
         vk::PipelineLayout pipeline_layout{};
         const ShdrRfl::SPLayout *m_layout{};
+        bool m_supports_instancing{false};
 
         vk::UniquePipeline pipeline{};
         std::string m_name{};
@@ -38,11 +40,10 @@ namespace Engine {
         void CreatePipeline(
             RenderSystem &system,
             const std::vector<vk::ShaderModule> shader_modules,
+            const std::vector<const ShaderAsset *> &shader_assets,
             MaterialTemplateSinglePassProperties &prop,
             const PipelineRuntimeInfo &pri
         ) {
-            vk::Device device = system.GetDevice();
-
             // Process shaders.
             vk::SpecializationInfo speci{};
             std::vector<vk::PipelineShaderStageCreateInfo> psscis;
@@ -54,9 +55,9 @@ namespace Engine {
                     prop.shaders.specialization_constants, sme, specialization_constant_buffer
                 );
 
-                psscis.resize(prop.shaders.shaders.size());
-                for (size_t i = 0; i < prop.shaders.shaders.size(); i++) {
-                    auto shader_asset = prop.shaders.shaders[i].as<ShaderAsset>();
+                psscis.resize(shader_assets.size());
+                for (size_t i = 0; i < shader_assets.size(); i++) {
+                    auto shader_asset = shader_assets[i];
                     psscis[i] = vk::PipelineShaderStageCreateInfo{
                         {},
                         PipelineUtils::ToVulkanShaderStageFlagBits(shader_asset->shaderType),
@@ -142,8 +143,7 @@ namespace Engine {
             gpci.subpass = 0;
             gpci.pNext = &prci;
 
-            auto ret = device.createGraphicsPipelineUnique(nullptr, gpci);
-            pipeline = std::move(ret.value);
+            pipeline = system.GetPipelineCache().CreateGraphicsPipeline(gpci);
             SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "Successfully created material %s.", m_name.c_str());
         }
     };
@@ -155,25 +155,27 @@ namespace Engine {
         RenderSystem &system,
         MaterialTemplateSinglePassProperties &properties,
         const std::vector<vk::ShaderModule> &shaders,
+        const std::vector<const ShaderAsset *> &shader_assets,
         vk::PipelineLayout layout,
-        vk::DescriptorPool pool,
+        std::shared_ptr<DescriptorAllocator> allocator,
         const ShdrRfl::SPLayout &reflected,
         const PipelineRuntimeInfo &pri,
         const std::string &name
     ) : MaterialTemplate(system) {
         pimpl->m_name = name;
         SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "Creating pipelines for material %s.", pimpl->m_name.c_str());
-        if (!pimpl->desc_pool) {
+        if (!allocator) {
             SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "This material has no per-material data");
         }
 
-        pimpl->desc_pool = pool;
+        pimpl->desc_allocator = std::move(allocator);
 
         pimpl->pipeline_layout = layout;
         pimpl->m_layout = &reflected;
+        pimpl->m_supports_instancing = properties.supports_instancing;
 
         // Create pipelines
-        pimpl->CreatePipeline(system, shaders, properties, pri);
+        pimpl->CreatePipeline(system, shaders, shader_assets, properties, pri);
     }
 
     MaterialTemplate::~MaterialTemplate() = default;
@@ -185,14 +187,17 @@ namespace Engine {
         return pimpl->pipeline_layout;
     }
 
-    vk::DescriptorPool MaterialTemplate::GetDescriptorPool() const noexcept {
-        return pimpl->desc_pool;
+    const std::shared_ptr<DescriptorAllocator> &MaterialTemplate::GetDescriptorAllocator() const noexcept {
+        return pimpl->desc_allocator;
     }
 
     const ShdrRfl::SPLayout &MaterialTemplate::GetReflectedShaderInfo() const noexcept {
         return *(pimpl->m_layout);
     }
     bool MaterialTemplate::HasMaterialData() const noexcept {
-        return pimpl->desc_pool;
+        return pimpl->desc_allocator != nullptr;
+    }
+    bool MaterialTemplate::SupportsInstancing() const noexcept {
+        return pimpl->m_supports_instancing;
     }
 } // namespace Engine
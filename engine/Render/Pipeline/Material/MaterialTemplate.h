@@ -1,6 +1,7 @@
 #ifndef PIPELINE_MATERIAL_MATERIALTEMPLATE_INCLUDED
 #define PIPELINE_MATERIAL_MATERIALTEMPLATE_INCLUDED
 
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <variant>
@@ -18,12 +19,14 @@ namespace vk {
 } // namespace vk
 
 namespace Engine {
+    class DescriptorAllocator;
     class MaterialInstance;
     class Pipeline;
     class PipelineLayout;
     class MaterialTemplateAsset;
     class MaterialTemplateProperties;
     class MaterialTemplateSinglePassProperties;
+    class ShaderAsset;
     class PipelineRuntimeInfo;
 
     namespace PipelineInfo {
@@ -52,7 +55,8 @@ namespace Engine {
      * 2. *Set index 1* stores per-view or per-camera uniforms, such as view
      * and projection matrices;
      * 3. *Set index 2* stores per-material uniforms, such as diffuse textures.
-     * 4. Model matrices are pushed to shader via *push constants*.
+     * 4. Model matrices are pushed to shader via *push constants*, or read
+     * from the instance buffer in set index 1 for instanced draws.
      *
      * The only descriptor set that can be changed freely is therefore set
      * index 2.
@@ -94,6 +98,16 @@ namespace Engine {
      * currently supported. Arrays are not supported.
      * 3. For other variables (i.e. opaque types), only combined image samplers
      * are currently supported. Arrays are not supported either.
+     *
+     * @subsection instancing Instanced Draws
+     *
+     * `GraphicsCommandBuffer::DrawRenderers` merges adjacent renderers drawing
+     * the same submesh with the same material instance into one instanced draw
+     * if `MaterialTemplateSinglePassProperties::supports_instancing` is set.
+     * Vertex shaders of such materials must read the model matrix with
+     * `ENGINE_MODEL_MATRIX` defined in "engine/interface.glsl" instead of
+     * `pc.model`. Non-instanced draws have an instance index of zero, for which
+     * `ENGINE_MODEL_MATRIX` falls back to the push constant.
      */
     class MaterialTemplate : protected std::enable_shared_from_this<MaterialTemplate> {
     public:
@@ -110,13 +124,19 @@ namespace Engine {
     public:
         /**
          * @brief Construct a new Material Template object.
+         *
+         * No asset is loaded or acquired, so that templates can be constructed on
+         * worker threads.
+         *
+         * @param shader_assets The loaded assets `shaders` are compiled from, in the same order.
          */
         MaterialTemplate(
             RenderSystem &system,
             MaterialTemplateSinglePassProperties &properties,
             const std::vector<vk::ShaderModule> &shaders,
+            const std::vector<const ShaderAsset *> &shader_assets,
             vk::PipelineLayout layout,
-            vk::DescriptorPool pool,
+            std::shared_ptr<DescriptorAllocator> allocator,
             const ShdrRfl::SPLayout &reflected,
             const PipelineRuntimeInfo &attribute,
             const std::string &name = ""
@@ -141,11 +161,12 @@ namespace Engine {
         vk::PipelineLayout GetPipelineLayout() const noexcept;
 
         /**
-         * @brief Get the descriptor pool for this material.
+         * @brief Get the allocator of material descriptor sets, shared by all
+         * templates of the same material.
          *
-         * @return vk::DescriptorPool can be null if no material descriptor presents.
+         * @return Null if no material descriptor presents.
          */
-        vk::DescriptorPool GetDescriptorPool() const noexcept;
+        const std::shared_ptr<DescriptorAllocator> &GetDescriptorAllocator() const noexcept;
 
         /**
          * @brief Get all reflected shader info.
@@ -157,6 +178,11 @@ namespace Engine {
          * to GPU before draws.
          */
         bool HasMaterialData() const noexcept;
+
+        /**
+         * @brief Query whether draws of this material template can be instanced.
+         */
+        bool SupportsInstancing() const noexcept;
     };
 } // namespace Engine
 
@@ -7,6 +7,8 @@
 #include <Render/Memory/RenderTargetTexture.h>
 #include <Render/Pipeline/Compute/ComputeResourceBinding.h>
 #include <Render/RenderSystem.h>
+#include <Render/RenderSystem/CameraManager.h>
+#include <Render/RenderSystem/RendererManager.h>
 #include <Render/RenderSystem/SceneDataManager.h>
 #include <Render/Renderer/Camera.h>
 #include <UserInterface/GUISystem.h>
@@ -85,8 +87,15 @@ namespace Engine {
                     "Shadowmap Pass"
                 );
                 gcb.SetupViewport(shadow_map_extent.width, shadow_map_extent.height, shadow_map_scissor);
+                RenderSystemState::RendererManager::FilterCriteria criteria{};
+                criteria.frustum = Frustum{system.GetSceneDataManager().GetLightMatrix(i)};
                 gcb.DrawRenderers(
-                    "Shadowmap", system.GetRendererManager().FilterAndSortRenderers({}), 0, shadow_map_extent
+                    "Shadowmap",
+                    system.GetRendererManager().FilterAndSortRenderers(
+                        criteria, RenderSystemState::RendererManager::SortingCriterion::ByMaterial
+                    ),
+                    0,
+                    shadow_map_extent
                 );
                 gcb.EndRendering();
             }
@@ -114,9 +123,14 @@ namespace Engine {
                     return;
                 }
                 system.GetCameraManager().SetActiveCameraIndex(active_camera->m_display_id);
+                RenderSystemState::RendererManager::FilterCriteria criteria{};
+                criteria.frustum =
+                    Frustum{system.GetCameraManager().GetProjectionViewMatrix(active_camera->m_display_id)};
                 gcb.DrawRenderers(
                     "Lit",
-                    system.GetRendererManager().FilterAndSortRenderers({}),
+                    system.GetRendererManager().FilterAndSortRenderers(
+                        criteria, RenderSystemState::RendererManager::SortingCriterion::ByMaterial
+                    ),
                     system.GetCameraManager().GetActiveCameraIndex(),
                     extent
                 );
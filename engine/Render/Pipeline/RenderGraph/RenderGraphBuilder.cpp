@@ -2,6 +2,9 @@
 
 #include "Render/Pipeline/RenderGraph/RenderGraph.h"
 #include "Render/Pipeline/RenderGraph/RenderGraphUtils.hpp"
+#include "Render/RenderSystem.h"
+#include "Render/RenderSystem/CameraManager.h"
+#include "Render/RenderSystem/RendererManager.h"
 #include "UserInterface/GUISystem.h"
 #include <SDL3/SDL.h>
 #include <unordered_map>
@@ -453,7 +456,16 @@ namespace Engine {
              AttachmentUtils::StoreOperation::DontCare,
              AttachmentUtils::DepthClearValue{1.0f, 0U}},
             [this](Engine::GraphicsCommandBuffer &gcb, const RenderGraph &) {
-                gcb.DrawRenderers("Lit", this->m_system.GetRendererManager().FilterAndSortRenderers({}));
+                auto &camera_manager = this->m_system.GetCameraManager();
+                RenderSystemState::RendererManager::FilterCriteria criteria{};
+                criteria.frustum =
+                    Frustum{camera_manager.GetProjectionViewMatrix(camera_manager.GetActiveCameraIndex())};
+                gcb.DrawRenderers(
+                    "Lit",
+                    this->m_system.GetRendererManager().FilterAndSortRenderers(
+                        criteria, RenderSystemState::RendererManager::SortingCriterion::ByMaterial
+                    )
+                );
             }
         );
 
@@ -89,6 +89,14 @@ namespace Engine {
         return nullptr;
     }
 
+    uint64_t RenderGraph2::GetTransientMemorySize() const noexcept {
+        return pimpl->extra_info.transient_memory_size;
+    }
+
+    uint64_t RenderGraph2::GetAliasedMemorySize() const noexcept {
+        return pimpl->extra_info.aliased_memory_size;
+    }
+
     const PipelineRuntimeInfoPerRendering &RenderGraph2::GetCurrentPassRuntimeInfo() const noexcept {
         assert(pimpl->pripr_ptr);
         return *pimpl->pripr_ptr;
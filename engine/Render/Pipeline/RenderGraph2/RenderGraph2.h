@@ -59,6 +59,22 @@ namespace Engine {
          */
         RenderTargetTexture *GetInternalTextureResource(RGTextureHandle handle) const noexcept;
 
+        /**
+         * @brief Get the size of memory shared by aliased transient render
+         * target textures, in bytes.
+         *
+         * Transient textures whose lifetimes do not overlap are placed in the
+         * same memory. Resizable and unused textures are not aliased, and are
+         * not counted.
+         */
+        uint64_t GetTransientMemorySize() const noexcept;
+
+        /**
+         * @brief Get the size of memory saved by aliasing transient render
+         * target textures, in bytes.
+         */
+        uint64_t GetAliasedMemorySize() const noexcept;
+
         /**
          * @brief Request the graphics pipeline runtime information of the
          * current pass or subpass.
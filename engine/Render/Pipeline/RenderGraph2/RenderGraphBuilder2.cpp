@@ -1,16 +1,25 @@
 #include "RenderGraphBuilder2.h"
 
 #include <SDL3/SDL.h>
+#include <array>
+#include <bit>
+#include <optional>
 #include <unordered_set>
 
+#include "Render/Hasher.hpp"
 #include "Render/Memory/MemoryAccessHelper.hpp"
 #include "Render/Pipeline/RenderGraph/RGAttachmentDesc.h"
 #include "Render/Pipeline/RenderGraph2/RenderGraph2.h"
 #include "Render/Pipeline/RenderGraph2/RenderGraphPass.h"
 #include "Render/Pipeline/RenderGraph2/RenderGraphStruct.hpp"
+#include "Render/Pipeline/RenderGraph2/TransientMemoryPlanner.h"
+#include "Render/RenderSystem/AllocatorState.h"
 #include "Render/RenderSystem/ResizableRTTManager.h"
 
 namespace {
+    // Compiled graphs are dropped beyond this count, to bound the memory used by graphs no longer built.
+    constexpr size_t MAX_COMPILED_GRAPHS = 16;
+
     constexpr vk::PipelineStageFlagBits2 AffinityToPipelineStage(Engine::RenderGraphPassAffinity affinity) {
         switch (affinity) {
             using enum Engine::RenderGraphPassAffinity;
@@ -86,6 +95,43 @@ namespace {
         }
     };
 
+    /**
+     * @brief Words describing the structure of a render graph.
+     *
+     * Compiled graphs are looked up by the hash of the key, and the key is
+     * compared on a hit, so that a hash collision is not taken for a hit.
+     */
+    struct StructuralKey {
+        std::vector<uint32_t> words{};
+
+        void u32(uint32_t value) {
+            words.push_back(value);
+        }
+
+        template <typename T>
+            requires std::is_enum_v<T>
+        void e(T value) {
+            u32(static_cast<uint32_t>(value));
+        }
+
+        void u64(uint64_t value) {
+            u32(value & 0xffffffffu);
+            u32(value >> 32);
+        }
+
+        void f32(float value) {
+            u32(std::bit_cast<uint32_t>(value));
+        }
+
+        size_t Hash() const noexcept {
+            Engine::RenderResourceHasher hasher{};
+            for (auto w : words) hasher.u32(w);
+            return hasher.get();
+        }
+
+        bool operator==(const StructuralKey &) const = default;
+    };
+
     struct DependencyGraph {
         std::vector<std::unordered_set<uint32_t>> adjacent_list_out{};
         std::vector<std::unordered_set<uint32_t>> adjacent_list_in{};
@@ -154,17 +200,81 @@ namespace Engine {
             std::unordered_map<RGTextureHandle, RenderTargetTextureVariant> texture_mapping;
             std::unordered_map<RGBufferHandle, const DeviceBuffer *> buffer_mapping;
 
+            // Memory placements of transient render target textures sharing memory.
+            struct AliasingInfo {
+                TransientMemoryPlanner::Plan plan{};
+                // Maps aliased textures to their placements in the plan.
+                std::unordered_map<RGTextureHandle, size_t> placement_index{};
+                // Maps placements in the plan back to textures.
+                std::vector<RGTextureHandle> textures{};
+            };
+
+            /**
+             * @brief Plan memory aliasing of transient render target textures,
+             * by their lifetimes in the reordered pass list.
+             *
+             * Resizable render target textures are owned by the
+             * `ResizableRTTManager`, and unused textures have no lifetime, so
+             * both of them get their own memory.
+             */
+            AliasingInfo PlanTransientMemory(RenderSystem &s, const UsageCache &reordered_usage) const {
+                AliasingInfo ret{};
+                for (const auto &[k, v] : texture_creation_info) {
+                    bool resizable = !(v.scale_x < 0.0f || v.scale_y < 0.0f);
+                    auto itr = reordered_usage.image_usages.find(k);
+                    if (resizable || itr == reordered_usage.image_usages.end() || itr->second.empty()) continue;
+                    ret.textures.push_back(k);
+                }
+                // Sorted so that the plan does not depend on the order of the hash map.
+                std::sort(ret.textures.begin(), ret.textures.end());
+
+                std::vector<TransientMemoryPlanner::Request> requests{};
+                requests.reserve(ret.textures.size());
+                for (auto k : ret.textures) {
+                    const auto &u = reordered_usage.image_usages.at(k);
+                    auto mreq = RenderTargetTexture::QueryMemoryRequirements(s, texture_creation_info.at(k).t);
+                    ret.placement_index[k] = requests.size();
+                    requests.push_back(
+                        TransientMemoryPlanner::Request{
+                            mreq.size, mreq.alignment, mreq.memoryTypeBits, u.front().first, u.back().first
+                        }
+                    );
+                }
+                ret.plan = TransientMemoryPlanner::MakePlan(requests);
+                return ret;
+            }
+
             /**
              * @brief Materialize render target textures from the
              * `texture_creation_info`.
+             *
+             * Memory blocks of aliased textures are allocated into `memory`,
+             * which must outlive the textures.
              */
             std::unordered_map<RGTextureHandle, OwnedRenderTargetTextureVariant> MaterializeRenderTargetTextures(
-                RenderSystem &s
+                RenderSystem &s, const AliasingInfo &aliasing, std::vector<MemoryBlockAllocation> &memory
             ) const {
+                memory.clear();
+                memory.reserve(aliasing.plan.blocks.size());
+                for (size_t i = 0; i < aliasing.plan.blocks.size(); i++) {
+                    const auto &b = aliasing.plan.blocks[i];
+                    memory.push_back(
+                        s.GetAllocatorState().AllocateMemoryBlock(
+                            vk::MemoryRequirements{b.size, b.alignment, b.memory_type_bits},
+                            std::format("Transient memory block {}", i)
+                        )
+                    );
+                }
+
                 std::unordered_map<RGTextureHandle, OwnedRenderTargetTextureVariant> ret{};
                 for (const auto &[k, v] : texture_creation_info) {
-
-                    if (v.scale_x < 0.0f || v.scale_y < 0.0f) {
+                    auto itr = aliasing.placement_index.find(k);
+                    if (itr != aliasing.placement_index.end()) {
+                        const auto &placement = aliasing.plan.placements[itr->second];
+                        ret[k] = RenderTargetTexture::CreateUniqueAliased(
+                            s, v.t, v.s, memory[placement.block], placement.offset, v.name
+                        );
+                    } else if (v.scale_x < 0.0f || v.scale_y < 0.0f) {
                         ret[k] = RenderTargetTexture::CreateUnique(s, v.t, v.s, v.name);
                     } else {
                         ret[k] = s.GetResizableRTTManager().RequestRTT(v.t, v.s, v.scale_x, v.scale_y, v.name);
@@ -301,6 +411,151 @@ namespace Engine {
 
             return ret;
         }
+
+        /**
+         * @brief A render graph compiled from passes and resource
+         * declarations, without materialized resources and pass functions.
+         */
+        struct CompiledGraph {
+            // Compiled passes with empty pass functions.
+            std::vector<RenderGraphCompiledPass> passes{};
+            // Original indices of the passes merged into each compiled pass.
+            std::vector<std::vector<uint32_t>> subpass_sources{};
+            // Maps reordered pass indices to original pass indices.
+            std::vector<uint32_t> pass_order{};
+            // Usages by reordered pass indices.
+            UsageCache reordered_usage{};
+            // Locations (pass, subpass, barrier) of barriers on first uses of
+            // transient textures, which wait for textures aliasing them.
+            std::vector<std::array<size_t, 3>> first_use_barriers{};
+            std::unordered_map<RGTextureHandle, MemoryAccessTypeImageBits> first_persistent_texture_access,
+                last_persistent_texture_access;
+
+            // The topology the graph is compiled from.
+            StructuralKey topology{};
+            // Memory aliasing, planned for the extents in `extent`.
+            std::optional<StructuralKey> extent{};
+            ResourceStorage::AliasingInfo aliasing{};
+        };
+
+        // Compiled graphs keyed by hashes of their topologies.
+        std::unordered_map<size_t, CompiledGraph> compiled_graphs{};
+
+        BuildStatistics statistics{};
+
+        /**
+         * @brief Describe the structure of the render graph.
+         *
+         * @return The topology key, covering passes, accesses and formats of
+         * resources that decide how the graph is compiled, and the extent
+         * key, covering extents of transient textures that only decide how
+         * their memory is aliased. Extents of resizable textures are decided
+         * by the `ResizableRTTManager`, and are in neither.
+         */
+        std::pair<StructuralKey, StructuralKey> ComputeStructuralKeys() const {
+            StructuralKey topology{}, extent{};
+
+            // Hash maps are hashed in the order of handles.
+            std::vector<std::pair<RGTextureHandle, MemoryAccessTypeImageBits>> image_access{};
+            std::vector<std::pair<RGBufferHandle, MemoryAccessTypeBuffer>> buffer_access{};
+            topology.u64(passes.size());
+            for (const auto &p : passes) {
+                topology.e(p.affinity);
+                topology.e(p.actual_type);
+
+                image_access.assign(p.image_access.begin(), p.image_access.end());
+                std::sort(image_access.begin(), image_access.end(), [](const auto &l, const auto &r) {
+                    return l.first < r.first;
+                });
+                topology.u64(image_access.size());
+                for (const auto &[r, a] : image_access) {
+                    topology.e(r);
+                    topology.e(a);
+                }
+
+                buffer_access.assign(p.buffer_access.begin(), p.buffer_access.end());
+                std::sort(buffer_access.begin(), buffer_access.end(), [](const auto &l, const auto &r) {
+                    return l.first < r.first;
+                });
+                topology.u64(buffer_access.size());
+                for (const auto &[r, a] : buffer_access) {
+                    topology.e(r);
+                    topology.u32(a.ToUnderlying());
+                }
+
+                topology.u64(p.color_attachments.size());
+                for (const auto &ca : p.color_attachments) topology.e(ca.rt_handle);
+                topology.e(p.depth_attachment.rt_handle);
+            }
+
+            std::vector<RGTextureHandle> textures{};
+            for (const auto &[k, v] : rs.texture_creation_info) textures.push_back(k);
+            std::sort(textures.begin(), textures.end());
+            for (auto k : textures) {
+                const auto &v = rs.texture_creation_info.at(k);
+                topology.e(k);
+                topology.e(v.t.format);
+                topology.u32(v.t.dimensions);
+                topology.u32(v.t.mipmap_levels);
+                topology.u32(v.t.array_layers);
+                topology.u32(v.t.multisample);
+                topology.u32(v.t.is_cube_map);
+                topology.f32(v.scale_x);
+                topology.f32(v.scale_y);
+                if (v.scale_x < 0.0f || v.scale_y < 0.0f) {
+                    extent.e(k);
+                    extent.u32(v.t.width);
+                    extent.u32(v.t.height);
+                    extent.u32(v.t.depth);
+                }
+            }
+
+            // Only formats of imported textures are used in compilation.
+            textures.clear();
+            for (const auto &[k, v] : rs.texture_mapping) textures.push_back(k);
+            std::sort(textures.begin(), textures.end());
+            for (auto k : textures) {
+                topology.e(k);
+                topology.e(
+                    std::visit(RenderTargetTextureVariantVisitor{}, rs.texture_mapping.at(k))
+                        ->GetTextureDescription()
+                        .format
+                );
+            }
+
+            std::vector<RGBufferHandle> buffers{};
+            for (const auto &[k, v] : rs.buffer_mapping) buffers.push_back(k);
+            std::sort(buffers.begin(), buffers.end());
+            for (auto k : buffers) topology.e(k);
+
+            return std::make_pair(std::move(topology), std::move(extent));
+        }
+
+        /**
+         * @brief Compile the passes, without planning memory aliasing.
+         */
+        CompiledGraph Compile();
+
+        /**
+         * @brief Make the barriers on first uses of transient textures wait
+         * for the last uses of textures previously in the same memory.
+         */
+        void ApplyAliasingBarriers(CompiledGraph &c) const noexcept {
+            for (const auto &[pi, si, bi] : c.first_use_barriers) {
+                auto &[r, b] = c.passes[pi].subpasses[si].image_barriers[bi];
+                b.srcAccessMask = vk::AccessFlagBits2::eNone;
+                b.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+
+                auto itr = c.aliasing.placement_index.find(r);
+                if (itr == c.aliasing.placement_index.end()) continue;
+                for (auto pred : c.aliasing.plan.placements[itr->second].aliased_predecessors) {
+                    const auto &last = c.reordered_usage.image_usages.at(c.aliasing.textures[pred]).back();
+                    b.srcAccessMask |= GetAccessFlags({last.second});
+                    b.srcStageMask |=
+                        GuessPipelineStageFromAccess(passes[c.pass_order[last.first]].actual_type, last.second);
+                }
+            }
+        }
     };
 
     RenderGraphBuilder2::RenderGraphBuilder2(RenderSystem &system) : system(system), pimpl(std::make_unique<impl>()) {
@@ -402,9 +657,10 @@ namespace Engine {
         pimpl->passes.push_back(std::move(pass));
     }
 
-    RenderGraph2 RenderGraphBuilder2::BuildRenderGraph() {
-        auto usage = pimpl->AnalysisUsage();
-        auto dg = pimpl->AnalysisDependency(usage);
+    RenderGraphBuilder2::impl::CompiledGraph RenderGraphBuilder2::impl::Compile() {
+        CompiledGraph c{};
+        auto usage = AnalysisUsage();
+        auto dg = AnalysisDependency(usage);
         // Maps reordered pass indices to original pass indices.
         auto pass_order = dg.TopologicalSort();
         // Remaps original pass indices to reordered pass indices.
@@ -429,28 +685,28 @@ namespace Engine {
             cross_queue_dep; // < all pass indices are reordered.
         auto AnalysisCrossQueueDependency = [&, this](const auto &usages) {
             for (const auto &[r, u] : usages) {
-                auto last_affinity = pimpl->passes[pass_order[u.front().first]].affinity;
+                auto last_affinity = passes[pass_order[u.front().first]].affinity;
                 auto last_affinity_pass = u.front().first;
                 auto rid = static_cast<int32_t>(r);
                 for (const auto &usage : u) {
-                    if (pimpl->passes[pass_order[usage.first]].affinity != last_affinity) {
+                    if (passes[pass_order[usage.first]].affinity != last_affinity) {
                         SDL_LogInfo(
                             SDL_LOG_CATEGORY_RENDER,
                             std::format(
                                 "Found cross-queue dependency from pass {} to "
                                 "{} incurred by resource {}",
-                                pimpl->passes[pass_order[last_affinity_pass]].name,
-                                pimpl->passes[pass_order[usage.first]].name,
+                                passes[pass_order[last_affinity_pass]].name,
+                                passes[pass_order[usage.first]].name,
                                 rid
                             )
                                 .c_str()
                         );
-                        auto new_affinity = pimpl->passes[pass_order[usage.first]].affinity;
+                        auto new_affinity = passes[pass_order[usage.first]].affinity;
 
                         auto src{AffinityToPipelineStage(last_affinity)}, dst{AffinityToPipelineStage(new_affinity)};
                         cross_queue_dep[last_affinity_pass][usage.first] = std::make_pair(src, dst);
 
-                        last_affinity = pimpl->passes[pass_order[usage.first]].affinity;
+                        last_affinity = passes[pass_order[usage.first]].affinity;
                         last_affinity_pass = usage.first;
                     }
                 }
@@ -511,10 +767,11 @@ namespace Engine {
                     .c_str()
             );
 #endif
+            c.subpass_sources.push_back({});
             for (auto subpass_id : merged_passes[i]) {
+                c.subpass_sources.back().push_back(pass_order[subpass_id]);
                 RenderGraphCompiledPass::Subpass subpass;
-                const auto &old_p = pimpl->passes[pass_order[subpass_id]];
-                subpass.pass_work = old_p.pass_function;
+                const auto &old_p = passes[pass_order[subpass_id]];
 #ifndef NDEBUG
                 SDL_LogDebug(
                     SDL_LOG_CATEGORY_RENDER,
@@ -540,11 +797,16 @@ namespace Engine {
                         src_access = vk::AccessFlagBits2::eNone;
                         src_stage = vk::PipelineStageFlagBits2::eNone;
                         src_layout = vk::ImageLayout::eUndefined;
+
+                        // ... which waits for aliased textures, see `ApplyAliasingBarriers()`.
+                        if (static_cast<int32_t>(r) > 0) {
+                            c.first_use_barriers.push_back({i, p[i].subpasses.size(), subpass.image_barriers.size()});
+                        }
                     } else {
                         itr = itr - 1;
                         src_access = GetAccessFlags({itr->second});
                         src_stage = GuessPipelineStageFromAccess(
-                            pimpl->passes[pass_order[itr->first]].actual_type, itr->second
+                            passes[pass_order[itr->first]].actual_type, itr->second
                         );
                         src_layout = GetImageLayout({itr->second});
                     }
@@ -552,18 +814,18 @@ namespace Engine {
                     dst_stage = GuessPipelineStageFromAccess(old_p.actual_type, a);
                     dst_layout = GetImageLayout({a});
                     vk::ImageAspectFlags aspect{};
-                    if (pimpl->rs.texture_creation_info.contains(r)) {
+                    if (rs.texture_creation_info.contains(r)) {
                         aspect = ImageUtils::GetVkAspect(
                             static_cast<ImageUtils::ImageFormat>(
                                 static_cast<std::underlying_type_t<RenderTargetTexture::RTTFormat>>(
-                                    pimpl->rs.texture_creation_info[r].t.format
+                                    rs.texture_creation_info[r].t.format
                                 )
                             )
                         );
                     } else {
-                        assert(pimpl->rs.texture_mapping.contains(r));
+                        assert(rs.texture_mapping.contains(r));
                         aspect = ImageUtils::GetVkAspect(
-                            std::visit(RenderTargetTextureVariantVisitor{}, pimpl->rs.texture_mapping.at(r))
+                            std::visit(RenderTargetTextureVariantVisitor{}, rs.texture_mapping.at(r))
                                 ->GetTextureDescription()
                                 .format
                         );
@@ -576,7 +838,7 @@ namespace Engine {
                             "subpass \"{}\" ({}, {}, {}) "
                             "-> subpass \"{}\" ({}, {}, {})",
                             static_cast<int32_t>(r),
-                            pimpl->passes[pass_order[itr->first]].name,
+                            passes[pass_order[itr->first]].name,
                             vk::to_string(src_stage),
                             vk::to_string(src_access),
                             vk::to_string(src_layout),
@@ -630,7 +892,7 @@ namespace Engine {
                     } else {
                         itr = itr - 1;
                         src_access = GetAccessFlags({itr->second});
-                        src_stage = AffinityToPipelineStage(pimpl->passes[pass_order[itr->first]].actual_type);
+                        src_stage = AffinityToPipelineStage(passes[pass_order[itr->first]].actual_type);
                     }
                     dst_access = GetAccessFlags({a});
                     dst_stage = AffinityToPipelineStage(old_p.actual_type);
@@ -643,7 +905,7 @@ namespace Engine {
                             "subpass \"{}\" ({}, {}) "
                             "-> subpass \"{}\" ({}, {})",
                             static_cast<int32_t>(r),
-                            pimpl->passes[pass_order[itr->first]].name,
+                            passes[pass_order[itr->first]].name,
                             vk::to_string(src_stage),
                             vk::to_string(src_access),
                             old_p.name,
@@ -674,15 +936,91 @@ namespace Engine {
                 }
 
                 // Prepare attachment information
-                subpass.per_rendering_info = pimpl->GetPerRenderingInfo(old_p);
+                subpass.per_rendering_info = GetPerRenderingInfo(old_p);
                 p[i].subpasses.push_back(std::move(subpass));
             }
         }
 
+        for (const auto &[r, a] : usage.image_usages) {
+            if (static_cast<int32_t>(r) > 0) continue;
+            c.first_persistent_texture_access[r] = a.front().second;
+            c.last_persistent_texture_access[r] = a.back().second;
+        }
+        c.passes = std::move(p);
+        c.pass_order = std::move(pass_order);
+        c.reordered_usage = std::move(reordered_usage);
+        return c;
+    }
+
+    void RenderGraphBuilder2::Reset() noexcept {
+        pimpl->passes.clear();
+        pimpl->rs = {};
+    }
+
+    const RenderGraphBuilder2::BuildStatistics &RenderGraphBuilder2::GetBuildStatistics() const noexcept {
+        return pimpl->statistics;
+    }
+
+    RenderGraph2 RenderGraphBuilder2::BuildRenderGraph() {
+        pimpl->statistics.builds++;
+        auto [topology, extent] = pimpl->ComputeStructuralKeys();
+        size_t topology_hash = topology.Hash();
+        auto itr = pimpl->compiled_graphs.find(topology_hash);
+        if (itr != pimpl->compiled_graphs.end() && itr->second.topology != topology) {
+            // A different graph with the same hash, which is compiled again when it is built next time.
+            SDL_LogDebug(
+                SDL_LOG_CATEGORY_RENDER, std::format("Render graph hash collision on {:#x}.", topology_hash).c_str()
+            );
+            pimpl->compiled_graphs.erase(itr);
+            itr = pimpl->compiled_graphs.end();
+        }
+        if (itr == pimpl->compiled_graphs.end()) {
+            if (pimpl->compiled_graphs.size() >= MAX_COMPILED_GRAPHS) pimpl->compiled_graphs.clear();
+            itr = pimpl->compiled_graphs.emplace(topology_hash, pimpl->Compile()).first;
+            itr->second.topology = std::move(topology);
+            pimpl->statistics.compilations++;
+        } else {
+            SDL_LogDebug(
+                SDL_LOG_CATEGORY_RENDER, std::format("Reusing compiled render graph {:#x}.", topology_hash).c_str()
+            );
+        }
+        auto &c = itr->second;
+
+        // Transient textures alive at different times share memory.
+        if (c.extent != extent) {
+            c.aliasing = pimpl->rs.PlanTransientMemory(system, c.reordered_usage);
+            c.extent = std::move(extent);
+            pimpl->ApplyAliasingBarriers(c);
+            pimpl->statistics.memory_plannings++;
+            if (!c.aliasing.textures.empty()) {
+                SDL_LogInfo(
+                    SDL_LOG_CATEGORY_RENDER,
+                    std::format(
+                        "Aliased {} transient render targets into {} memory blocks: {:.2f} MiB allocated, "
+                        "{:.2f} MiB saved.",
+                        c.aliasing.textures.size(),
+                        c.aliasing.plan.blocks.size(),
+                        c.aliasing.plan.allocated_size / 1048576.0,
+                        (c.aliasing.plan.requested_size - c.aliasing.plan.allocated_size) / 1048576.0
+                    )
+                        .c_str()
+                );
+            }
+        }
+
+        auto p = c.passes;
+        for (size_t i = 0; i < p.size(); i++) {
+            for (size_t j = 0; j < p[i].subpasses.size(); j++) {
+                p[i].subpasses[j].pass_work = pimpl->passes[c.subpass_sources[i][j]].pass_function;
+            }
+        }
+
         RenderGraph2ExtraInfo e{};
         e.buffer_mapping = std::move(pimpl->rs.buffer_mapping);
         e.texture_mapping = std::move(pimpl->rs.texture_mapping);
-        e.transient_texture_storage = std::move(pimpl->rs.MaterializeRenderTargetTextures(system));
+        e.transient_texture_storage = pimpl->rs.MaterializeRenderTargetTextures(system, c.aliasing, e.transient_memory);
+        e.transient_memory_size = c.aliasing.plan.allocated_size;
+        e.aliased_memory_size = c.aliasing.plan.requested_size - c.aliasing.plan.allocated_size;
         for (const auto &[k, v] : e.transient_texture_storage) {
             assert(!e.texture_mapping.contains(k));
 
@@ -694,11 +1032,8 @@ namespace Engine {
                 e.texture_mapping[k] = std::get<1>(v);
             }
         }
-        for (const auto &[r, a] : usage.image_usages) {
-            if (static_cast<int32_t>(r) > 0) continue;
-            e.first_persistent_texture_access[r] = a.front().second;
-            e.last_persistent_texture_access[r] = a.back().second;
-        }
+        e.first_persistent_texture_access = c.first_persistent_texture_access;
+        e.last_persistent_texture_access = c.last_persistent_texture_access;
         return RenderGraph2(std::move(p), std::move(e));
     }
 
@@ -17,6 +17,18 @@ namespace Engine {
         std::unique_ptr<impl> pimpl;
 
     public:
+        /**
+         * @brief Counts of the work done by `BuildRenderGraph()`, which tell
+         * how often compiled graphs are reused.
+         */
+        struct BuildStatistics {
+            uint32_t builds{0};
+            /// Builds that compiled the passes, as no compiled graph had the same structure.
+            uint32_t compilations{0};
+            /// Builds that planned memory aliasing of transient textures, as their extents changed.
+            uint32_t memory_plannings{0};
+        };
+
         RenderGraphBuilder2(RenderSystem &system);
         ~RenderGraphBuilder2();
 
@@ -101,10 +113,35 @@ namespace Engine {
          */
         void AddPass(RenderGraphPass &&pass) noexcept;
 
+        /**
+         * @brief Remove all passes and resources, so that another render graph
+         * can be built with this builder.
+         *
+         * Handles are counted from the start again, and compiled render graphs
+         * are kept. Adding the same passes and resources again builds the same
+         * render graph without compiling it again.
+         */
+        void Reset() noexcept;
+
         /**
          * @brief Construct a render graph according to the passes.
+         *
+         * Compiled graphs are cached by the structure of passes and resources
+         * declared, and reused when the builder is reset and filled with the
+         * same structure, e.g. to toggle between debug views. Changing extents
+         * of transient textures only plans their memory again. Resizable
+         * textures are resolved through the `ResizableRTTManager`, so resizing
+         * them does not require building the render graph again.
+         *
+         * Resources are moved into the render graph. Call `Reset()` before
+         * building another one.
          */
         RenderGraph2 BuildRenderGraph();
+
+        /**
+         * @brief Get the counts of the work done by `BuildRenderGraph()` so far.
+         */
+        const BuildStatistics &GetBuildStatistics() const noexcept;
     };
 } // namespace Engine
 
@@ -6,6 +6,7 @@
 #include <vulkan/vulkan.hpp>
 
 #include "Render/Memory/MemoryAccessTypes.h"
+#include "Render/Memory/MemoryAllocation.h"
 #include "Render/Pipeline/PipelineRuntimeInfo.h"
 #include "Render/RenderSystem/ResizableRTTManager.h"
 
@@ -57,6 +58,11 @@ namespace Engine {
         std::unordered_map<RGTextureHandle, MemoryAccessTypeImageBits> first_persistent_texture_access,
             last_persistent_texture_access;
 
+        // Memory blocks shared by aliased transient textures, declared first to outlive them.
+        std::vector<MemoryBlockAllocation> transient_memory;
+        // Size of `transient_memory`, and size saved by aliasing, in bytes.
+        uint64_t transient_memory_size{0}, aliased_memory_size{0};
+
         std::unordered_map<RGTextureHandle, OwnedRenderTargetTextureVariant> transient_texture_storage;
 
         std::unordered_map<RGTextureHandle, RenderTargetTextureVariant> texture_mapping;
@@ -0,0 +1,93 @@
+#include "TransientMemoryPlanner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace {
+    constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept {
+        return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool LifetimeOverlaps(
+        const Engine::TransientMemoryPlanner::Request &a, const Engine::TransientMemoryPlanner::Request &b
+    ) noexcept {
+        return a.first_use <= b.last_use && b.first_use <= a.last_use;
+    }
+} // namespace
+
+namespace Engine {
+    TransientMemoryPlanner::Plan TransientMemoryPlanner::MakePlan(const std::vector<Request> &requests) {
+        Plan plan{};
+        plan.placements.resize(requests.size());
+
+        // Place large resources first, which leaves gaps that smaller resources can fill.
+        std::vector<size_t> order(requests.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&requests](size_t a, size_t b) {
+            return requests[a].size > requests[b].size;
+        });
+
+        // Placed resources in each block.
+        std::vector<std::vector<size_t>> residents{};
+        // Byte ranges of resources alive at the same time as the current one, sorted by offset.
+        std::vector<std::pair<uint64_t, uint64_t>> occupied{};
+        for (auto i : order) {
+            const auto &r = requests[i];
+            assert(r.first_use <= r.last_use);
+            plan.requested_size += r.size;
+
+            bool placed = false;
+            for (size_t b = 0; b < plan.blocks.size() && !placed; b++) {
+                auto &block = plan.blocks[b];
+                if (!(block.memory_type_bits & r.memory_type_bits)) continue;
+
+                occupied.clear();
+                for (auto j : residents[b]) {
+                    if (LifetimeOverlaps(r, requests[j])) {
+                        occupied.emplace_back(plan.placements[j].offset, plan.placements[j].offset + requests[j].size);
+                    }
+                }
+                std::sort(occupied.begin(), occupied.end());
+
+                // Find the lowest gap that fits.
+                uint64_t offset = 0;
+                for (const auto &[begin, end] : occupied) {
+                    if (offset + r.size <= begin) break;
+                    offset = std::max(offset, AlignUp(end, r.alignment));
+                }
+                if (offset + r.size > block.size) continue;
+
+                block.alignment = std::max(block.alignment, r.alignment);
+                block.memory_type_bits &= r.memory_type_bits;
+                plan.placements[i].block = b;
+                plan.placements[i].offset = offset;
+                residents[b].push_back(i);
+                placed = true;
+            }
+
+            if (!placed) {
+                plan.placements[i].block = plan.blocks.size();
+                plan.placements[i].offset = 0;
+                plan.blocks.push_back(Block{r.size, r.alignment, r.memory_type_bits});
+                residents.push_back({i});
+                plan.allocated_size += r.size;
+            }
+        }
+
+        // Resources sharing bytes with an earlier resource must wait for it.
+        for (const auto &resident : residents) {
+            for (auto i : resident) {
+                auto &p = plan.placements[i];
+                for (auto j : resident) {
+                    const auto &q = plan.placements[j];
+                    if (requests[j].last_use >= requests[i].first_use) continue;
+                    if (q.offset < p.offset + requests[i].size && p.offset < q.offset + requests[j].size) {
+                        p.aliased_predecessors.push_back(j);
+                    }
+                }
+            }
+        }
+        return plan;
+    }
+} // namespace Engine
@@ -0,0 +1,65 @@
+#ifndef PIPELINE_RENDERGRAPH2_TRANSIENTMEMORYPLANNER
+#define PIPELINE_RENDERGRAPH2_TRANSIENTMEMORYPLANNER
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+    /**
+     * @brief Plans memory aliasing of transient render graph resources.
+     *
+     * Each resource is alive from the pass of its first use to the pass of its
+     * last use. Resources whose lifetimes do not overlap may share the same
+     * memory. The planner packs resources into as few memory blocks as it can:
+     * resources are placed from the largest to the smallest, each at the lowest
+     * offset of an existing block where it does not overlap any resource alive
+     * at the same time, or in a new block if none fits.
+     *
+     * It only does the bookkeeping of blocks and offsets, and does not allocate
+     * any memory.
+     */
+    class TransientMemoryPlanner {
+    public:
+        struct Request {
+            uint64_t size;
+            uint64_t alignment;
+            /// Bits of memory types the resource can be bound to.
+            uint32_t memory_type_bits;
+            /// Pass indices of the first and the last use, both inclusive.
+            uint32_t first_use, last_use;
+        };
+
+        struct Block {
+            uint64_t size;
+            uint64_t alignment;
+            uint32_t memory_type_bits;
+        };
+
+        struct Placement {
+            size_t block;
+            uint64_t offset;
+            /**
+             * @brief Resources that use the same memory before this one.
+             *
+             * The first use of this resource must wait for their last uses.
+             */
+            std::vector<size_t> aliased_predecessors;
+        };
+
+        struct Plan {
+            std::vector<Block> blocks;
+            /// Placements of the requests, in the same order as the requests.
+            std::vector<Placement> placements;
+
+            /// Total size of the requests, i.e. the memory used without aliasing.
+            uint64_t requested_size{0};
+            /// Total size of the blocks.
+            uint64_t allocated_size{0};
+        };
+
+        static Plan MakePlan(const std::vector<Request> &requests);
+    };
+} // namespace Engine
+
+#endif // PIPELINE_RENDERGRAPH2_TRANSIENTMEMORYPLANNER
@@ -6,11 +6,14 @@
 
 #include "Framework/component/RenderComponent/RendererComponent.h"
 #include "Render/Memory/MemoryAccessTypes.h"
+#include "Render/Memory/MeshBufferArena.h"
 #include "Render/Pipeline/CommandBuffer.h"
 #include "Render/RenderSystem/AllocatorState.h"
 #include "Render/RenderSystem/CameraManager.h"
 #include "Render/RenderSystem/DeviceInterface.h"
 #include "Render/RenderSystem/FrameManager.h"
+#include "Render/RenderSystem/PipelineCache.h"
+#include "Render/RenderSystem/PipelineManifest.h"
 #include "Render/RenderSystem/RendererManager.h"
 #include "Render/RenderSystem/ResizableRTTManager.h"
 #include "Render/RenderSystem/Structs.h"
@@ -29,7 +32,7 @@ namespace Engine {
         impl(RenderSystem &parent, std::weak_ptr<SDLWindow> parent_window) :
             m_window(parent_window), m_allocator_state(parent), m_frame_manager(parent), m_renderer_manager(parent),
             m_scene_data_manager(parent), m_camera_manager(parent), m_resizable_rtt_manger(parent),
-            m_material_instance_provider(parent), m_material_library_provider(parent),
+            m_mesh_buffer_arena(parent), m_material_instance_provider(parent), m_material_library_provider(parent),
             m_static_mesh_resource_provider(parent) {
 
             };
@@ -38,10 +41,14 @@ namespace Engine {
         void CreateSwapchain();
 
         std::weak_ptr<SDLWindow> m_window;
+        JobSystem *m_job_system{nullptr};
 
         // Order of declaration effects destructing order!
         std::unique_ptr<RenderSystemState::DeviceInterface> m_device_interface{};
         std::unique_ptr<RenderSystemState::ImmutableResourceCache> m_immutable_resource_cache{};
+        // Saved to disk when destroyed, which requires the device.
+        std::unique_ptr<RenderSystemState::PipelineCache> m_pipeline_cache{};
+        RenderSystemState::PipelineManifest m_pipeline_manifest{};
 
         RenderSystemState::AllocatorState m_allocator_state;
         RenderSystemState::Swapchain m_swapchain{};
@@ -50,6 +57,8 @@ namespace Engine {
         RenderSystemState::SceneDataManager m_scene_data_manager;
         RenderSystemState::CameraManager m_camera_manager;
         RenderSystemState::ResizableRTTManager m_resizable_rtt_manger;
+        // Outlives resource managers, whose resources free their allocations from it.
+        MeshBufferArena m_mesh_buffer_arena;
 
         RenderSystemState::MaterialInstanceManager m_material_instance_provider;
         RenderSystemState::MaterialLibraryManager m_material_library_provider;
@@ -75,12 +84,14 @@ namespace Engine {
         pimpl->m_device_interface = std::make_unique<RenderSystemState::DeviceInterface>(cfg);
         pimpl->m_immutable_resource_cache =
             std::make_unique<RenderSystemState::ImmutableResourceCache>(pimpl->m_device_interface->GetDevice());
+        pimpl->m_pipeline_cache = std::make_unique<RenderSystemState::PipelineCache>(*pimpl->m_device_interface);
 
         pimpl->CreateSwapchain();
 
         pimpl->m_allocator_state.Create();
 
         pimpl->m_frame_manager.Create();
+        pimpl->m_renderer_manager.Create();
         pimpl->m_scene_data_manager.Create();
         pimpl->m_camera_manager.Create();
         SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "Vulkan initialization finished.");
@@ -109,6 +120,7 @@ namespace Engine {
         pimpl->m_material_instance_provider.TickFrame();
         pimpl->m_material_library_provider.TickFrame();
         pimpl->m_static_mesh_resource_provider.TickFrame();
+        pimpl->m_mesh_buffer_arena.TickFrame();
     }
 
     void RenderSystem::CompleteFrame(
@@ -150,6 +162,14 @@ namespace Engine {
         return *pimpl->m_immutable_resource_cache;
     }
 
+    RenderSystemState::PipelineCache &RenderSystem::GetPipelineCache() {
+        return *pimpl->m_pipeline_cache;
+    }
+
+    RenderSystemState::PipelineManifest &RenderSystem::GetPipelineManifest() {
+        return pimpl->m_pipeline_manifest;
+    }
+
     RenderSystemState::CameraManager &RenderSystem::GetCameraManager() {
         return pimpl->m_camera_manager;
     }
@@ -162,6 +182,18 @@ namespace Engine {
         return pimpl->m_resizable_rtt_manger;
     }
 
+    MeshBufferArena &RenderSystem::GetMeshBufferArena() {
+        return pimpl->m_mesh_buffer_arena;
+    }
+
+    void RenderSystem::SetJobSystem(JobSystem *job_system) noexcept {
+        pimpl->m_job_system = job_system;
+    }
+
+    JobSystem *RenderSystem::GetJobSystem() const noexcept {
+        return pimpl->m_job_system;
+    }
+
     void RenderSystem::WaitForIdle() const {
         pimpl->m_device_interface->GetDevice().waitIdle();
     }
@@ -173,6 +205,12 @@ namespace Engine {
 
     uint32_t RenderSystem::StartFrame() {
         auto fb = pimpl->m_frame_manager.StartFrame();
+        // Copies of the compacted mesh data are submitted before the draws of this frame,
+        // and frames in flight keep reading the old buffers.
+        if (pimpl->m_mesh_buffer_arena.IsFragmented()) {
+            pimpl->m_mesh_buffer_arena.Defragment(GetFrameManager().GetSubmissionHelper());
+        }
+        GetRendererManager().ResetInstanceData(GetFrameManager().GetFrameInFlight());
         GetCameraManager().FetchCameraData();
         GetCameraManager().UploadCameraData(GetFrameManager().GetFrameInFlight());
 
@@ -23,6 +23,8 @@ namespace Engine {
     class Camera;
     class GraphicsCommandBuffer;
     class RenderTargetTexture;
+    class MeshBufferArena;
+    class JobSystem;
 
     namespace ConstantData {
         struct PerCameraStruct;
@@ -35,6 +37,8 @@ namespace Engine {
         class FrameManager;
         class RendererManager;
         class ImmutableResourceCache;
+        class PipelineCache;
+        class PipelineManifest;
         class CameraManager;
         class SceneDataManager;
         class ResizableRTTManager;
@@ -153,12 +157,26 @@ namespace Engine {
         RenderSystemState::RendererManager &GetRendererManager();
         /// @brief Get the immutable resource cache
         RenderSystemState::ImmutableResourceCache &GetIRCache();
+        /// @brief Get the pipeline cache, which all pipelines should be created with
+        RenderSystemState::PipelineCache &GetPipelineCache();
+        /// @brief Get the manifest of material pipelines, which records and preheats them
+        RenderSystemState::PipelineManifest &GetPipelineManifest();
         /// @brief Get the camera manager
         RenderSystemState::CameraManager &GetCameraManager();
         /// @brief Get the manager for scene data (e.g lightings)
         RenderSystemState::SceneDataManager &GetSceneDataManager();
         /// @brief Get the manager for resizable render target textures
         RenderSystemState::ResizableRTTManager &GetResizableRTTManager();
+        /// @brief Get the arena of vertex and index buffers of static meshes
+        MeshBufferArena &GetMeshBufferArena();
+
+        /**
+         * @brief Set the job system creating pipelines in the background.
+         * nullptr makes pipelines created synchronously when they are first needed.
+         */
+        void SetJobSystem(JobSystem *job_system) noexcept;
+        /// @brief Get the job system creating pipelines in the background, could be null.
+        JobSystem *GetJobSystem() const noexcept;
 
         template <typename ResourceManagerType>
         ResourceManagerType &GetRenderResourceManager() {
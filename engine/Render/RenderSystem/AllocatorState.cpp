@@ -306,9 +306,7 @@ namespace Engine::RenderSystemState {
         return static_cast<bool>(vk::FormatFeatureFlags{ret.formatProperties.optimalTilingFeatures & feature});
     }
 
-    ImageAllocation AllocatorState::AllocateImage(
-        const ImageAllocationDescription &desc, const std::string &name
-    ) const {
+    vk::ImageCreateInfo AllocatorState::GetImageCreateInfo(const ImageAllocationDescription &desc) const {
         const auto [iusage, musage] = GetImageFlags(desc.type);
         auto fsupport =
             pimpl->QueryFormatSupport(m_system.GetDeviceInterface().GetPhysicalDevice(), desc.format, desc.type);
@@ -338,7 +336,7 @@ namespace Engine::RenderSystemState {
 
         vk::ImageCreateFlags icf{};
         if (desc.is_cube_map) icf |= vk::ImageCreateFlagBits::eCubeCompatible;
-        vk::ImageCreateInfo iinfo{
+        return vk::ImageCreateInfo{
             icf,
             desc.dimension,
             desc.format,
@@ -353,16 +351,60 @@ namespace Engine::RenderSystemState {
             vk::ImageLayout::eUndefined,
             nullptr
         };
+    }
 
-        VkImageCreateInfo iinfo2 = static_cast<VkImageCreateInfo>(iinfo);
+    ImageAllocation AllocatorState::AllocateImage(
+        const ImageAllocationDescription &desc, const std::string &name
+    ) const {
+        VkImageCreateInfo iinfo = static_cast<VkImageCreateInfo>(GetImageCreateInfo(desc));
 
         VmaAllocationCreateInfo ainfo{};
-        ainfo.usage = musage;
+        ainfo.usage = std::get<1>(GetImageFlags(desc.type));
 
         VkImage image;
         VmaAllocation allocation;
-        vmaCreateImage(pimpl->m_allocator, &iinfo2, &ainfo, &image, &allocation, nullptr);
+        vmaCreateImage(pimpl->m_allocator, &iinfo, &ainfo, &image, &allocation, nullptr);
         DEBUG_SET_NAME_TEMPLATE(m_system.GetDevice(), static_cast<vk::Image>(image), name);
         return ImageAllocation(static_cast<vk::Image>(image), allocation, pimpl->m_allocator, desc.type);
     }
+
+    vk::MemoryRequirements AllocatorState::QueryImageMemoryRequirements(const ImageAllocationDescription &desc) const {
+        auto iinfo = GetImageCreateInfo(desc);
+        auto mreq = m_system.GetDevice().getImageMemoryRequirements(vk::DeviceImageMemoryRequirements{&iinfo});
+        return mreq.memoryRequirements;
+    }
+
+    MemoryBlockAllocation AllocatorState::AllocateMemoryBlock(
+        const vk::MemoryRequirements &requirements, const std::string &name
+    ) const {
+        assert(pimpl->m_allocator && "Allocated not initalized.");
+        VkMemoryRequirements mreq = static_cast<VkMemoryRequirements>(requirements);
+
+        // Automatic memory usages need resource info, so the memory type is specified by flags.
+        VmaAllocationCreateInfo ainfo{};
+        ainfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        VmaAllocation allocation{};
+        VkResult result = vmaAllocateMemory(pimpl->m_allocator, &mreq, &ainfo, &allocation, nullptr);
+        vk::detail::resultCheck(vk::Result{result}, "Failed to allocate memory block.");
+        if (!name.empty()) vmaSetAllocationName(pimpl->m_allocator, allocation, name.c_str());
+        return MemoryBlockAllocation(allocation, pimpl->m_allocator, requirements.size);
+    }
+
+    ImageAllocation AllocatorState::AllocateAliasingImage(
+        const ImageAllocationDescription &desc,
+        const MemoryBlockAllocation &block,
+        size_t offset,
+        const std::string &name
+    ) const {
+        VkImageCreateInfo iinfo = static_cast<VkImageCreateInfo>(GetImageCreateInfo(desc));
+
+        VkImage image;
+        VkResult result = vmaCreateAliasingImage2(pimpl->m_allocator, block.GetAllocation(), offset, &iinfo, &image);
+        vk::detail::resultCheck(vk::Result{result}, "Failed to create aliasing image.");
+        DEBUG_SET_NAME_TEMPLATE(m_system.GetDevice(), static_cast<vk::Image>(image), name);
+        return ImageAllocation(
+            static_cast<vk::Image>(image), block.GetAllocation(), pimpl->m_allocator, desc.type, false
+        );
+    }
 } // namespace Engine::RenderSystemState
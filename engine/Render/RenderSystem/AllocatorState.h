@@ -89,10 +89,40 @@ namespace Engine {
                 const ImageAllocationDescription &desc, const std::string &name = ""
             ) const noexcept;
 
+            /**
+             * @brief Query the memory requirements of an image, without creating it.
+             */
+            vk::MemoryRequirements QueryImageMemoryRequirements(const ImageAllocationDescription &desc) const;
+
+            /**
+             * @brief Allocate a block of device local memory, over which images can be
+             * created with `AllocateAliasingImage()`.
+             */
+            MemoryBlockAllocation AllocateMemoryBlock(
+                const vk::MemoryRequirements &requirements, const std::string &name = ""
+            ) const;
+
+            /**
+             * @brief Create an image over a memory block at the given offset.
+             *
+             * The image does not own the memory, and the block must outlive it. The
+             * offset must satisfy the alignment given by `QueryImageMemoryRequirements()`.
+             */
+            ImageAllocation AllocateAliasingImage(
+                const ImageAllocationDescription &desc,
+                const MemoryBlockAllocation &block,
+                size_t offset,
+                const std::string &name = ""
+            ) const;
+
             /**
              * @brief Query whether a given format supports intended usage feature.
              */
             bool QueryFormatFeatures(vk::Format format, vk::FormatFeatureFlagBits feature) const noexcept;
+
+        private:
+            /// @brief Check the support of an image allocation, and fill the create info.
+            vk::ImageCreateInfo GetImageCreateInfo(const ImageAllocationDescription &desc) const;
         };
     } // namespace RenderSystemState
 } // namespace Engine
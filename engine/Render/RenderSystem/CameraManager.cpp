@@ -3,6 +3,7 @@
 #include "Render/DebugUtils.h"
 #include "Render/Memory/IndexedBuffer.h"
 #include "Render/RenderSystem/DeviceInterface.h"
+#include "Render/RenderSystem/RendererManager.h"
 #include "Render/Renderer/Camera.h"
 #include <SDL3/SDL.h>
 #include <glm.hpp>
@@ -15,19 +16,24 @@ namespace Engine::RenderSystemState {
             glm::mat4 proj_matrix;
         };
 
-        static constexpr std::array<vk::DescriptorPoolSize, 1> CAMERA_DESCRIPTOR_POOL_SIZE{
-            vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, 16}
+        static constexpr std::array<vk::DescriptorPoolSize, 2> CAMERA_DESCRIPTOR_POOL_SIZE{
+            vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, 16},
+            vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, 16}
         };
 
-        static constexpr std::array<vk::DescriptorSetLayoutBinding, 1> CAMERA_DESCRIPTOR_BINDINGS{
+        // Binding 1 is the instance buffer of RendererManager, bound along with the camera data.
+        static constexpr std::array<vk::DescriptorSetLayoutBinding, 2> CAMERA_DESCRIPTOR_BINDINGS{
             vk::DescriptorSetLayoutBinding{
                 0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eAllGraphics
+            },
+            vk::DescriptorSetLayoutBinding{
+                1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eAllGraphics
             }
         };
 
         vk::UniqueDescriptorPool camera_descriptor_pool{};
 
-        // Camera descriptor set layout, currently containing only one UBO.
+        // Camera descriptor set layout, containing the camera UBO and the instance SSBO.
         vk::DescriptorSetLayout camera_descriptor_set_layout{};
 
         // Common pipeline layout for scene & camera.
@@ -109,19 +115,31 @@ namespace Engine::RenderSystemState {
         assert(pimpl->back_buffer);
 
         // Write out descriptors
+        const auto &instance_buffer = m_system.GetRendererManager().GetInstanceBuffer();
         std::vector<vk::DescriptorBufferInfo> buffers(
             pimpl->descriptors.size(),
             vk::DescriptorBufferInfo{pimpl->back_buffer->GetBuffer(), 0, pimpl->back_buffer->GetSliceSize()}
         );
-        std::vector<vk::WriteDescriptorSet> writes(
+        std::vector<vk::DescriptorBufferInfo> instance_buffers(
             pimpl->descriptors.size(),
+            vk::DescriptorBufferInfo{instance_buffer.GetBuffer(), 0, instance_buffer.GetSliceSize()}
+        );
+        std::vector<vk::WriteDescriptorSet> writes(
+            pimpl->descriptors.size() * 2,
             vk::WriteDescriptorSet{nullptr, 0, 0, vk::DescriptorType::eUniformBuffer, {}, {}, {}}
         );
         for (uint32_t i = 0; i < pimpl->descriptors.size(); i++) {
             buffers[i].offset = pimpl->back_buffer->GetSliceOffset(i);
-            writes[i].dstSet = pimpl->descriptors[i];
-            writes[i].descriptorCount = 1;
-            writes[i].pBufferInfo = &buffers[i];
+            writes[i * 2].dstSet = pimpl->descriptors[i];
+            writes[i * 2].descriptorCount = 1;
+            writes[i * 2].pBufferInfo = &buffers[i];
+
+            instance_buffers[i].offset = instance_buffer.GetSliceOffset(i);
+            writes[i * 2 + 1].dstSet = pimpl->descriptors[i];
+            writes[i * 2 + 1].dstBinding = 1;
+            writes[i * 2 + 1].descriptorType = vk::DescriptorType::eStorageBuffer;
+            writes[i * 2 + 1].descriptorCount = 1;
+            writes[i * 2 + 1].pBufferInfo = &instance_buffers[i];
         }
         device.updateDescriptorSets(writes, {});
     }
@@ -195,6 +213,16 @@ namespace Engine::RenderSystemState {
         return m_active_camera_index;
     }
 
+    glm::mat4 CameraManager::GetProjectionViewMatrix(uint32_t index) const noexcept {
+        assert(index < pimpl->front_buffer.size());
+        return pimpl->front_buffer[index].proj_matrix * pimpl->front_buffer[index].view_matrix;
+    }
+
+    glm::vec3 CameraManager::GetCameraPosition(uint32_t index) const noexcept {
+        assert(index < pimpl->front_buffer.size());
+        return glm::vec3(glm::inverse(pimpl->front_buffer[index].view_matrix)[3]);
+    }
+
     glm::mat4 CameraManager::GetPVMatForSkybox() const {
         auto camera = pimpl->registered_cameras[m_active_camera_index].lock();
         assert(camera);
@@ -92,6 +92,16 @@ namespace Engine {
             void SetActiveCameraIndex(uint32_t index) noexcept;
             uint32_t GetActiveCameraIndex() const noexcept;
 
+            /**
+             * @brief Get the projection * view matrix last written to a camera.
+             */
+            glm::mat4 GetProjectionViewMatrix(uint32_t index) const noexcept;
+
+            /**
+             * @brief Get the world-space position of a camera from the view matrix last written to it.
+             */
+            glm::vec3 GetCameraPosition(uint32_t index) const noexcept;
+
             /**
              * @brief Get the projection-view matrix for skybox rendering.
              * XXX: temporary solution. Don't know how to get pv matrix since skybox don't use scene data.
@@ -18,6 +18,7 @@ namespace Engine::RenderSystemState {
         vk::UniqueSurfaceKHR surface{};
         vk::PhysicalDeviceMemoryProperties physical_device_memory_properties{};
         vk::PhysicalDeviceProperties physical_device_properties{};
+        vk::PhysicalDeviceFeatures enabled_features{};
         vk::PhysicalDevice physical_device{};
         vk::UniqueDevice device{};
 
@@ -356,7 +357,13 @@ namespace Engine::RenderSystemState {
             dci.queueCreateInfoCount = static_cast<uint32_t>(dqcs.size());
             dci.pQueueCreateInfos = dqcs.data();
 
+            // Optional features are enabled when available.
+            auto supported_features = physical_device.getFeatures();
+            enabled_features.multiDrawIndirect = supported_features.multiDrawIndirect;
+            enabled_features.drawIndirectFirstInstance = supported_features.drawIndirectFirstInstance;
+
             vk::PhysicalDeviceFeatures2 pdf{};
+            pdf.features = enabled_features;
             vk::PhysicalDeviceVulkan13Features features13{};
             features13.dynamicRendering = true;
             features13.synchronization2 = true;
@@ -473,6 +480,10 @@ namespace Engine::RenderSystemState {
             return std::get<1>(pimpl->queue_families.async_transfer_granularity);
         case AsyncTransferImageGranularityDepth:
             return std::get<2>(pimpl->queue_families.async_transfer_granularity);
+        case MaxDrawIndirectCount:
+            return pimpl->enabled_features.multiDrawIndirect
+                       ? pimpl->physical_device_properties.limits.maxDrawIndirectCount
+                       : 1;
         }
         __builtin_unreachable();
         return 0;
@@ -481,4 +492,15 @@ namespace Engine::RenderSystemState {
         assert(!"Unimplemented.");
         return 0.0f;
     }
+
+    bool DeviceInterface::IsFeatureEnabled(PhysicalDeviceFeature feature) const noexcept {
+        switch (feature) {
+            using enum PhysicalDeviceFeature;
+        case MultiDrawIndirect:
+            return pimpl->enabled_features.multiDrawIndirect;
+        case DrawIndirectFirstInstance:
+            return pimpl->enabled_features.drawIndirectFirstInstance;
+        }
+        return false;
+    }
 } // namespace Engine::RenderSystemState
@@ -55,13 +55,23 @@ namespace Engine {
                 StorageBufferOffsetAlignment,
                 AsyncTransferImageGranularityWidth,
                 AsyncTransferImageGranularityHeight,
-                AsyncTransferImageGranularityDepth
+                AsyncTransferImageGranularityDepth,
+                /// One if multi-draw indirect is not enabled.
+                MaxDrawIndirectCount
             };
 
             /// @brief Types of floating point limits that can be queried for.
             enum class PhysicalDeviceLimitFloat {
             };
 
+            /// @brief Optional features that are enabled only if the physical device supports them.
+            enum class PhysicalDeviceFeature {
+                /// Indirect draws with a draw count larger than one.
+                MultiDrawIndirect,
+                /// Indirect draw commands with a non-zero first instance.
+                DrawIndirectFirstInstance
+            };
+
             /// @brief Types of queue families.
             enum class QueueFamilyType {
                 // Main graphics queue family that supports all operations.
@@ -128,6 +138,11 @@ namespace Engine {
             uint32_t QueryLimit(PhysicalDeviceLimitInteger limit) const;
             /// @overload uint32_t DeviceInterface::QueryLimit(PhysicalDeviceLimitInteger limit) const
             float QueryLimit(PhysicalDeviceLimitFloat limit) const;
+
+            /**
+             * @brief Query whether an optional feature is enabled on the logical device.
+             */
+            bool IsFeatureEnabled(PhysicalDeviceFeature feature) const noexcept;
         };
     } // namespace RenderSystemState
 } // namespace Engine
@@ -0,0 +1,78 @@
+#ifndef RENDER_RENDERSYSTEM_DRAWPACKET_INCLUDED
+#define RENDER_RENDERSYSTEM_DRAWPACKET_INCLUDED
+
+#include "Core/InlineVector.h"
+#include "Render/Renderer/IVertexBasedRenderer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vulkan/vulkan.hpp>
+
+namespace Engine {
+    class MaterialInstance;
+    class MaterialLibrary;
+    class MaterialTemplate;
+
+    namespace RenderSystemState {
+        /**
+         * @brief Everything needed to record the draw of a renderer in a pass, resolved
+         * once and cached by RendererManager.
+         *
+         * A packet is keyed on the renderer and the pass, i.e. the pass tag and the
+         * attachment formats. It is rebuilt when the renderer handle, the generation
+         * of the material library or the generation of the mesh buffer arena changes,
+         * and on every use while its material template is pending.
+         */
+        struct DrawPacket {
+            static constexpr size_t MAX_VERTEX_BUFFERS = IVertexBasedRenderer::MAX_VERTEX_BUFFER_BINDINGS;
+
+            /// Handle of the renderer, zero if the packet is empty.
+            uint32_t handle{0};
+            const IVertexBasedRenderer *renderer{nullptr};
+            MaterialInstance *material{nullptr};
+            /// Null if the material library has no template for the pass, in which case nothing is drawn.
+            /// The fallback template of the library, or null, while the template is pending.
+            MaterialTemplate *material_template{nullptr};
+            bool template_pending{false};
+            vk::Pipeline pipeline{};
+            vk::PipelineLayout pipeline_layout{};
+
+            /// Equal for packets drawing the same submesh with the same material instance,
+            /// which can be merged into one instanced draw.
+            uint32_t geometry_id{0};
+            uint32_t material_id{0};
+            bool supports_instancing{false};
+
+            InlineVector<vk::Buffer, MAX_VERTEX_BUFFERS> vertex_buffers{};
+            InlineVector<vk::DeviceSize, MAX_VERTEX_BUFFERS> vertex_offsets{};
+            vk::Buffer index_buffer{};
+            vk::DeviceSize index_offset{0};
+            uint32_t index_count{0};
+            uint32_t first_index{0};
+            int32_t vertex_offset{0};
+
+            const MaterialLibrary *library{nullptr};
+            uint32_t library_generation{0};
+            uint32_t mesh_generation{0};
+
+            /// @brief Check whether two packets are drawn from the same vertex and index buffer bindings.
+            bool HasSameBufferBindings(const DrawPacket &other) const noexcept {
+                return index_buffer == other.index_buffer && index_offset == other.index_offset
+                       && std::equal(
+                           vertex_buffers.begin(),
+                           vertex_buffers.end(),
+                           other.vertex_buffers.begin(),
+                           other.vertex_buffers.end()
+                       )
+                       && std::equal(
+                           vertex_offsets.begin(),
+                           vertex_offsets.end(),
+                           other.vertex_offsets.begin(),
+                           other.vertex_offsets.end()
+                       );
+            }
+        };
+    } // namespace RenderSystemState
+} // namespace Engine
+
+#endif // RENDER_RENDERSYSTEM_DRAWPACKET_INCLUDED
@@ -0,0 +1,226 @@
+#include "PipelineCache.h"
+
+#include "Render/Hasher.hpp"
+#include "Render/RenderSystem/DeviceInterface.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace Engine::RenderSystemState {
+    namespace {
+        struct FileHeader {
+            static constexpr std::array<char, 4> MAGIC{'E', 'P', 'L', 'C'};
+            static constexpr uint32_t VERSION = 1;
+
+            std::array<char, 4> magic;
+            uint32_t version;
+            uint32_t vendor_id;
+            uint32_t device_id;
+            uint32_t driver_version;
+            std::array<uint8_t, vk::UuidSize> pipeline_cache_uuid;
+            uint64_t data_size;
+            uint64_t data_hash;
+        };
+        static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+        uint64_t HashData(std::span<const std::byte> data) noexcept {
+            RenderResourceHasher h;
+            h.binary_data(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+            return h.get();
+        }
+    } // namespace
+
+    struct PipelineCache::impl {
+        vk::Device m_device;
+        DeviceIdentity m_identity{};
+        vk::UniquePipelineCache m_cache{};
+        std::filesystem::path m_path{};
+
+        uint64_t m_loaded_bytes{0};
+        std::atomic<uint32_t> m_pipeline_count{0};
+        std::atomic<uint64_t> m_creation_nanoseconds{0};
+
+        template <typename Function>
+        vk::UniquePipeline TimedCreate(Function &&create) {
+            auto start = std::chrono::steady_clock::now();
+            auto ret = create();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            m_pipeline_count++;
+            m_creation_nanoseconds +=
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            return std::move(ret.value);
+        }
+    };
+
+    PipelineCache::PipelineCache(const DeviceInterface &device) : pimpl(std::make_unique<impl>()) {
+        pimpl->m_device = device.GetDevice();
+
+        auto props = device.GetPhysicalDevice().getProperties();
+        pimpl->m_identity.vendor_id = props.vendorID;
+        pimpl->m_identity.device_id = props.deviceID;
+        pimpl->m_identity.driver_version = props.driverVersion;
+        std::copy(
+            props.pipelineCacheUUID.begin(),
+            props.pipelineCacheUUID.end(),
+            pimpl->m_identity.pipeline_cache_uuid.begin()
+        );
+
+        pimpl->m_cache = pimpl->m_device.createPipelineCacheUnique(vk::PipelineCacheCreateInfo{});
+    }
+
+    PipelineCache::~PipelineCache() noexcept {
+        if (pimpl->m_path.empty()) return;
+        try {
+            Save();
+        } catch (const std::exception &e) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to save pipeline cache: %s", e.what());
+        }
+    }
+
+    bool PipelineCache::Load(const std::filesystem::path &path) {
+        pimpl->m_path = path;
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "No pipeline cache found at %s.", path.string().c_str());
+            return false;
+        }
+        std::vector<std::byte> content(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(content.data()), static_cast<std::streamsize>(content.size()));
+        if (!file) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Cannot read pipeline cache %s.", path.string().c_str());
+            return false;
+        }
+
+        auto data = Deserialize(content, pimpl->m_identity);
+        if (data.empty()) {
+            SDL_LogInfo(
+                SDL_LOG_CATEGORY_RENDER,
+                "Pipeline cache %s is invalid or was written for another device, ignored.",
+                path.string().c_str()
+            );
+            return false;
+        }
+
+        // Pipelines created before loading are merged into the loaded cache.
+        auto loaded = pimpl->m_device.createPipelineCacheUnique(
+            vk::PipelineCacheCreateInfo{vk::PipelineCacheCreateFlags{}, data.size(), data.data()}
+        );
+        pimpl->m_device.mergePipelineCaches(loaded.get(), {pimpl->m_cache.get()});
+        pimpl->m_cache = std::move(loaded);
+        pimpl->m_loaded_bytes = data.size();
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_RENDER, "Loaded %zu bytes of pipeline cache from %s.", data.size(), path.string().c_str()
+        );
+        return true;
+    }
+
+    bool PipelineCache::Save() const {
+        if (pimpl->m_path.empty()) return false;
+
+        auto data = pimpl->m_device.getPipelineCacheData(pimpl->m_cache.get());
+        auto content = Serialize(pimpl->m_identity, std::as_bytes(std::span{data}));
+
+        std::error_code ec;
+        if (pimpl->m_path.has_parent_path()) std::filesystem::create_directories(pimpl->m_path.parent_path(), ec);
+        // Write to a temporary file first, so that an interrupted write never leaves a truncated cache.
+        auto temporary = pimpl->m_path;
+        temporary += ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(content.data()), static_cast<std::streamsize>(content.size()));
+            if (!file) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Cannot write pipeline cache %s.", temporary.string().c_str());
+                return false;
+            }
+        }
+        std::filesystem::rename(temporary, pimpl->m_path, ec);
+        if (ec) {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_RENDER,
+                "Cannot write pipeline cache %s: %s.",
+                pimpl->m_path.string().c_str(),
+                ec.message().c_str()
+            );
+            return false;
+        }
+
+        auto stats = GetStatistics();
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_RENDER,
+            "Saved %zu bytes of pipeline cache. %u pipelines were created in %.2f ms, with %llu bytes loaded.",
+            data.size(),
+            stats.pipeline_count,
+            stats.creation_milliseconds,
+            static_cast<unsigned long long>(stats.loaded_bytes)
+        );
+        return true;
+    }
+
+    vk::PipelineCache PipelineCache::GetPipelineCache() const noexcept {
+        return pimpl->m_cache.get();
+    }
+
+    vk::UniquePipeline PipelineCache::CreateGraphicsPipeline(const vk::GraphicsPipelineCreateInfo &info) {
+        return pimpl->TimedCreate([this, &info]() {
+            return pimpl->m_device.createGraphicsPipelineUnique(pimpl->m_cache.get(), info);
+        });
+    }
+
+    vk::UniquePipeline PipelineCache::CreateComputePipeline(const vk::ComputePipelineCreateInfo &info) {
+        return pimpl->TimedCreate([this, &info]() {
+            return pimpl->m_device.createComputePipelineUnique(pimpl->m_cache.get(), info);
+        });
+    }
+
+    PipelineCache::Statistics PipelineCache::GetStatistics() const noexcept {
+        return Statistics{
+            .loaded_bytes = pimpl->m_loaded_bytes,
+            .pipeline_count = pimpl->m_pipeline_count.load(),
+            .creation_milliseconds = static_cast<double>(pimpl->m_creation_nanoseconds.load()) / 1e6
+        };
+    }
+
+    std::vector<std::byte> PipelineCache::Serialize(const DeviceIdentity &identity, std::span<const std::byte> data) {
+        FileHeader header{
+            .magic = FileHeader::MAGIC,
+            .version = FileHeader::VERSION,
+            .vendor_id = identity.vendor_id,
+            .device_id = identity.device_id,
+            .driver_version = identity.driver_version,
+            .pipeline_cache_uuid = identity.pipeline_cache_uuid,
+            .data_size = data.size(),
+            .data_hash = HashData(data)
+        };
+
+        std::vector<std::byte> file(sizeof(FileHeader) + data.size());
+        std::memcpy(file.data(), &header, sizeof(FileHeader));
+        std::copy(data.begin(), data.end(), file.begin() + sizeof(FileHeader));
+        return file;
+    }
+
+    std::span<const std::byte> PipelineCache::Deserialize(
+        std::span<const std::byte> file, const DeviceIdentity &identity
+    ) noexcept {
+        if (file.size() < sizeof(FileHeader)) return {};
+        FileHeader header;
+        std::memcpy(&header, file.data(), sizeof(FileHeader));
+
+        if (header.magic != FileHeader::MAGIC || header.version != FileHeader::VERSION) return {};
+        if (header.vendor_id != identity.vendor_id || header.device_id != identity.device_id
+            || header.driver_version != identity.driver_version
+            || header.pipeline_cache_uuid != identity.pipeline_cache_uuid) {
+            return {};
+        }
+
+        auto data = file.subspan(sizeof(FileHeader));
+        if (header.data_size != data.size() || header.data_hash != HashData(data)) return {};
+        return data;
+    }
+} // namespace Engine::RenderSystemState
@@ -0,0 +1,99 @@
+#ifndef RENDER_RENDERSYSTEM_PIPELINECACHE_INCLUDED
+#define RENDER_RENDERSYSTEM_PIPELINECACHE_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace Engine {
+    namespace RenderSystemState {
+        class DeviceInterface;
+
+        /**
+         * @brief Pipeline cache shared by all graphics and compute pipelines,
+         * persisted to disk between runs.
+         *
+         * The cache starts empty. `Load()` fills it from a file, which is only
+         * accepted if it was written on the same device and driver, and sets
+         * the file that `Save()` writes back to. The cache is saved when it is
+         * destroyed, if a file is set.
+         *
+         * Pipelines should be created with `CreateGraphicsPipeline()` and
+         * `CreateComputePipeline()`, which also measure creation time. They may
+         * be called from multiple threads.
+         */
+        class PipelineCache {
+        public:
+            /// @brief Properties of the device that the data of a cache is only valid for.
+            struct DeviceIdentity {
+                uint32_t vendor_id;
+                uint32_t device_id;
+                uint32_t driver_version;
+                std::array<uint8_t, vk::UuidSize> pipeline_cache_uuid;
+            };
+
+            struct Statistics {
+                /// Size of the cache data accepted by `Load()`, zero if none.
+                uint64_t loaded_bytes;
+                uint32_t pipeline_count;
+                /// Total time spent creating pipelines, in milliseconds.
+                double creation_milliseconds;
+            };
+
+            PipelineCache(const DeviceInterface &device);
+            ~PipelineCache() noexcept;
+
+            PipelineCache(const PipelineCache &) = delete;
+            void operator=(const PipelineCache &) = delete;
+
+            /**
+             * @brief Load cache data from a file, and save to it from now on.
+             *
+             * Pipelines already in the cache are kept. Missing, corrupted or
+             * mismatching files are ignored.
+             *
+             * @return Whether cache data was loaded from the file.
+             */
+            bool Load(const std::filesystem::path &path);
+
+            /**
+             * @brief Write the cache data to the file set by `Load()`, creating
+             * its directory if needed.
+             *
+             * @return Whether the file was written.
+             */
+            bool Save() const;
+
+            vk::PipelineCache GetPipelineCache() const noexcept;
+
+            vk::UniquePipeline CreateGraphicsPipeline(const vk::GraphicsPipelineCreateInfo &info);
+            vk::UniquePipeline CreateComputePipeline(const vk::ComputePipelineCreateInfo &info);
+
+            Statistics GetStatistics() const noexcept;
+
+            /// @brief Wrap cache data in a file with a header identifying the device.
+            static std::vector<std::byte> Serialize(const DeviceIdentity &identity, std::span<const std::byte> data);
+
+            /**
+             * @brief Extract cache data from a file written by `Serialize()`.
+             *
+             * @return The cache data, or an empty span if the file is corrupted
+             * or was written for another device or driver.
+             */
+            static std::span<const std::byte> Deserialize(
+                std::span<const std::byte> file, const DeviceIdentity &identity
+            ) noexcept;
+
+        private:
+            struct impl;
+            std::unique_ptr<impl> pimpl;
+        };
+    } // namespace RenderSystemState
+} // namespace Engine
+
+#endif // RENDER_RENDERSYSTEM_PIPELINECACHE_INCLUDED
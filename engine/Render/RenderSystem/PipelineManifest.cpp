@@ -0,0 +1,209 @@
+#include "PipelineManifest.h"
+
+#include "Render/Pipeline/Material/MaterialLibrary.h"
+#include "Render/RenderSystem.h"
+#include "Render/Resource/MaterialLibraryManager.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <type_traits>
+
+namespace Engine::RenderSystemState {
+    namespace {
+        constexpr uint32_t VERSION = 1;
+        constexpr size_t COLOR_ATTACHMENT_COUNT = std::extent_v<decltype(PipelineRuntimeInfo::color_attachment_format)>;
+    } // namespace
+
+    PipelineManifest::~PipelineManifest() noexcept {
+        if (m_path.empty() || !m_dirty) return;
+        try {
+            Save();
+        } catch (const std::exception &e) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to save pipeline manifest: %s", e.what());
+        }
+    }
+
+    bool PipelineManifest::Load(const std::filesystem::path &path) {
+        m_path = path;
+
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "No pipeline manifest found at %s.", path.string().c_str());
+            return false;
+        }
+        std::stringstream content;
+        content << file.rdbuf();
+
+        auto entries = Deserialize(content.str());
+        if (entries.empty()) {
+            SDL_LogInfo(
+                SDL_LOG_CATEGORY_RENDER, "Pipeline manifest %s is empty or malformed, ignored.", path.string().c_str()
+            );
+            return false;
+        }
+
+        // Entries of libraries not loaded from an asset cannot be preheated.
+        bool dropped = std::erase_if(entries, [](const Entry &entry) { return entry.library == GUID::Nil(); }) > 0;
+
+        // Entries recorded before loading are kept, and the file is rewritten to include them.
+        bool had_entries = !m_entries.empty();
+        for (auto &entry : entries) {
+            if (std::find(m_entries.begin(), m_entries.end(), entry) == m_entries.end()) {
+                m_entries.push_back(std::move(entry));
+            }
+        }
+        m_dirty = had_entries || dropped;
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_RENDER, "Loaded %zu pipelines from manifest %s.", entries.size(), path.string().c_str()
+        );
+        return true;
+    }
+
+    bool PipelineManifest::Save() const {
+        if (m_path.empty()) return false;
+
+        std::error_code ec;
+        if (m_path.has_parent_path()) std::filesystem::create_directories(m_path.parent_path(), ec);
+        std::ofstream file(m_path, std::ios::trunc);
+        file << Serialize(m_entries);
+        if (!file) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Cannot write pipeline manifest %s.", m_path.string().c_str());
+            return false;
+        }
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_RENDER, "Saved %zu pipelines to manifest %s.", m_entries.size(), m_path.string().c_str()
+        );
+        return true;
+    }
+
+    bool PipelineManifest::Record(const GUID &library, const std::string &tag, const PipelineRuntimeInfo &pri) {
+        if (library == GUID::Nil()) return false;
+        Entry entry{library, tag, pri};
+        if (std::find(m_entries.begin(), m_entries.end(), entry) != m_entries.end()) return false;
+        m_entries.push_back(std::move(entry));
+        m_dirty = true;
+        return true;
+    }
+
+    const std::vector<PipelineManifest::Entry> &PipelineManifest::GetEntries() const noexcept {
+        return m_entries;
+    }
+
+    void PipelineManifest::Preheat(RenderSystem &system, const std::function<void(size_t, size_t)> &progress) {
+        auto start = std::chrono::steady_clock::now();
+        auto &manager = system.GetRenderResourceManager<MaterialLibraryManager>();
+
+        // Copied, as libraries record the pipelines they create.
+        auto entries = m_entries;
+
+        // Schedule all pipelines first, so that they are created in parallel.
+        std::vector<MaterialLibrary *> libraries(entries.size(), nullptr);
+        for (size_t i = 0; i < entries.size(); i++) {
+            const auto &entry = entries[i];
+            try {
+                libraries[i] = manager.Resolve(manager.CreateOrReuseFromAsset(entry.library));
+            } catch (const std::exception &e) {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_RENDER,
+                    "Cannot preheat pipelines of material library %s: %s",
+                    entry.library.string().c_str(),
+                    e.what()
+                );
+                continue;
+            }
+            if (libraries[i] && !libraries[i]->PreheatMaterialTemplate(entry.tag, entry.pri)) {
+                libraries[i] = nullptr;
+            }
+        }
+
+        // Drop entries that did not resolve, so that they are not tried again on every load.
+        // Libraries only append entries, so the first entries are still those copied above.
+        size_t kept = 0;
+        for (size_t i = 0; i < m_entries.size(); i++) {
+            if (i < libraries.size() && libraries[i] == nullptr) continue;
+            if (kept != i) m_entries[kept] = std::move(m_entries[i]);
+            kept++;
+        }
+        if (kept != m_entries.size()) {
+            SDL_LogInfo(
+                SDL_LOG_CATEGORY_RENDER, "Removed %zu stale pipelines from the manifest.", m_entries.size() - kept
+            );
+            m_entries.resize(kept);
+            m_dirty = true;
+        }
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (libraries[i]) libraries[i]->FindMaterialTemplate(entries[i].tag, entries[i].pri);
+            if (progress) progress(i + 1, entries.size());
+        }
+
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_RENDER,
+            "Preheated %zu pipelines in %.2f ms.",
+            static_cast<size_t>(std::count_if(libraries.begin(), libraries.end(), [](auto l) { return l != nullptr; })),
+            elapsed.count()
+        );
+    }
+
+    std::string PipelineManifest::Serialize(const std::vector<Entry> &entries) {
+        nlohmann::json json;
+        json["version"] = VERSION;
+        json["entries"] = nlohmann::json::array();
+        for (const auto &entry : entries) {
+            nlohmann::json color = nlohmann::json::array();
+            for (auto format : entry.pri.color_attachment_format) {
+                if (format == ImageUtils::ImageFormat::UNDEFINED) break;
+                color.push_back(static_cast<uint32_t>(format));
+            }
+            json["entries"].push_back({
+                {"library", entry.library.string()},
+                {"tag", entry.tag},
+                {"vertex_attribute", entry.pri.va.packed},
+                {"samples", entry.pri.samples},
+                {"color_attachment_format", std::move(color)},
+                {"depth_stencil_attachment_format", static_cast<uint32_t>(entry.pri.depth_stencil_attachment_format)},
+            });
+        }
+        return json.dump(4);
+    }
+
+    std::vector<PipelineManifest::Entry> PipelineManifest::Deserialize(std::string_view content) noexcept {
+        try {
+            auto json = nlohmann::json::parse(content);
+            if (json.at("version").get<uint32_t>() != VERSION) return {};
+
+            std::vector<Entry> entries;
+            for (const auto &item : json.at("entries")) {
+                Entry entry{};
+                entry.library = GUID(item.at("library").get<std::string>());
+                entry.tag = item.at("tag").get<std::string>();
+                entry.pri.va.packed = item.at("vertex_attribute").get<uint64_t>();
+                entry.pri.samples = item.at("samples").get<uint8_t>();
+
+                const auto &color = item.at("color_attachment_format");
+                if (color.size() > COLOR_ATTACHMENT_COUNT) return {};
+                std::fill(
+                    std::begin(entry.pri.color_attachment_format),
+                    std::end(entry.pri.color_attachment_format),
+                    ImageUtils::ImageFormat::UNDEFINED
+                );
+                for (size_t i = 0; i < color.size(); i++) {
+                    entry.pri.color_attachment_format[i] =
+                        static_cast<ImageUtils::ImageFormat>(color[i].get<uint32_t>());
+                }
+                entry.pri.depth_stencil_attachment_format =
+                    static_cast<ImageUtils::ImageFormat>(item.at("depth_stencil_attachment_format").get<uint32_t>());
+                entries.push_back(std::move(entry));
+            }
+            return entries;
+        } catch (const std::exception &) {
+            return {};
+        }
+    }
+} // namespace Engine::RenderSystemState
@@ -0,0 +1,104 @@
+#ifndef RENDER_RENDERSYSTEM_PIPELINEMANIFEST_INCLUDED
+#define RENDER_RENDERSYSTEM_PIPELINEMANIFEST_INCLUDED
+
+#include "Core/guid.h"
+#include "Render/Pipeline/PipelineRuntimeInfo.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Engine {
+    class RenderSystem;
+
+    namespace RenderSystemState {
+        /**
+         * @brief Manifest of the material pipelines created by a project, recorded
+         * at runtime and replayed at load time.
+         *
+         * `MaterialLibrary` records every material template it creates. `Preheat()`
+         * creates the pipelines of all recorded entries ahead of their first draw,
+         * so that they are not created in the middle of the game.
+         *
+         * Like `PipelineCache`, the manifest starts empty, `Load()` fills it from a
+         * file and sets the file that `Save()` writes back to, and it is saved when
+         * destroyed if it changed. Unlike the pipeline cache, it does not depend on
+         * the device.
+         */
+        class PipelineManifest {
+        public:
+            struct Entry {
+                /// GUID of the material library asset.
+                GUID library;
+                std::string tag;
+                PipelineRuntimeInfo pri;
+
+                bool operator==(const Entry &) const noexcept = default;
+            };
+
+            PipelineManifest() = default;
+            ~PipelineManifest() noexcept;
+
+            PipelineManifest(const PipelineManifest &) = delete;
+            void operator=(const PipelineManifest &) = delete;
+
+            /**
+             * @brief Load entries from a file, and save to it from now on.
+             *
+             * Entries already recorded are kept, and entries of nil libraries are dropped.
+             * Missing or malformed files are ignored.
+             *
+             * @return Whether entries were loaded from the file.
+             */
+            bool Load(const std::filesystem::path &path);
+
+            /**
+             * @brief Write the entries to the file set by `Load()`.
+             *
+             * @return Whether the file was written.
+             */
+            bool Save() const;
+
+            /**
+             * @brief Record a material template.
+             *
+             * Templates of libraries not loaded from an asset have a nil library GUID,
+             * cannot be found again by `Preheat()`, and are not recorded.
+             * @return Whether it was recorded, and was not recorded yet.
+             */
+            bool Record(const GUID &library, const std::string &tag, const PipelineRuntimeInfo &pri);
+
+            const std::vector<Entry> &GetEntries() const noexcept;
+
+            /**
+             * @brief Create the pipelines of all entries.
+             *
+             * Pipelines are created in parallel if the render system has a job system,
+             * and this method returns when all of them are created. Entries whose
+             * library or tag no longer exists are removed from the manifest.
+             *
+             * @param progress Called on the calling thread whenever an entry is done,
+             * with the count of done entries and the count of all entries.
+             */
+            void Preheat(RenderSystem &system, const std::function<void(size_t, size_t)> &progress = {});
+
+            static std::string Serialize(const std::vector<Entry> &entries);
+
+            /**
+             * @brief Parse entries written by `Serialize()`.
+             * @return The entries, or an empty vector if the content is malformed.
+             */
+            static std::vector<Entry> Deserialize(std::string_view content) noexcept;
+
+        private:
+            std::vector<Entry> m_entries{};
+            std::filesystem::path m_path{};
+            bool m_dirty{false};
+        };
+    } // namespace RenderSystemState
+} // namespace Engine
+
+#endif // RENDER_RENDERSYSTEM_PIPELINEMANIFEST_INCLUDED
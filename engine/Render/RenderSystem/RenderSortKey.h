@@ -0,0 +1,90 @@
+#ifndef RENDER_RENDERSYSTEM_RENDERSORTKEY_INCLUDED
+#define RENDER_RENDERSYSTEM_RENDERSORTKEY_INCLUDED
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace Engine::RenderSystemState {
+    /**
+     * @brief Packing of the 64-bit sort keys of draws. Draws with smaller keys are recorded first.
+     *
+     * Every key starts with the index of the lowest layer of the renderer, followed by
+     * fields in the order of the sorting criterion:
+     * - ByMaterial: layer | pipeline | material | geometry | depth
+     * - ByDistance: layer | depth | pipeline | material
+     * - ByPriority: layer | priority | pipeline | material | depth
+     *
+     * The pipeline field identifies the material library, as draws of the same library
+     * and pass share the pipeline. The geometry field identifies the submesh, so that
+     * draws of the same submesh and material are adjacent and can be instanced. Depth is
+     * the squared distance to the camera quantized by truncating its float representation,
+     * which keeps the order of non-negative floats, so that draws are sorted front to back.
+     */
+    namespace RenderSortKey {
+        constexpr uint32_t LAYER_BITS = 5;
+        constexpr uint32_t PIPELINE_BITS = 12;
+        constexpr uint32_t MATERIAL_BITS = 20;
+        constexpr uint32_t PRIORITY_BITS = 8;
+        /// Geometry IDs are masked to their low 16 bits. Beyond 65536 geometries, draws of
+        /// different geometries may share the field and interleave, which only costs instancing:
+        /// draws are merged by comparing their full geometry IDs, never their keys.
+        constexpr uint32_t GEOMETRY_BITS = 16;
+
+        constexpr uint64_t Mask(uint64_t value, uint32_t bits) noexcept {
+            return value & ((uint64_t{1} << bits) - 1);
+        }
+
+        /**
+         * @brief Get the index of the lowest layer in a layer mask.
+         */
+        constexpr uint32_t LayerIndex(uint32_t layer_mask) noexcept {
+            return layer_mask == 0 ? 0 : static_cast<uint32_t>(std::countr_zero(layer_mask));
+        }
+
+        /**
+         * @brief Quantize a non-negative depth to its highest bits.
+         * @param depth The depth. Negative values and NaN are treated as zero.
+         * @param bits The count of bits of the result, at most 31.
+         */
+        inline uint64_t QuantizeDepth(float depth, uint32_t bits) noexcept {
+            if (!(depth > 0.0f)) return 0;
+            uint32_t representation;
+            std::memcpy(&representation, &depth, sizeof(float));
+            // The sign bit is zero.
+            return representation >> (31 - bits);
+        }
+
+        inline uint64_t ByMaterial(
+            uint32_t layer_mask, uint32_t pipeline, uint32_t material, uint32_t geometry, float depth
+        ) noexcept {
+            constexpr uint32_t DEPTH_BITS = 64 - LAYER_BITS - PIPELINE_BITS - MATERIAL_BITS - GEOMETRY_BITS;
+            uint64_t key = Mask(LayerIndex(layer_mask), LAYER_BITS);
+            key = (key << PIPELINE_BITS) | Mask(pipeline, PIPELINE_BITS);
+            key = (key << MATERIAL_BITS) | Mask(material, MATERIAL_BITS);
+            key = (key << GEOMETRY_BITS) | Mask(geometry, GEOMETRY_BITS);
+            return (key << DEPTH_BITS) | QuantizeDepth(depth, DEPTH_BITS);
+        }
+
+        inline uint64_t ByDistance(uint32_t layer_mask, uint32_t pipeline, uint32_t material, float depth) noexcept {
+            constexpr uint32_t DEPTH_BITS = 64 - LAYER_BITS - PIPELINE_BITS - MATERIAL_BITS;
+            uint64_t key = Mask(LayerIndex(layer_mask), LAYER_BITS);
+            key = (key << DEPTH_BITS) | QuantizeDepth(depth, DEPTH_BITS);
+            key = (key << PIPELINE_BITS) | Mask(pipeline, PIPELINE_BITS);
+            return (key << MATERIAL_BITS) | Mask(material, MATERIAL_BITS);
+        }
+
+        inline uint64_t ByPriority(
+            uint32_t layer_mask, uint8_t priority, uint32_t pipeline, uint32_t material, float depth
+        ) noexcept {
+            constexpr uint32_t DEPTH_BITS = 64 - LAYER_BITS - PRIORITY_BITS - PIPELINE_BITS - MATERIAL_BITS;
+            uint64_t key = Mask(LayerIndex(layer_mask), LAYER_BITS);
+            key = (key << PRIORITY_BITS) | priority;
+            key = (key << PIPELINE_BITS) | Mask(pipeline, PIPELINE_BITS);
+            key = (key << MATERIAL_BITS) | Mask(material, MATERIAL_BITS);
+            return (key << DEPTH_BITS) | QuantizeDepth(depth, DEPTH_BITS);
+        }
+    } // namespace RenderSortKey
+} // namespace Engine::RenderSystemState
+
+#endif // RENDER_RENDERSYSTEM_RENDERSORTKEY_INCLUDED
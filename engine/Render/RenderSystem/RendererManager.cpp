@@ -1,33 +1,131 @@
 #include "RendererManager.h"
 
 #include "Asset/Mesh/MeshAsset.h"
+#include "Core/RadixSort.h"
+#include "Core/SlotMap.h"
+#include "Render/Memory/IndexedBuffer.h"
+#include "Render/Memory/MeshBufferArena.h"
+#include "Render/Pipeline/Material/MaterialInstance.h"
+#include "Render/Pipeline/Material/MaterialLibrary.h"
+#include "Render/Pipeline/PipelineRuntimeInfo.h"
 #include "Render/RenderSystem.h"
+#include "Render/RenderSystem/CameraManager.h"
+#include "Render/RenderSystem/DeviceInterface.h"
+#include "Render/RenderSystem/DrawPacket.h"
 #include "Render/RenderSystem/FrameManager.h"
+#include "Render/RenderSystem/RenderSortKey.h"
 #include "Render/Renderer/StaticHomogeneousMesh.h"
 #include "Render/Resource/StaticMeshResource.h"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <deque>
 #include <memory>
-#include <unordered_set>
+#include <unordered_map>
 
 namespace Engine::RenderSystemState {
     struct RendererManager::impl {
-        struct RendererEntry {
-            int32_t pending_deallocation_countdown = -1;
-
+        // Per-entry data that is only touched when recording draws, owned by the slot map.
+        struct RendererResources {
             StaticMeshResourceHandle mesh_resource{};
             MaterialInstanceHandle material_resource{};
-            std::unique_ptr<IVertexBasedRenderer> renderer{};
+            StaticHomogeneousMesh renderer;
+
+            RendererResources(uint32_t submesh_index, StaticMeshResource *mesh) : renderer(submesh_index, mesh) {
+            }
+        };
+        using RendererMap = SlotMap<RendererResources>;
 
+        struct RendererInfo {
             uint32_t layer = 0xFFFFFFFF;
+            uint32_t submesh_index = 0;
+            // Dense ID of the material library, standing for the pipeline in sort keys.
+            uint32_t pipeline_id = 0;
+            uint32_t material_id = 0;
+            // Dense ID of the mesh resource and submesh, equal for renderers drawing the same geometry.
+            uint32_t geometry_id = 0;
+            uint8_t priority = 0;
             bool cast_shadow = false;
             bool is_eagerly_loaded = false;
+            // Whether local bounds have been fetched from the mesh resource.
+            bool has_bounds = false;
+            // Whether the entry is unregistered and waiting for deallocation.
+            bool is_retired = false;
+        };
+
+        /**
+         * Handles of live renderers matching one filter, kept up to date on
+         * registration and unregistration. Removals swap the last handle into the gap.
+         */
+        struct RenderList {
+            uint32_t layer;
+            FilterCriteria::BinaryCriterion is_shadow_caster;
+            RendererList handles{};
+            // Position of each renderer in handles, indexed by slot.
+            std::vector<uint32_t> positions{};
+
+            bool Matches(const RendererInfo &info) const noexcept {
+                if ((layer & info.layer) == 0) return false;
+                if (is_shadow_caster == FilterCriteria::BinaryCriterion::DontCare) return true;
+                return info.cast_shadow == static_cast<bool>(is_shadow_caster);
+            }
+
+            void Add(RendererHandle handle) {
+                uint32_t slot = RendererMap::GetIndex(handle);
+                if (slot >= positions.size()) positions.resize(slot + 1, RendererMap::INVALID_DENSE_INDEX);
+                positions[slot] = static_cast<uint32_t>(handles.size());
+                handles.push_back(handle);
+            }
 
-            glm::mat4 model_matrix{1.0f};
+            void Remove(RendererHandle handle) {
+                uint32_t slot = RendererMap::GetIndex(handle);
+                if (slot >= positions.size() || positions[slot] == RendererMap::INVALID_DENSE_INDEX) return;
+                uint32_t position = positions[slot];
+                handles[position] = handles.back();
+                positions[RendererMap::GetIndex(handles[position])] = position;
+                handles.pop_back();
+                positions[slot] = RendererMap::INVALID_DENSE_INDEX;
+            }
         };
 
-        uint32_t next_handle = 0;
-        std::unordered_map<RendererHandle, RendererEntry> m_data;
+        struct SortItem {
+            uint64_t key;
+            RendererHandle handle;
+        };
+
+        struct Pass {
+            std::string tag;
+            PipelineRuntimeInfoPerRendering pripr;
+            // Draw packets indexed by slot. A deque keeps packets in place as it grows.
+            std::deque<DrawPacket> packets{};
+        };
+
+        RendererMap m_renderers{};
+        // Parallel to the dense array of m_renderers.
+        std::vector<RendererInfo> m_infos{};
+        std::vector<glm::mat4> m_model_matrices{};
+        std::vector<AABB> m_local_bounds{};
+        std::vector<AABB> m_world_bounds{};
+
+        // Unregistered renderers with their remaining frame countdown.
+        std::vector<std::pair<RendererHandle, int32_t>> m_pending_deallocations{};
+        std::vector<RenderList> m_render_lists{};
+        std::vector<Pass> m_passes{};
+
+        std::unordered_map<const MaterialLibrary *, uint32_t> m_library_ids{};
+        // Keyed by mesh resource index and submesh index.
+        std::unordered_map<uint64_t, uint32_t> m_geometry_ids{};
+        // Kept across calls to reuse the storage.
+        std::vector<SortItem> m_sort_items{};
+        std::vector<SortItem> m_sort_scratch{};
+
+        // One slice of instance data per frame in flight, see WriteInstanceData.
+        std::unique_ptr<IndexedBuffer> m_instance_buffer{};
+        std::array<uint32_t, FrameManager::FRAMES_IN_FLIGHT> m_instance_cursors{};
+        // Null if indirect draws are not supported.
+        std::unique_ptr<IndexedBuffer> m_indirect_buffer{};
+        std::array<uint32_t, FrameManager::FRAMES_IN_FLIGHT> m_indirect_cursors{};
+        uint32_t m_max_draw_indirect_count{1};
 
         RendererHandle CreateRenderer(
             RenderSystem &system,
@@ -42,35 +140,232 @@ namespace Engine::RenderSystemState {
             auto &material_manager = system.GetRenderResourceManager<RenderSystemState::MaterialInstanceManager>();
 
             auto mesh_handle = mesh_manager.CreateOrReuseFromAsset(mesh_asset_ref.GetGUID());
-            if (eagerly_loaded) {
-                mesh_manager.Acquire(mesh_handle);
-            }
             auto *mesh = mesh_manager.Resolve(mesh_handle);
             assert(mesh);
-
             auto material_handle = material_manager.CreateOrReuseFromAsset(material_asset_ref.GetGUID());
+            auto *material = material_manager.Resolve(material_handle);
+
+            // Handles are acquired in place, so that no acquired handle is copied.
+            auto resources = std::make_unique<RendererResources>(submesh_index, mesh);
+            resources->mesh_resource = mesh_handle;
+            resources->material_resource = material_handle;
             if (eagerly_loaded) {
-                material_manager.Acquire(material_handle);
+                mesh_manager.Acquire(resources->mesh_resource);
+                material_manager.Acquire(resources->material_resource);
+            }
+
+            RendererInfo info{};
+            info.layer = layer;
+            info.submesh_index = submesh_index;
+            info.material_id = material_handle.index;
+            {
+                uint64_t geometry = (uint64_t{mesh_handle.index} << 32) | submesh_index;
+                auto id = static_cast<uint32_t>(m_geometry_ids.size());
+                info.geometry_id = m_geometry_ids.try_emplace(geometry, id).first->second;
+            }
+            if (material) {
+                auto id = static_cast<uint32_t>(m_library_ids.size());
+                info.pipeline_id = m_library_ids.try_emplace(&material->GetLibrary(), id).first->second;
+            }
+            info.cast_shadow = cast_shadow;
+            info.is_eagerly_loaded = eagerly_loaded;
+
+            auto handle = m_renderers.Allocate(resources.get());
+            m_renderers.Commit(handle, std::move(resources));
+            m_infos.push_back(info);
+            m_model_matrices.emplace_back(1.0f);
+            m_local_bounds.emplace_back();
+            m_world_bounds.emplace_back();
+
+            if (mesh->IsReady()) {
+                FetchBounds(static_cast<uint32_t>(m_infos.size() - 1), *mesh);
+            }
+            for (auto &list : m_render_lists) {
+                if (list.Matches(info)) list.Add(handle);
+            }
+            return handle;
+        }
+
+        void DestroyRenderer(RenderSystem &system, RendererHandle handle) {
+            uint32_t dense = m_renderers.GetDenseIndex(handle);
+            assert(dense != RendererMap::INVALID_DENSE_INDEX);
+            auto resources = m_renderers.Erase(handle);
+            system.GetRenderResourceManager<RenderSystemState::StaticMeshResourceManager>().Release(
+                resources->mesh_resource
+            );
+            system.GetRenderResourceManager<RenderSystemState::MaterialInstanceManager>().Release(
+                resources->material_resource
+            );
+
+            // Mirror the swap-and-pop of the slot map.
+            uint32_t last = static_cast<uint32_t>(m_infos.size() - 1);
+            if (dense != last) {
+                m_infos[dense] = m_infos[last];
+                m_model_matrices[dense] = m_model_matrices[last];
+                m_local_bounds[dense] = m_local_bounds[last];
+                m_world_bounds[dense] = m_world_bounds[last];
+            }
+            m_infos.pop_back();
+            m_model_matrices.pop_back();
+            m_local_bounds.pop_back();
+            m_world_bounds.pop_back();
+        }
+
+        RenderList &GetRenderList(uint32_t layer, FilterCriteria::BinaryCriterion is_shadow_caster) {
+            for (auto &list : m_render_lists) {
+                if (list.layer == layer && list.is_shadow_caster == is_shadow_caster) return list;
+            }
+
+            // Built once on first use, then maintained incrementally.
+            auto &list = m_render_lists.emplace_back(RenderList{layer, is_shadow_caster});
+            const auto &keys = m_renderers.GetDenseKeys();
+            for (size_t i = 0; i < keys.size(); i++) {
+                if (!m_infos[i].is_retired && list.Matches(m_infos[i])) list.Add(keys[i]);
             }
+            return list;
+        }
+
+        void SetModelMatrix(uint32_t dense, const glm::mat4 &matrix) noexcept {
+            m_model_matrices[dense] = matrix;
+            if (m_infos[dense].has_bounds) m_world_bounds[dense] = m_local_bounds[dense].Transformed(matrix);
+        }
 
-            auto &d = m_data[next_handle];
-            d.pending_deallocation_countdown = -1;
-            d.mesh_resource = mesh_handle;
-            d.material_resource = material_handle;
-            d.renderer = std::make_unique<StaticHomogeneousMesh>(submesh_index, mesh);
-            d.layer = layer;
-            d.cast_shadow = cast_shadow;
-            d.is_eagerly_loaded = eagerly_loaded;
+        void FetchBounds(uint32_t dense, const StaticMeshResource &mesh) noexcept {
+            m_local_bounds[dense] = mesh.GetSubmeshData(m_infos[dense].submesh_index).bounds;
+            m_infos[dense].has_bounds = true;
+            m_world_bounds[dense] = m_local_bounds[dense].Transformed(m_model_matrices[dense]);
+        }
+
+        const DrawPacket *BuildDrawPacket(RenderSystem &system, Pass &pass, RendererHandle handle) {
+            auto *resources = m_renderers.Get(handle);
+            if (!resources || !resources->renderer.IsReady()) return nullptr;
+            auto &material_manager = system.GetRenderResourceManager<RenderSystemState::MaterialInstanceManager>();
+            material_manager.EnsureReady(resources->material_resource);
+            auto *material = material_manager.Resolve(resources->material_resource);
+            if (!material) return nullptr;
+
+            const auto &renderer = resources->renderer;
+            const auto &info = m_infos[m_renderers.GetDenseIndex(handle)];
+            DrawPacket packet{};
+            packet.handle = handle;
+            packet.renderer = &renderer;
+            packet.material = material;
+            packet.library = &material->GetLibrary();
+            packet.library_generation = packet.library->GetGeneration();
+            packet.mesh_generation = system.GetMeshBufferArena().GetGeneration();
+            packet.geometry_id = info.geometry_id;
+            packet.material_id = info.material_id;
+
+            auto request = material->GetLibrary().RequestMaterialTemplate(
+                pass.tag, {{renderer.GetVertexAttributeFormat()}, pass.pripr}
+            );
+            packet.material_template = request.material_template;
+            packet.template_pending = request.status == MaterialLibrary::TemplateStatus::Pending;
+            if (packet.material_template) {
+                packet.pipeline = packet.material_template->GetPipeline();
+                packet.pipeline_layout = packet.material_template->GetPipelineLayout();
+                packet.supports_instancing = packet.material_template->SupportsInstancing();
+            }
+
+            IVertexBasedRenderer::VertexBufferBindings bindings;
+            renderer.FillVertexAttributeBufferBindings(bindings);
+            for (const auto &binding : bindings) {
+                packet.vertex_buffers.push_back(binding.buffer->GetBuffer());
+                packet.vertex_offsets.push_back(binding.offset);
+            }
+            auto indices = renderer.GetIndexBufferBinding();
+            packet.index_buffer = indices.buffer->GetBuffer();
+            packet.index_offset = indices.offset;
+            packet.index_count = renderer.GetIndexCount();
+            packet.first_index = renderer.GetFirstIndex();
+            packet.vertex_offset = renderer.GetVertexOffset();
+
+            uint32_t slot = RendererMap::GetIndex(handle);
+            if (slot >= pass.packets.size()) pass.packets.resize(slot + 1);
+            pass.packets[slot] = packet;
+            return &pass.packets[slot];
+        }
+
+        void Sort(RendererList &list, SortingCriterion sc, const glm::vec3 &camera_position) {
+            m_sort_items.clear();
+            m_sort_items.reserve(list.size());
+            for (auto handle : list) {
+                uint32_t dense = m_renderers.GetDenseIndex(handle);
+                const auto &info = m_infos[dense];
+                const auto &bounds = m_world_bounds[dense];
+                glm::vec3 position = bounds.IsEmpty() ? glm::vec3(m_model_matrices[dense][3]) : bounds.GetCenter();
+                glm::vec3 offset = position - camera_position;
+                float depth = glm::dot(offset, offset);
+
+                uint64_t key = 0;
+                switch (sc) {
+                case SortingCriterion::ByMaterial:
+                    key = RenderSortKey::ByMaterial(
+                        info.layer, info.pipeline_id, info.material_id, info.geometry_id, depth
+                    );
+                    break;
+                case SortingCriterion::ByDistanceToActiveCamera:
+                    key = RenderSortKey::ByDistance(info.layer, info.pipeline_id, info.material_id, depth);
+                    break;
+                case SortingCriterion::ByPriority:
+                    key = RenderSortKey::ByPriority(
+                        info.layer, info.priority, info.pipeline_id, info.material_id, depth
+                    );
+                    break;
+                case SortingCriterion::None:
+                    return;
+                }
+                m_sort_items.push_back({key, handle});
+            }
 
-            auto ret = next_handle++;
-            return ret;
+            RadixSort(m_sort_items, m_sort_scratch, [](const SortItem &item) { return item.key; });
+            for (size_t i = 0; i < list.size(); i++) {
+                list[i] = m_sort_items[i].handle;
+            }
         }
     };
 
     RendererManager::RendererManager(RenderSystem &system) : m_system(system), pimpl(std::make_unique<impl>()) {
     }
+
     RendererManager::~RendererManager() = default;
 
+    void RendererManager::Create() {
+        static_assert(sizeof(InstanceDataStruct) == sizeof(glm::mat4));
+        pimpl->m_instance_buffer = IndexedBuffer::CreateUnique(
+            m_system.GetAllocatorState(),
+            {BufferTypeBits::ShaderWrite, BufferTypeBits::HostRandomAccess},
+            sizeof(InstanceDataStruct) * MAX_INSTANCES_PER_FRAME,
+            m_system.GetDeviceInterface().QueryLimit(
+                DeviceInterface::PhysicalDeviceLimitInteger::StorageBufferOffsetAlignment
+            ),
+            FrameManager::FRAMES_IN_FLIGHT,
+            "Aggregated Instance Storage Buffer"
+        );
+        assert(pimpl->m_instance_buffer);
+        pimpl->m_instance_cursors.fill(1);
+
+        const auto &device = m_system.GetDeviceInterface();
+        if (!device.IsFeatureEnabled(DeviceInterface::PhysicalDeviceFeature::DrawIndirectFirstInstance)) {
+            SDL_LogInfo(
+                SDL_LOG_CATEGORY_RENDER, "Indirect draws with first instance are not supported, using direct draws."
+            );
+            return;
+        }
+        pimpl->m_max_draw_indirect_count =
+            device.QueryLimit(DeviceInterface::PhysicalDeviceLimitInteger::MaxDrawIndirectCount);
+        pimpl->m_indirect_buffer = IndexedBuffer::CreateUnique(
+            m_system.GetAllocatorState(),
+            {BufferTypeBits::IndirectDrawCommand, BufferTypeBits::HostRandomAccess},
+            sizeof(IndirectDrawCommand) * MAX_INDIRECT_COMMANDS_PER_FRAME,
+            // Indirect buffer offsets must be multiples of four.
+            sizeof(uint32_t),
+            FrameManager::FRAMES_IN_FLIGHT,
+            "Aggregated Indirect Command Buffer"
+        );
+        pimpl->m_indirect_cursors.fill(0);
+    }
+
     RendererHandle RendererManager::RegisterRenderer(
         AssetRef mesh_asset_ref,
         AssetRef material_asset_ref,
@@ -85,79 +380,197 @@ namespace Engine::RenderSystemState {
     }
 
     void RendererManager::Unregister(RendererHandle handle) {
-        auto it = pimpl->m_data.find(handle);
-        if (it == pimpl->m_data.end()) return;
-        it->second.pending_deallocation_countdown = FrameManager::FRAMES_IN_FLIGHT;
+        uint32_t dense = pimpl->m_renderers.GetDenseIndex(handle);
+        if (dense == impl::RendererMap::INVALID_DENSE_INDEX) return;
+        auto &info = pimpl->m_infos[dense];
+        if (info.is_retired) return;
+        info.is_retired = true;
+        for (auto &list : pimpl->m_render_lists) {
+            list.Remove(handle);
+        }
+        pimpl->m_pending_deallocations.emplace_back(handle, FrameManager::FRAMES_IN_FLIGHT);
     }
 
     void RendererManager::UpdateModelMatrix(RendererHandle handle, const glm::mat4 &matrix) {
-        auto it = pimpl->m_data.find(handle);
-        if (it == pimpl->m_data.end()) return;
-        it->second.model_matrix = matrix;
+        uint32_t dense = pimpl->m_renderers.GetDenseIndex(handle);
+        if (dense == impl::RendererMap::INVALID_DENSE_INDEX) return;
+        pimpl->SetModelMatrix(dense, matrix);
+    }
+
+    void RendererManager::UpdateModelMatrices(const RendererList &handles, const std::vector<glm::mat4> &matrices) {
+        assert(handles.size() == matrices.size());
+        for (size_t i = 0; i < handles.size(); i++) {
+            uint32_t dense = pimpl->m_renderers.GetDenseIndex(handles[i]);
+            if (dense == impl::RendererMap::INVALID_DENSE_INDEX) continue;
+            pimpl->SetModelMatrix(dense, matrices[i]);
+        }
     }
 
     void RendererManager::PerformPendingCleanUp() {
-        auto &mesh_manager = m_system.GetRenderResourceManager<RenderSystemState::StaticMeshResourceManager>();
-        auto &material_manager = m_system.GetRenderResourceManager<RenderSystemState::MaterialInstanceManager>();
-        for (auto it = pimpl->m_data.begin(); it != pimpl->m_data.end();) {
-            if (it->second.pending_deallocation_countdown < 0) {
-                ++it;
+        auto &pending = pimpl->m_pending_deallocations;
+        for (size_t i = 0; i < pending.size();) {
+            if (--pending[i].second > 0) {
+                ++i;
                 continue;
             }
-            it->second.pending_deallocation_countdown -= 1;
-            if (it->second.pending_deallocation_countdown == 0) {
-                mesh_manager.Release(it->second.mesh_resource);
-                material_manager.Release(it->second.material_resource);
-                it = pimpl->m_data.erase(it);
-            } else {
-                ++it;
-            }
+            pimpl->DestroyRenderer(m_system, pending[i].first);
+            pending[i] = pending.back();
+            pending.pop_back();
         }
     }
 
     RendererList RendererManager::FilterAndSortRenderers(FilterCriteria fc, SortingCriterion sc) {
-        assert(sc == SortingCriterion::None && "Unimplemented");
-        std::unordered_set<uint32_t> filtered_renderers{};
-
         auto &mesh_manager = m_system.GetRenderResourceManager<RenderSystemState::StaticMeshResourceManager>();
-        for (auto &[handle, entry] : pimpl->m_data) {
-            if (entry.pending_deallocation_countdown >= 0) continue;
-
-            if ((fc.layer & entry.layer) == 0) continue;
-            if (fc.is_shadow_caster != FilterCriteria::BinaryCriterion::DontCare) {
-                if (entry.cast_shadow != static_cast<int>(fc.is_shadow_caster)) continue;
-            }
+        const auto &list = pimpl->GetRenderList(fc.layer, fc.is_shadow_caster);
+        const auto &resources = pimpl->m_renderers.GetDense();
 
-            if (!mesh_manager.IsReady(entry.mesh_resource)) {
+        RendererList ret{};
+        ret.reserve(list.handles.size());
+        for (auto handle : list.handles) {
+            uint32_t dense = pimpl->m_renderers.GetDenseIndex(handle);
+            auto &mesh_resource = resources[dense]->mesh_resource;
+            if (!mesh_manager.IsReady(mesh_resource)) {
                 // TODO: After asynchronous resource loading is implemented, we should not 'EnsureReady' renderers with non-ready resources.
                 // Instead, we should trigger their resource loading and include them in the filtered list, so that they can be rendered as soon as they are ready.
-                mesh_manager.EnsureReady(entry.mesh_resource);
+                mesh_manager.EnsureReady(mesh_resource);
             }
-            filtered_renderers.insert(handle);
+            if (!pimpl->m_infos[dense].has_bounds && mesh_manager.IsReady(mesh_resource)) {
+                pimpl->FetchBounds(dense, *mesh_manager.Resolve(mesh_resource));
+            }
+            // Entries with unknown bounds are kept.
+            const auto &bounds = pimpl->m_world_bounds[dense];
+            if (fc.frustum && !bounds.IsEmpty() && !fc.frustum->Intersects(bounds)) continue;
+            ret.push_back(handle);
         }
 
-        RendererList ret{};
-        ret.reserve(filtered_renderers.size());
-        for (auto i : filtered_renderers) ret.push_back(i);
+        if (sc != SortingCriterion::None) {
+            auto &camera_manager = m_system.GetCameraManager();
+            pimpl->Sort(ret, sc, camera_manager.GetCameraPosition(camera_manager.GetActiveCameraIndex()));
+        }
         return ret;
     }
 
     const IVertexBasedRenderer *RendererManager::GetRenderer(RendererHandle handle) const noexcept {
-        auto it = pimpl->m_data.find(handle);
-        assert(it != pimpl->m_data.end());
-        return it->second.renderer.get();
+        auto *resources = pimpl->m_renderers.Get(handle);
+        assert(resources);
+        return &resources->renderer;
     }
 
     MaterialInstanceHandle RendererManager::GetMaterialResourceHandle(RendererHandle handle) const noexcept {
-        auto it = pimpl->m_data.find(handle);
-        assert(it != pimpl->m_data.end());
-        return it->second.material_resource;
+        auto *resources = pimpl->m_renderers.Get(handle);
+        assert(resources);
+        return resources->material_resource;
     }
 
     const glm::mat4 &RendererManager::GetModelMatrix(RendererHandle handle) const noexcept {
-        auto it = pimpl->m_data.find(handle);
-        assert(it != pimpl->m_data.end());
-        return it->second.model_matrix;
+        uint32_t dense = pimpl->m_renderers.GetDenseIndex(handle);
+        assert(dense != impl::RendererMap::INVALID_DENSE_INDEX);
+        return pimpl->m_model_matrices[dense];
+    }
+
+    void RendererManager::SetPriority(RendererHandle handle, uint8_t priority) {
+        uint32_t dense = pimpl->m_renderers.GetDenseIndex(handle);
+        if (dense == impl::RendererMap::INVALID_DENSE_INDEX) return;
+        pimpl->m_infos[dense].priority = priority;
+    }
+
+    bool RendererManager::IsSameDraw(RendererHandle lhs, RendererHandle rhs) const noexcept {
+        uint32_t l = pimpl->m_renderers.GetDenseIndex(lhs), r = pimpl->m_renderers.GetDenseIndex(rhs);
+        assert(l != impl::RendererMap::INVALID_DENSE_INDEX && r != impl::RendererMap::INVALID_DENSE_INDEX);
+        return pimpl->m_infos[l].geometry_id == pimpl->m_infos[r].geometry_id
+               && pimpl->m_infos[l].material_id == pimpl->m_infos[r].material_id;
+    }
+
+    void RendererManager::ResetInstanceData(uint32_t frame_in_flight) noexcept {
+        assert(frame_in_flight < pimpl->m_instance_cursors.size());
+        // Instance zero is never written, it marks draws without instance data.
+        pimpl->m_instance_cursors[frame_in_flight] = 1;
+        pimpl->m_indirect_cursors[frame_in_flight] = 0;
+    }
+
+    uint32_t RendererManager::WriteInstanceData(
+        uint32_t frame_in_flight, const RendererHandle *handles, uint32_t count
+    ) noexcept {
+        auto &cursor = pimpl->m_instance_cursors[frame_in_flight];
+        if (!pimpl->m_instance_buffer || cursor + count > MAX_INSTANCES_PER_FRAME) return 0;
+
+        auto data = static_cast<InstanceDataStruct *>(pimpl->m_instance_buffer->GetSlicePtr(frame_in_flight));
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t dense = pimpl->m_renderers.GetDenseIndex(handles[i]);
+            assert(dense != impl::RendererMap::INVALID_DENSE_INDEX);
+            data[cursor + i].model_matrix = pimpl->m_model_matrices[dense];
+        }
+        uint32_t first = cursor;
+        cursor += count;
+        return first;
+    }
+
+    void RendererManager::FlushInstanceData(uint32_t frame_in_flight) const {
+        if (pimpl->m_instance_buffer) pimpl->m_instance_buffer->FlushSlice(frame_in_flight);
+        if (pimpl->m_indirect_buffer) pimpl->m_indirect_buffer->FlushSlice(frame_in_flight);
+    }
+
+    const IndexedBuffer &RendererManager::GetInstanceBuffer() const noexcept {
+        assert(pimpl->m_instance_buffer);
+        return *pimpl->m_instance_buffer;
+    }
+
+    bool RendererManager::SupportsIndirectDraw() const noexcept {
+        return pimpl->m_indirect_buffer != nullptr;
+    }
+
+    uint32_t RendererManager::GetMaxDrawIndirectCount() const noexcept {
+        return pimpl->m_max_draw_indirect_count;
+    }
+
+    uint32_t RendererManager::WriteIndirectCommands(
+        uint32_t frame_in_flight, const IndirectDrawCommand *commands, uint32_t count
+    ) noexcept {
+        auto &cursor = pimpl->m_indirect_cursors[frame_in_flight];
+        if (!pimpl->m_indirect_buffer || cursor + count > MAX_INDIRECT_COMMANDS_PER_FRAME) {
+            return INVALID_INDIRECT_COMMAND;
+        }
+
+        auto data = static_cast<IndirectDrawCommand *>(pimpl->m_indirect_buffer->GetSlicePtr(frame_in_flight));
+        std::copy(commands, commands + count, data + cursor);
+        uint32_t first = cursor;
+        cursor += count;
+        return first;
+    }
+
+    const IndexedBuffer &RendererManager::GetIndirectBuffer() const noexcept {
+        assert(pimpl->m_indirect_buffer);
+        return *pimpl->m_indirect_buffer;
+    }
+
+    uint32_t RendererManager::GetPassID(const std::string &tag, const PipelineRuntimeInfoPerRendering &pripr) {
+        auto &passes = pimpl->m_passes;
+        for (uint32_t i = 0; i < passes.size(); i++) {
+            if (passes[i].tag == tag && passes[i].pripr == pripr) return i;
+        }
+        passes.push_back({tag, pripr});
+        return static_cast<uint32_t>(passes.size() - 1);
+    }
+
+    const DrawPacket *RendererManager::GetDrawPacket(uint32_t pass_id, RendererHandle handle) {
+        assert(pass_id < pimpl->m_passes.size());
+        auto &pass = pimpl->m_passes[pass_id];
+        uint32_t slot = impl::RendererMap::GetIndex(handle);
+        if (slot < pass.packets.size()) {
+            const auto &packet = pass.packets[slot];
+            if (packet.handle == handle && !packet.template_pending
+                && packet.library->GetGeneration() == packet.library_generation
+                && m_system.GetMeshBufferArena().GetGeneration() == packet.mesh_generation) {
+                return &packet;
+            }
+        }
+        return pimpl->BuildDrawPacket(m_system, pass, handle);
+    }
+
+    const AABB &RendererManager::GetWorldBounds(RendererHandle handle) const noexcept {
+        uint32_t dense = pimpl->m_renderers.GetDenseIndex(handle);
+        assert(dense != impl::RendererMap::INVALID_DENSE_INDEX);
+        return pimpl->m_world_bounds[dense];
     }
 
     vk::PushConstantRange RendererManager::GetPushConstantRange() {
@@ -1,11 +1,14 @@
 #ifndef RENDER_RENDERSYSTEM_RENDERERMANAGER_INCLUDED
 #define RENDER_RENDERSYSTEM_RENDERERMANAGER_INCLUDED
 
+#include "Core/Math/Frustum.h"
 #include "Framework/world/Handle.h"
 #include "Render/Resource/RenderResourceHandle.h"
 
 #include <glm.hpp>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace vk {
@@ -14,10 +17,14 @@ namespace vk {
 
 namespace Engine {
     class AssetRef;
+    class IndexedBuffer;
     class IVertexBasedRenderer;
     class RenderSystem;
+    struct PipelineRuntimeInfoPerRendering;
 
     namespace RenderSystemState {
+        struct DrawPacket;
+
         /**
          * @brief Runtime draw-entry registry for mesh/material rendering.
          *
@@ -29,6 +36,15 @@ namespace Engine {
          *   this class only retains/release resource handles per entry.
          * - Destruction is deferred by frame-in-flight policy to avoid releasing
          *   resources still referenced by in-flight command buffers.
+         * - Entries live in a generational slot map. Data read by filtering and
+         *   drawing (model matrices, bounds, flags) is kept in dense parallel
+         *   arrays, so handle lookups are O(1) and stale handles are ignored.
+         * - Filter results for each (layer, shadow-caster) combination are kept
+         *   as render lists, built on first use and then updated on register and
+         *   unregister instead of being rebuilt every pass.
+         * - Everything needed to record the draw of an entry in a pass is cached
+         *   as a DrawPacket, so that recording a list of entries does not look up
+         *   materials, templates and buffers again.
          *
          * "Caller" in this interface means upper-layer runtime owners of render
          * entries (for example renderer-related components/systems) that:
@@ -53,6 +69,40 @@ namespace Engine {
                 int32_t camera_index;
             };
 
+            /**
+             * @brief Per-instance data of instanced draws, read from the instance buffer
+             * by shaders. Matches `InstanceDataStruct` in "engine/interface.glsl".
+             */
+            struct InstanceDataStruct {
+                glm::mat4 model_matrix;
+            };
+
+            /**
+             * @brief Capacity of the instance buffer of one frame in flight.
+             */
+            static constexpr uint32_t MAX_INSTANCES_PER_FRAME = 16384;
+
+            /**
+             * @brief An indexed indirect draw command, laid out as `VkDrawIndexedIndirectCommand`.
+             */
+            struct IndirectDrawCommand {
+                uint32_t index_count;
+                uint32_t instance_count;
+                uint32_t first_index;
+                int32_t vertex_offset;
+                uint32_t first_instance;
+            };
+
+            /**
+             * @brief Capacity of the indirect command buffer of one frame in flight.
+             */
+            static constexpr uint32_t MAX_INDIRECT_COMMANDS_PER_FRAME = 8192;
+
+            /**
+             * @brief Returned by WriteIndirectCommands when the indirect command buffer is full.
+             */
+            static constexpr uint32_t INVALID_INDIRECT_COMMAND = 0xFFFFFFFF;
+
             /**
              * @brief Filter options applied in FilterAndSortRenderers.
              */
@@ -65,12 +115,20 @@ namespace Engine {
 
                 BinaryCriterion is_shadow_caster{BinaryCriterion::DontCare};
                 uint32_t layer{0xFFFFFFFF};
+                /// Renderers whose world-space bounds are outside the frustum are culled.
+                /// Renderers whose bounds are not known yet are never culled.
+                std::optional<Frustum> frustum{};
             };
 
             /**
              * @brief Sorting modes for filtered renderers.
              *
-             * Only None is currently implemented.
+             * Renderers are sorted by packed 64-bit keys, see RenderSortKey.
+             * Ties between renderers are broken front to back.
+             * - None: unspecified order.
+             * - ByPriority: by the priority set with SetPriority, then by material.
+             * - ByMaterial: by pipeline and material, to reduce rebinds.
+             * - ByDistanceToActiveCamera: front to back, for early depth testing.
              */
             enum class SortingCriterion {
                 None,
@@ -85,6 +143,12 @@ namespace Engine {
             RendererManager(RenderSystem &system);
             ~RendererManager();
 
+            /**
+             * @brief Allocate the instance buffer, and the indirect command buffer if indirect
+             * draws are supported. Must be called before CameraManager::Create().
+             */
+            void Create();
+
             /**
              * @brief Register one submesh draw entry and return its handle.
              *
@@ -122,6 +186,12 @@ namespace Engine {
              */
             void Unregister(RendererHandle handle);
 
+            /**
+             * @brief Set the priority of a renderer used by SortingCriterion::ByPriority.
+             * Renderers with lower priority are drawn first. The default priority is zero.
+             */
+            void SetPriority(RendererHandle handle, uint8_t priority);
+
             /**
              * @brief Update the model matrix for a renderer.
              *
@@ -129,6 +199,14 @@ namespace Engine {
              */
             void UpdateModelMatrix(RendererHandle handle, const glm::mat4 &matrix);
 
+            /**
+             * @brief Update the model matrices for a batch of renderers.
+             *
+             * Equivalent to calling UpdateModelMatrix for each pair of
+             * handles[i] and matrices[i].
+             */
+            void UpdateModelMatrices(const RendererList &handles, const std::vector<glm::mat4> &matrices);
+
             /**
              * @brief Advance deferred cleanup and release fully retired entries.
              *
@@ -141,11 +219,16 @@ namespace Engine {
              * @brief Build draw list by filtering (and optional sorting).
              *
              * Current behavior:
-             * - skips retired entries,
-             * - applies layer and shadow-caster criteria,
-             * - checks mesh resource readiness through RenderResourceManager.
+             * - starts from the render list of the layer and shadow-caster criteria,
+             *   which holds no retired entries,
+             * - checks mesh resource readiness through RenderResourceManager,
+             * - culls entries outside the frustum, if one is given.
+             *
+             * World-space bounds are the submesh bounds of the mesh resource
+             * transformed by the model matrix. They are known once the mesh
+             * resource is ready, and updated with the model matrix.
              *
-             * @note Sorting modes other than None are currently unimplemented.
+             * Distances are measured from the active camera of CameraManager.
              */
             RendererList FilterAndSortRenderers(FilterCriteria fc, SortingCriterion sc = SortingCriterion::None);
 
@@ -165,6 +248,98 @@ namespace Engine {
              */
             const glm::mat4 &GetModelMatrix(RendererHandle handle) const noexcept;
 
+            /**
+             * @brief Check whether two renderers draw the same submesh with the same material
+             * instance, so that they can be merged into one instanced draw.
+             */
+            bool IsSameDraw(RendererHandle lhs, RendererHandle rhs) const noexcept;
+
+            /**
+             * @brief Discard the instance data and indirect commands written for a frame in flight.
+             * Called when the frame starts.
+             */
+            void ResetInstanceData(uint32_t frame_in_flight) noexcept;
+
+            /**
+             * @brief Write the model matrices of renderers to the instance buffer of a frame in flight.
+             *
+             * The data is read by shaders at `gl_InstanceIndex`, so the returned index
+             * is used as the first instance of the instanced draw.
+             *
+             * @return The index of the first written instance, or zero if the buffer is full,
+             * in which case the renderers should be drawn one by one.
+             */
+            uint32_t WriteInstanceData(
+                uint32_t frame_in_flight, const RendererHandle *handles, uint32_t count
+            ) noexcept;
+
+            /**
+             * @brief Make the instance data and indirect commands written for a frame in flight
+             * visible to the device.
+             */
+            void FlushInstanceData(uint32_t frame_in_flight) const;
+
+            /**
+             * @brief Get the instance buffer, with one slice per frame in flight.
+             */
+            const IndexedBuffer &GetInstanceBuffer() const noexcept;
+
+            /**
+             * @brief Check whether instanced draws can be submitted as indirect draws, i.e. the
+             * device supports indirect draws with a non-zero first instance.
+             */
+            bool SupportsIndirectDraw() const noexcept;
+
+            /**
+             * @brief Get the largest draw count of one indirect draw call,
+             * which is one if multi-draw indirect is not supported.
+             */
+            uint32_t GetMaxDrawIndirectCount() const noexcept;
+
+            /**
+             * @brief Write indirect draw commands to the indirect command buffer of a frame in flight.
+             *
+             * @return The index of the first written command in the slice of the frame,
+             * or `INVALID_INDIRECT_COMMAND` if the buffer is full or indirect draws are not supported.
+             */
+            uint32_t WriteIndirectCommands(
+                uint32_t frame_in_flight, const IndirectDrawCommand *commands, uint32_t count
+            ) noexcept;
+
+            /**
+             * @brief Get the indirect command buffer, with one slice per frame in flight.
+             * Only valid if `SupportsIndirectDraw()`.
+             */
+            const IndexedBuffer &GetIndirectBuffer() const noexcept;
+
+            /**
+             * @brief Get the ID of a pass, i.e. a pass tag and attachment formats, used to look up
+             * draw packets. IDs stay valid for the lifetime of the manager.
+             *
+             * Passes are few, so the lookup is linear. Call it once per list of renderers.
+             */
+            uint32_t GetPassID(const std::string &tag, const PipelineRuntimeInfoPerRendering &pripr);
+
+            /**
+             * @brief Get the draw packet of a renderer in a pass.
+             *
+             * The packet is built on first use, or if it is stale, i.e. the renderer
+             * handle, the material library or the mesh buffer arena changed since it
+             * was built, or its material template was pending. Building it makes the
+             * material instance ready and requests the material template of the pass,
+             * whose pipeline may be created in the background.
+             *
+             * @return Null if the renderer is not alive or its resources are not ready.
+             * Otherwise a pointer that stays valid until the packet is rebuilt.
+             */
+            const DrawPacket *GetDrawPacket(uint32_t pass_id, RendererHandle handle);
+
+            /**
+             * @brief Get the world-space bounding box of a renderer.
+             * @return An empty box if the bounds are not known yet.
+             */
+            const AABB &GetWorldBounds(RendererHandle handle) const noexcept;
+
             /**
              * @brief Return push-constant range definition for draw data.
              */
@@ -295,6 +295,11 @@ namespace Engine::RenderSystemState {
         return pimpl->scene.light_front_buffer.shadow_casting_light_count;
     }
 
+    glm::mat4 SceneDataManager::GetLightMatrix(uint32_t index) const noexcept {
+        assert(index < MAX_SHADOW_CASTING_LIGHTS);
+        return pimpl->scene.light_front_buffer.shadow_casting.light_matrices[index];
+    }
+
     void SceneDataManager::SetLightCountNonShadowCasting(uint32_t count) noexcept {
         assert(count < MAX_NON_SHADOW_CASTING_LIGHTS);
         pimpl->scene.light_front_buffer.non_shadow_casting_light_count = count;
@@ -397,6 +402,7 @@ namespace Engine::RenderSystemState {
         );
         // Vertex info is embedded in the skybox.vert shader.
         rcb.draw(36, 1, 0, 0);
+        cb.InvalidateBoundState();
     }
 
     vk::DescriptorSet SceneDataManager::GetLightDescriptorSet(uint32_t frame_in_flight) const noexcept {
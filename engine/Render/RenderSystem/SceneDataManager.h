@@ -132,6 +132,11 @@ namespace Engine {
              */
             uint32_t GetNumShadowCastingLights() const noexcept;
 
+            /**
+             * @brief Get the projection * view matrix used in shadow mapping of a shadow-casting light.
+             */
+            glm::mat4 GetLightMatrix(uint32_t index) const noexcept;
+
             /**
              * @brief Set how many none shadow-casting lights are there in the scene.
              *
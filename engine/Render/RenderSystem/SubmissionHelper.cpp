@@ -162,10 +162,11 @@ namespace Engine::RenderSystemState {
             throw std::invalid_argument("Too many bytes of data are submitted to the buffer.");
         }
 
+        // Only the submitted range is staged, as the buffer may be a large shared one.
         auto staging_buffer = DeviceBuffer::CreateUnique(
-            this->m_system.GetAllocatorState(), {BufferTypeBits::StagingToDevice}, buffer.GetSize(), "Staging buffer"
+            this->m_system.GetAllocatorState(), {BufferTypeBits::StagingToDevice}, data.size_bytes(), "Staging buffer"
         );
-        std::memcpy(staging_buffer->GetVMAddress(), data.data(), buffer.GetSize());
+        std::memcpy(staging_buffer->GetVMAddress(), data.data(), data.size_bytes());
         staging_buffer->Flush();
 
         auto enqueued = [data, &buffer, this, pbuf = staging_buffer.get(), buffer_offset](vk::CommandBuffer cb) {
@@ -205,6 +206,31 @@ namespace Engine::RenderSystemState {
         pimpl->m_pending_operations.push(enqueued);
     }
 
+    void SubmissionHelper::EnqueueBufferCopy(
+        const DeviceBuffer &src, const DeviceBuffer &dst, std::span<const BufferCopyRegion> regions
+    ) {
+        if (regions.empty()) return;
+        std::vector<vk::BufferCopy> copies;
+        copies.reserve(regions.size());
+        for (const auto &region : regions) {
+            if (region.src_offset + region.size > src.GetSize() || region.dst_offset + region.size > dst.GetSize()) {
+                throw std::invalid_argument("Buffer copy region out of range.");
+            }
+            copies.push_back({region.src_offset, region.dst_offset, region.size});
+        }
+
+        auto enqueued = [&src, &dst, copies = std::move(copies)](vk::CommandBuffer cb) {
+            auto mbarrier = GetBufferBarrier(BufferTransferType::GeneralTransferBefore);
+            std::array<vk::MemoryBarrier2, 1> barriers{mbarrier};
+            cb.pipelineBarrier2(vk::DependencyInfo{{}, barriers, {}, {}});
+            cb.copyBuffer(src.GetBuffer(), dst.GetBuffer(), copies);
+
+            barriers[0] = GetBufferBarrier(BufferTransferType::GeneralTransferAfter);
+            cb.pipelineBarrier2(vk::DependencyInfo{{}, barriers, {}, {}});
+        };
+        pimpl->m_pending_operations.push(enqueued);
+    }
+
     void SubmissionHelper::EnqueueTextureBufferSubmission(const Texture &texture, std::span<const std::byte> data) {
         if (!(ImageUtils::GetVkAspect(texture.GetTextureDescription().format) & vk::ImageAspectFlagBits::eColor)) {
             throw std::invalid_argument("Selected texture does not contain color aspect.");
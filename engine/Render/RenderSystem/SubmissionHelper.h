@@ -22,6 +22,13 @@ namespace Engine {
             std::unique_ptr<impl> pimpl;
 
         public:
+            /// @brief A region copied by `EnqueueBufferCopy`.
+            struct BufferCopyRegion {
+                size_t src_offset;
+                size_t dst_offset;
+                size_t size;
+            };
+
             SubmissionHelper(RenderSystem &system);
             virtual ~SubmissionHelper();
 
@@ -37,6 +44,19 @@ namespace Engine {
                 const DeviceBuffer &buffer, std::span<const std::byte> data, size_t buffer_offset = 0
             );
 
+            /**
+             * @brief Enqueue copies between two device buffers.
+             *
+             * Both buffers must be kept alive until the submission completes.
+             *
+             * @param src Buffer to be copied from.
+             * @param dst Buffer to be copied to.
+             * @param regions Regions to be copied. They are copied immediately.
+             */
+            void EnqueueBufferCopy(
+                const DeviceBuffer &src, const DeviceBuffer &dst, std::span<const BufferCopyRegion> regions
+            );
+
             /**
              * @brief Enqueue a texture buffer submission. Record corresponding image
              * barriers and buffer writes to a disposable command buffer.
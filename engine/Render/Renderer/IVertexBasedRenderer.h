@@ -1,8 +1,10 @@
 #ifndef RENDER_RENDERER_IVERTEXBASEDRENDERER_INCLUDED
 #define RENDER_RENDERER_IVERTEXBASEDRENDERER_INCLUDED
 
+#include "Core/InlineVector.h"
+
+#include <cstddef>
 #include <cstdint>
-#include <vector>
 
 namespace Engine {
     class VertexAttribute;
@@ -27,6 +29,10 @@ namespace Engine {
             size_t size;
         };
 
+        /// Maximal count of vertex buffer bindings, i.e. one per vertex attribute semantic.
+        static constexpr size_t MAX_VERTEX_BUFFER_BINDINGS = 16;
+        using VertexBufferBindings = InlineVector<BufferBindingInfo, MAX_VERTEX_BUFFER_BINDINGS>;
+
         IVertexBasedRenderer() noexcept = default;
         virtual ~IVertexBasedRenderer() noexcept = default;
 
@@ -39,6 +45,24 @@ namespace Engine {
          */
         virtual uint32_t GetIndexCount() const noexcept = 0;
 
+        /**
+         * @brief Get the first index to draw, counted from the index buffer binding.
+         *
+         * Renderers whose data lives in buffers shared with other renderers
+         * use it together with `GetVertexOffset()`, so that their draws keep
+         * the same bindings and can be batched into indirect draws.
+         */
+        virtual uint32_t GetFirstIndex() const noexcept {
+            return 0;
+        }
+
+        /**
+         * @brief Get the value added to indices before fetching vertices.
+         */
+        virtual int32_t GetVertexOffset() const noexcept {
+            return 0;
+        }
+
         /**
          * @brief Get the count of vertex attributes of this renderer.
          */
@@ -57,17 +81,18 @@ namespace Engine {
          * the n-th item of this vector corresponds to the n-th used vertex
          * attribute slots, regardless of the actual location specified by
          * `layout(location = N)` in the shader.
+         * Filling more than `MAX_VERTEX_BUFFER_BINDINGS` bindings throws `std::length_error`.
          *
          * @see VertexAttribute::ToVkVertexInputBinding() const noexcept
          * etc. for more details on how pipeline vertex input is constructed.
          */
-        virtual void FillVertexAttributeBufferBindings(std::vector<BufferBindingInfo> &bindings) const noexcept = 0;
+        virtual void FillVertexAttributeBufferBindings(VertexBufferBindings &bindings) const = 0;
 
         /**
          * @brief Get vertex attribute buffer info for draw calls.
          */
-        std::vector<BufferBindingInfo> GetVertexAttributeBufferBindings() const noexcept {
-            std::vector<BufferBindingInfo> ret;
+        VertexBufferBindings GetVertexAttributeBufferBindings() const {
+            VertexBufferBindings ret;
             FillVertexAttributeBufferBindings(ret);
             return ret;
         };
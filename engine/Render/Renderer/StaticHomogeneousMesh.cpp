@@ -10,39 +10,44 @@ namespace Engine {
 
     uint32_t StaticHomogeneousMesh::GetIndexCount() const noexcept {
         const auto &submesh = m_resource->GetSubmeshData(m_submesh_index);
-        assert(submesh.vi_buffer);
+        assert(submesh.allocation);
         return submesh.index_count;
     }
 
     uint32_t StaticHomogeneousMesh::GetVertexAttributeCount() const noexcept {
         const auto &submesh = m_resource->GetSubmeshData(m_submesh_index);
-        assert(submesh.vi_buffer);
+        assert(submesh.allocation);
         return submesh.vertex_attribute_count;
     }
 
     VertexAttribute StaticHomogeneousMesh::GetVertexAttributeFormat() const noexcept {
         const auto &submesh = m_resource->GetSubmeshData(m_submesh_index);
-        assert(submesh.vi_buffer);
+        assert(submesh.allocation);
         return submesh.attributes;
     }
 
-    void StaticHomogeneousMesh::FillVertexAttributeBufferBindings(
-        std::vector<BufferBindingInfo> &bindings
-    ) const noexcept {
+    void StaticHomogeneousMesh::FillVertexAttributeBufferBindings(VertexBufferBindings &bindings) const {
         const auto &submesh_ref = m_resource->GetSubmeshData(m_submesh_index);
-        assert(submesh_ref.vi_buffer);
-        bindings.reserve(submesh_ref.attribute_offsets.size());
-        for (auto offset : submesh_ref.attribute_offsets) {
-            bindings.push_back({submesh_ref.vi_buffer.get(), offset, 0});
-        }
-        // Last offset is for indices.
-        bindings.pop_back();
+        assert(submesh_ref.allocation);
+        m_resource->GetArena().FillVertexBufferBindings(submesh_ref.allocation, bindings);
     }
 
     IVertexBasedRenderer::BufferBindingInfo StaticHomogeneousMesh::GetIndexBufferBinding() const noexcept {
         const auto &submesh = m_resource->GetSubmeshData(m_submesh_index);
-        assert(submesh.vi_buffer);
-        return {submesh.vi_buffer.get(), submesh.attribute_offsets.back(), 0};
+        assert(submesh.allocation);
+        return m_resource->GetArena().GetIndexBufferBinding(submesh.allocation);
+    }
+
+    uint32_t StaticHomogeneousMesh::GetFirstIndex() const noexcept {
+        const auto &submesh = m_resource->GetSubmeshData(m_submesh_index);
+        assert(submesh.allocation);
+        return m_resource->GetArena().GetRange(submesh.allocation).first_index;
+    }
+
+    int32_t StaticHomogeneousMesh::GetVertexOffset() const noexcept {
+        const auto &submesh = m_resource->GetSubmeshData(m_submesh_index);
+        assert(submesh.allocation);
+        return static_cast<int32_t>(m_resource->GetArena().GetRange(submesh.allocation).base_vertex);
     }
 
     bool StaticHomogeneousMesh::IsReady() const noexcept {
@@ -34,10 +34,14 @@ namespace Engine {
 
         VertexAttribute GetVertexAttributeFormat() const noexcept override;
 
-        void FillVertexAttributeBufferBindings(std::vector<BufferBindingInfo> &bindings) const noexcept override;
+        void FillVertexAttributeBufferBindings(VertexBufferBindings &bindings) const override;
 
         BufferBindingInfo GetIndexBufferBinding() const noexcept override;
 
+        uint32_t GetFirstIndex() const noexcept override;
+
+        int32_t GetVertexOffset() const noexcept override;
+
         bool IsReady() const noexcept override;
     };
 } // namespace Engine
@@ -2,12 +2,30 @@
 
 #include "Asset/Mesh/MeshAsset.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+
+namespace {
+    Engine::AABB ComputePositionBounds(const Engine::MeshAsset::Submesh &submesh) {
+        Engine::AABB bounds{};
+        const auto &positions = submesh.positions;
+        if (positions.type != Engine::VertexAttributeType::SFloat32x3) return bounds;
+        const std::byte *data = submesh.m_vertex_attributes.data() + positions.buffer_offset;
+        size_t count = std::min<size_t>(submesh.vertex_count, positions.buffer_size / sizeof(glm::vec3));
+        for (size_t i = 0; i < count; i++) {
+            glm::vec3 position;
+            std::memcpy(&position, data + i * sizeof(glm::vec3), sizeof(glm::vec3));
+            bounds.Expand(position);
+        }
+        return bounds;
+    }
+} // namespace
 
 namespace Engine {
     StaticMeshResource::StaticMeshResource(
-        GUID mesh_asset_guid, std::unique_ptr<StaticHMeshSharedDataBlock> data_block
-    ) : m_mesh_asset_ref(mesh_asset_guid), m_data_block(std::move(data_block)) {
+        GUID mesh_asset_guid, MeshBufferArena &arena, std::unique_ptr<StaticHMeshSharedDataBlock> data_block
+    ) : m_mesh_asset_ref(mesh_asset_guid), m_arena(arena), m_data_block(std::move(data_block)) {
         if (!m_data_block) {
             m_data_block = std::make_unique<StaticHMeshSharedDataBlock>();
         }
@@ -16,7 +34,7 @@ namespace Engine {
     bool StaticMeshResource::IsReady() const noexcept {
         if (m_data_block->submeshes.empty()) return false;
         for (uint32_t i = 0; i < m_data_block->submeshes.size(); ++i) {
-            if (!static_cast<bool>(m_data_block->submeshes[i].vi_buffer)) return false;
+            if (!m_data_block->submeshes[i].allocation) return false;
         }
         return true;
     }
@@ -28,8 +46,15 @@ namespace Engine {
         return m_data_block->submeshes[submesh_index];
     }
 
+    const MeshBufferArena &StaticMeshResource::GetArena() const noexcept {
+        return m_arena;
+    }
+
     void StaticMeshResource::Remove() noexcept {
         m_mesh_asset_ref.Release();
+        for (const auto &submesh : m_data_block->submeshes) {
+            if (submesh.allocation) m_arena.Free(submesh.allocation);
+        }
         m_data_block->submeshes.clear();
     }
 
@@ -43,9 +68,11 @@ namespace Engine {
         assert(mesh_asset);
         m_data_block->submeshes.resize(mesh_asset->GetSubmeshCount());
 
+        // Reused across submeshes, as its content is copied to staging buffers on upload.
+        std::vector<std::byte> buf;
         for (uint32_t submesh_index = 0; submesh_index < mesh_asset->GetSubmeshCount(); ++submesh_index) {
             auto &submesh_ref = m_data_block->submeshes[submesh_index];
-            if (submesh_ref.vi_buffer) {
+            if (submesh_ref.allocation) {
                 continue;
             }
 
@@ -53,31 +80,17 @@ namespace Engine {
             submesh_ref.attributes = smi.ToVertexAttributeFormat();
             submesh_ref.index_count = static_cast<uint32_t>(smi.m_indices.size());
             submesh_ref.vertex_attribute_count = smi.vertex_count;
-            submesh_ref.attribute_offsets.clear();
-
-            auto vec = submesh_ref.attributes.EnumerateOffsetFactor();
-            for (auto factor : vec) {
-                submesh_ref.attribute_offsets.push_back(factor * submesh_ref.vertex_attribute_count);
-            }
-            submesh_ref.attribute_offsets.push_back(
-                submesh_ref.vertex_attribute_count * submesh_ref.attributes.GetTotalPerVertexSize()
-            );
-
-            auto buffer_size = submesh_ref.vertex_attribute_count * submesh_ref.attributes.GetTotalPerVertexSize()
-                               + submesh_ref.index_count * sizeof(uint32_t);
-
-            submesh_ref.vi_buffer = DeviceBuffer::CreateUnique(
-                allocator, {BufferTypeBits::Vertex, BufferTypeBits::Index, BufferTypeBits::CopyTo}, buffer_size
-            );
+            submesh_ref.bounds = ComputePositionBounds(smi);
+            submesh_ref.allocation =
+                m_arena.Allocate(submesh_ref.attributes, submesh_ref.vertex_attribute_count, submesh_ref.index_count);
 
-            std::vector<std::byte> buf;
-            buf.resize(buffer_size);
+            size_t vertex_size = submesh_ref.vertex_attribute_count * submesh_ref.attributes.GetTotalPerVertexSize();
+            buf.resize(vertex_size + submesh_ref.index_count * sizeof(uint32_t));
             smi.WriteVertexAttributeBuffer(buf.data());
-            smi.WriteIndexBuffer(
-                buf.data() + submesh_ref.vertex_attribute_count * submesh_ref.attributes.GetTotalPerVertexSize()
-            );
+            smi.WriteIndexBuffer(buf.data() + vertex_size);
 
-            helper.EnqueueBufferSubmission(*submesh_ref.vi_buffer, buf);
+            std::span<const std::byte> data{buf};
+            m_arena.EnqueueUpload(submesh_ref.allocation, helper, data.first(vertex_size), data.subspan(vertex_size));
         }
 
         m_mesh_asset_ref.Release();
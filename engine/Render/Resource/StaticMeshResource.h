@@ -2,7 +2,8 @@
 #define RENDER_RESOURCE_STATICMESHRESOURCE_INCLUDED
 
 #include "Asset/AssetRef.h"
-#include "Render/Memory/DeviceBuffer.h"
+#include "Core/Math/Frustum.h"
+#include "Render/Memory/MeshBufferArena.h"
 #include "Render/Renderer/VertexAttribute.h"
 #include "Render/Resource/IAsynchPrepared.h"
 
@@ -20,6 +21,9 @@ namespace Engine {
      *
      * One StaticMeshResource owns the prepared data for all submeshes of a mesh
      * asset. Individual submesh renderers read from this resource at draw time.
+     * Vertices and indices are suballocated from the shared MeshBufferArena, so
+     * submeshes are drawn with the bindings of their pools, a vertex offset and
+     * a first index.
      */
     class StaticMeshResource : public IAsynchPrepared {
     public:
@@ -29,8 +33,11 @@ namespace Engine {
                 uint32_t vertex_attribute_count{0};
                 uint32_t index_count{0};
 
-                std::vector<uint32_t> attribute_offsets{};
-                std::unique_ptr<DeviceBuffer> vi_buffer{};
+                /// Vertex and index ranges in the arena, null if not prepared.
+                MeshBufferArena::Allocation allocation{};
+
+                /// Bounding box of the vertex positions in mesh space, kept after the mesh asset is released.
+                AABB bounds{};
             };
 
             std::vector<PerSubmeshData> submeshes{};
@@ -38,16 +45,19 @@ namespace Engine {
 
     private:
         AssetRef m_mesh_asset_ref{};
+        MeshBufferArena &m_arena;
         std::unique_ptr<StaticHMeshSharedDataBlock> m_data_block;
 
     public:
-        explicit StaticMeshResource(
-            GUID mesh_asset_guid, std::unique_ptr<StaticHMeshSharedDataBlock> data_block = nullptr
+        StaticMeshResource(
+            GUID mesh_asset_guid,
+            MeshBufferArena &arena,
+            std::unique_ptr<StaticHMeshSharedDataBlock> data_block = nullptr
         );
 
         /**
          * @brief Whether all submeshes in this resource are ready for rendering.
-         * A submesh is ready if its vertex/index buffer is prepared and valid.
+         * A submesh is ready if its vertices and indices are allocated in the arena.
          */
         bool IsReady() const noexcept override;
 
@@ -60,6 +70,11 @@ namespace Engine {
          */
         const StaticHMeshSharedDataBlock::PerSubmeshData &GetSubmeshData(uint32_t submesh_index) const noexcept;
 
+        /**
+         * @brief Get the arena that the submeshes are allocated from.
+         */
+        const MeshBufferArena &GetArena() const noexcept;
+
         void Remove() noexcept override;
 
         /**
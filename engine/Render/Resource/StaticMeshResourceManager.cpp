@@ -12,7 +12,7 @@ namespace Engine::RenderSystemState {
     StaticMeshResourceHandle StaticMeshResourceManager::CreateFromAssetImpl(
         GUID guid, uint32_t deallocate_after_frames
     ) {
-        auto resource = std::make_unique<StaticMeshResource>(guid);
+        auto resource = std::make_unique<StaticMeshResource>(guid, m_system.GetMeshBufferArena());
         return Create(std::move(resource), deallocate_after_frames);
     }
 
@@ -13,27 +13,28 @@ namespace Engine::RenderSystemState {
      *
      * Purpose and lifecycle:
      * - GUID maps to a MeshAsset GUID (polygon data, vertex attributes, submesh info).
-     * - Payload is a StaticMeshResource object that owns GPU-side vertex/index buffers
-     *   for all submeshes.
+     * - Payload is a StaticMeshResource object that owns ranges of vertices and indices
+     *   of all submeshes, suballocated from the MeshBufferArena of the RenderSystem.
      * - StaticMeshResource implements the IAsynchPrepared interface; GPU submission is
      *   intentionally deferred until Acquire*Impl triggers it.
      *
      * Preparation model (lazy GPU submission):
      * - CreateFromAssetImpl creates the StaticMeshResource object but does NOT submit
-     *   data to GPU; this defers expensive buffer allocation until the resource is
+     *   data to GPU; this defers expensive range allocation until the resource is
      *   actually needed (acquire time).
      * - AcquireImpl (sync path): Calls EnsureReady, forcing immediate GPU submission.
      * - AcquireAsyncImpl (async path): Currently falls back to EnsureReady (TODO: implement
      *   true async submission without blocking).
      * - IsReadyImpl queries StaticMeshResource::IsReady(), which checks whether all
-     *   submesh GPU buffers exist.
+     *   submesh ranges are allocated.
      * - EnsureReadyImpl calls StaticMeshResource::Submit() if not yet ready, which
-     *   allocates GPU buffers and enqueues copy operations via SubmissionHelper.
+     *   allocates arena ranges and enqueues copy operations via SubmissionHelper.
      *
      * GPU resource ownership:
-     * - Each submesh's vertex/index buffer (DeviceBuffer) is owned by StaticMeshResource.
-     * - OnDestroyImpl calls StaticMeshResource::Remove(), which resets buffer unique_ptrs,
-     *   triggering RAII cleanup of the underlying GPU allocations.
+     * - Each submesh's arena allocation is owned by StaticMeshResource, while the
+     *   underlying device buffers are owned by the MeshBufferArena.
+     * - OnDestroyImpl calls StaticMeshResource::Remove(), which frees the allocations;
+     *   the arena recycles their ranges after the frames in flight complete.
      *
      * Use case and design intent:
      * - This is the primary resource for mesh rendering; synchronous acquire ensures
@@ -114,7 +115,7 @@ namespace Engine::RenderSystemState {
          * @brief Cleanup upon final destruction.
          *
          * Calls StaticMeshResource::Remove(), which:
-         * - Resets each submesh's vi_buffer unique_ptr, triggering GPU buffer cleanup.
+         * - Frees each submesh's arena allocation, recycling its ranges after frames in flight.
          * - Clears internal metadata (attribute offsets, vertex counts, etc.).
          * - Releases the mesh asset reference if held.
          *
@@ -0,0 +1,138 @@
+#include <Core/PoolAllocator.h>
+#include <Framework/component/Component.h>
+#include <Framework/component/TransformComponent/TransformComponent.h>
+#include <Framework/object/GameObject.h>
+#include <Framework/world/Scene.h>
+#include <Framework/world/WorldSystem.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Engine;
+
+uint32_t init_count = 0;
+
+class DebrisComponent : public Component {
+public:
+    DebrisComponent(GameObject &parent) : Component(parent) {
+    }
+
+    void Init() override {
+        init_count++;
+    }
+
+    float m_velocity[3]{};
+    float m_lifetime{1.0f};
+};
+
+class ColliderComponent : public Component {
+public:
+    ColliderComponent(GameObject &parent) : Component(parent) {
+    }
+
+    float m_radius{0.5f};
+};
+
+void test_pool_allocator() {
+    // Reserved objects are carved from one contiguous run.
+    const size_t size = 48;
+    PoolAllocator::Reserve(size, 1000);
+    std::vector<char *> ptrs{};
+    for (int i = 0; i < 1000; i++) {
+        ptrs.push_back(static_cast<char *>(PoolAllocator::Allocate(size)));
+        assert(reinterpret_cast<uintptr_t>(ptrs.back()) % PoolAllocator::GRANULARITY == 0);
+    }
+    size_t adjacent = 0;
+    for (size_t i = 1; i < ptrs.size(); i++) {
+        if (ptrs[i] == ptrs[i - 1] + size) adjacent++;
+    }
+    assert(adjacent >= 900);
+
+    // Freed objects are recycled.
+    PoolAllocator::Deallocate(ptrs.back(), size);
+    void *recycled = PoolAllocator::Allocate(size);
+    assert(recycled == ptrs.back());
+    for (auto ptr : ptrs) PoolAllocator::Deallocate(ptr, size);
+
+    // Large objects go to the global allocator.
+    void *large = PoolAllocator::Allocate(PoolAllocator::MAX_SIZE + 1);
+    PoolAllocator::Deallocate(large, PoolAllocator::MAX_SIZE + 1);
+
+    puts("Pool allocator test passed.");
+}
+
+void test_batch() {
+    WorldSystem world;
+    auto &scene = world.CreateScene();
+    init_count = 0;
+
+    auto handles = scene.CreateGameObjects<DebrisComponent, ColliderComponent>(1000);
+    assert(handles.size() == 1000);
+    // Queued objects can be resolved before flushing.
+    assert(scene.GetGameObject(handles[0]) != nullptr);
+    scene.FlushCmdQueue();
+    scene.ProcessEvents();
+    assert(scene.GetGameObjects().size() == 1000);
+    assert(scene.GetComponents().size() == 3000);
+    assert(init_count == 1000);
+
+    for (auto handle : handles) {
+        auto *go = scene.GetGameObject(handle);
+        assert(go && go->GetHandle() == handle);
+        assert(go->m_components.size() == 3);
+        assert(go->GetTransformComponent() != nullptr);
+        assert(scene.GetComponent<DebrisComponent>(go->m_components[1]) != nullptr);
+        assert(scene.GetComponent<ColliderComponent>(go->m_components[2]) != nullptr);
+    }
+    assert(scene.View<DebrisComponent>().size() == 1000);
+
+    // Batches mix with single creation and removal.
+    scene.RemoveGameObject(handles[0]);
+    scene.CreateGameObject().AddComponent<DebrisComponent>();
+    scene.CreateGameObjects<DebrisComponent>(10);
+    scene.FlushCmdQueue();
+    assert(scene.GetGameObjects().size() == 1010);
+    assert(scene.View<DebrisComponent>().size() == 1010);
+
+    puts("Batch creation test passed.");
+}
+
+// Spawn rate of debris GameObjects, one by one and in a batch, including the flush and the init events.
+void benchmark(uint32_t count) {
+    const int repeat = 10;
+    double best[2] = {1e30, 1e30};
+    for (int r = 0; r < repeat; r++) {
+        for (int batch = 0; batch < 2; batch++) {
+            WorldSystem world;
+            auto &scene = world.CreateScene();
+            auto start = std::chrono::high_resolution_clock::now();
+            if (batch) {
+                scene.CreateGameObjects<DebrisComponent>(count);
+            } else {
+                for (uint32_t i = 0; i < count; i++) scene.CreateGameObject().AddComponent<DebrisComponent>();
+            }
+            scene.FlushCmdQueue();
+            scene.ProcessEvents();
+            auto end = std::chrono::high_resolution_clock::now();
+            best[batch] = std::min(best[batch], std::chrono::duration<double, std::milli>(end - start).count());
+        }
+    }
+    printf(
+        "Spawning %u GameObjects: one by one %.3f ms (%.0f /ms), batch %.3f ms (%.0f /ms).\n",
+        count,
+        best[0],
+        count / best[0],
+        best[1],
+        count / best[1]
+    );
+}
+
+int main() {
+    test_pool_allocator();
+    test_batch();
+    benchmark(10000);
+    benchmark(100000);
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <Framework/world/ComponentPool.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace Engine;
+
+// Stand-ins for components. The pool only stores pointers, so they are never dereferenced as Components.
+struct FakeComponent {
+    virtual ~FakeComponent() = default;
+    float payload[16]{};
+};
+struct FakeLight : public FakeComponent {
+    float intensity{1.0f};
+};
+
+Component *AsComponent(FakeComponent *ptr) {
+    return reinterpret_cast<Component *>(ptr);
+}
+FakeComponent *AsFake(Component *ptr) {
+    return reinterpret_cast<FakeComponent *>(ptr);
+}
+
+bool ProbeLight(Component *ptr) {
+    return dynamic_cast<FakeLight *>(AsFake(ptr)) != nullptr;
+}
+
+void test_basic() {
+    ComponentPool pool(typeid(FakeLight), ProbeLight);
+    FakeLight a, b, c;
+    FakeComponent d;
+    assert(pool.Probe(AsComponent(&a)));
+    assert(!pool.Probe(AsComponent(&d)));
+
+    pool.Insert(3, AsComponent(&a));
+    pool.Insert(7, AsComponent(&b));
+    pool.Insert(1, AsComponent(&c));
+    assert(pool.GetComponents().size() == 3);
+
+    pool.Remove(3);
+    assert(pool.GetComponents().size() == 2);
+    assert(std::find(pool.GetComponents().begin(), pool.GetComponents().end(), AsComponent(&a))
+           == pool.GetComponents().end());
+
+    // Removing absent slots is a no-op.
+    pool.Remove(3);
+    pool.Remove(100);
+    assert(pool.GetComponents().size() == 2);
+
+    // Slots can be reused after removal.
+    pool.Insert(3, AsComponent(&a));
+    assert(pool.GetComponents().size() == 3);
+
+    pool.Clear();
+    assert(pool.GetComponents().empty());
+
+    puts("Basic component pool test passed.");
+}
+
+void test_random_churn() {
+    std::mt19937 gen{42};
+    std::vector<std::unique_ptr<FakeLight>> lights(4096);
+    ComponentPool pool(typeid(FakeLight), ProbeLight);
+    std::unordered_map<uint32_t, Component *> reference;
+
+    for (int i = 0; i < 100000; i++) {
+        uint32_t slot = gen() % lights.size();
+        if (reference.count(slot)) {
+            pool.Remove(slot);
+            reference.erase(slot);
+        } else {
+            if (!lights[slot]) lights[slot] = std::make_unique<FakeLight>();
+            pool.Insert(slot, AsComponent(lights[slot].get()));
+            reference[slot] = AsComponent(lights[slot].get());
+        }
+    }
+
+    assert(pool.GetComponents().size() == reference.size());
+    for (auto [slot, ptr] : reference) {
+        assert(std::find(pool.GetComponents().begin(), pool.GetComponents().end(), ptr) != pool.GetComponents().end());
+    }
+
+    puts("Random churn component pool test passed.");
+}
+
+// Gathering lights from a scene with few lights among many components,
+// by scanning and casting every component versus iterating over the pool.
+void benchmark(size_t component_count, size_t light_count) {
+    std::vector<std::unique_ptr<FakeComponent>> components;
+    ComponentPool pool(typeid(FakeLight), ProbeLight);
+    components.reserve(component_count);
+    size_t stride = component_count / light_count;
+    for (size_t i = 0; i < component_count; i++) {
+        if (i % stride == 0) {
+            components.push_back(std::make_unique<FakeLight>());
+            pool.Insert(static_cast<uint32_t>(i), AsComponent(components.back().get()));
+        } else {
+            components.push_back(std::make_unique<FakeComponent>());
+        }
+    }
+
+    const int frames = 100;
+    float sum_scan = 0.0f, sum_pool = 0.0f;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (auto &comp : components) {
+            if (auto light = dynamic_cast<FakeLight *>(comp.get())) sum_scan += light->intensity;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double scan = std::chrono::duration<double, std::milli>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (auto *comp : pool.GetComponents()) {
+            sum_pool += static_cast<FakeLight *>(AsFake(comp))->intensity;
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double pooled = std::chrono::duration<double, std::milli>(end - start).count();
+
+    assert(sum_scan == sum_pool);
+    printf(
+        "%zu components, %zu lights, %d frames: dynamic_cast scan %.3f ms, pool %.3f ms.\n",
+        component_count,
+        pool.GetComponents().size(),
+        frames,
+        scan,
+        pooled
+    );
+}
+
+int main() {
+    test_basic();
+    test_random_churn();
+
+    benchmark(10000, 16);
+    benchmark(100000, 16);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "Render/Memory/DescriptorAllocator.h"
+#include "Render/RenderSystem/FrameManager.h"
+
+using namespace Engine;
+
+uint32_t CountOf(const std::vector<vk::DescriptorPoolSize> &sizes, vk::DescriptorType type) {
+    for (const auto &size : sizes) {
+        if (size.type == type) return size.descriptorCount;
+    }
+    return 0;
+}
+
+void test_pool_sizes() {
+    std::vector<vk::DescriptorSetLayoutBinding> bindings{
+        {0, vk::DescriptorType::eUniformBufferDynamic, 1, vk::ShaderStageFlagBits::eAllGraphics},
+        {1, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment},
+        {2, vk::DescriptorType::eCombinedImageSampler, 4, vk::ShaderStageFlagBits::eFragment},
+        // Empty bindings take no descriptors.
+        {3, vk::DescriptorType::eStorageBuffer, 0, vk::ShaderStageFlagBits::eFragment},
+    };
+
+    auto sizes = DescriptorAllocator::ComputePoolSizes(bindings, 32);
+    // Bindings of the same type are merged into one entry.
+    assert(sizes.size() == 2);
+    assert(CountOf(sizes, vk::DescriptorType::eUniformBufferDynamic) == 32);
+    assert(CountOf(sizes, vk::DescriptorType::eCombinedImageSampler) == 5 * 32);
+    assert(CountOf(sizes, vk::DescriptorType::eStorageBuffer) == 0);
+
+    assert(DescriptorAllocator::ComputePoolSizes({}, 32).empty());
+    puts("Pool size test passed.");
+}
+
+void test_pool_growth() {
+    // Pools double from the initial size, and stop growing at the cap.
+    assert(DescriptorAllocator::ComputePoolCapacity(0) == DescriptorAllocator::INITIAL_SETS_PER_POOL);
+    uint32_t capacity = 0, pool_count = 0;
+    while (DescriptorAllocator::ComputePoolCapacity(pool_count) < DescriptorAllocator::MAX_SETS_PER_POOL) {
+        uint32_t next = DescriptorAllocator::ComputePoolCapacity(pool_count + 1);
+        assert(next == 2 * DescriptorAllocator::ComputePoolCapacity(pool_count));
+        capacity += DescriptorAllocator::ComputePoolCapacity(pool_count++);
+    }
+    // 32 + 64 + ... + 512 sets before the first pool of 1024 sets.
+    assert(pool_count == 5 && capacity == 992);
+    for (uint32_t i = pool_count; i < 64; i++) {
+        assert(DescriptorAllocator::ComputePoolCapacity(i) == DescriptorAllocator::MAX_SETS_PER_POOL);
+    }
+    assert(DescriptorAllocator::ComputePoolCapacity(0xFFFFFFFFu) == DescriptorAllocator::MAX_SETS_PER_POOL);
+    puts("Pool growth test passed.");
+}
+
+void test_recycling() {
+    constexpr uint64_t frames_in_flight = RenderSystemState::FrameManager::FRAMES_IN_FLIGHT;
+    for (uint64_t freed = 0; freed < 10; freed++) {
+        // Frames in flight may still read the set until it has been freed for FRAMES_IN_FLIGHT frames.
+        for (uint64_t frame = freed; frame < freed + frames_in_flight; frame++) {
+            assert(!DescriptorAllocator::IsRecyclable(freed, frame));
+        }
+        assert(DescriptorAllocator::IsRecyclable(freed, freed + frames_in_flight));
+        assert(DescriptorAllocator::IsRecyclable(freed, freed + frames_in_flight + 1));
+    }
+    puts("Recycling test passed.");
+}
+
+int main() {
+    test_pool_sizes();
+    test_pool_growth();
+    test_recycling();
+    return 0;
+}
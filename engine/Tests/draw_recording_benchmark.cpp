@@ -0,0 +1,332 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "Render/Pipeline/CommandBuffer/BoundStateFilter.h"
+#include "Render/Pipeline/CommandBuffer/DrawRecording.h"
+#include "Render/RenderSystem/DrawPacket.h"
+#include "Render/Renderer/IVertexBasedRenderer.h"
+#include "Render/Renderer/VertexAttribute.h"
+
+using namespace Engine;
+
+std::mt19937 gen{};
+
+constexpr uint32_t DRAW_COUNT = 50000;
+constexpr uint32_t PIPELINE_COUNT = 8;
+constexpr uint32_t MATERIAL_COUNT = 64;
+constexpr uint32_t MESH_COUNT = 512;
+constexpr uint32_t POOL_COUNT = 4;
+constexpr uint32_t STREAM_COUNT = 5;
+
+template <typename Handle>
+Handle FakeHandle(uint64_t value) {
+    return Handle{reinterpret_cast<typename Handle::CType>(value)};
+}
+
+// A command buffer that records nothing and only counts commands, standing in for `vk::CommandBuffer`.
+struct NullCommandBuffer {
+    uint64_t state_changes{0};
+    uint64_t draws{0};
+    // Consumes the arguments so that building them is not optimized out.
+    uint64_t checksum{0};
+
+    void bindPipeline(vk::PipelineBindPoint, vk::Pipeline pipeline) {
+        state_changes++;
+        checksum += static_cast<bool>(pipeline);
+    }
+    void bindVertexBuffers(uint32_t, uint32_t count, const vk::Buffer *, const vk::DeviceSize *offsets) {
+        state_changes++;
+        for (uint32_t i = 0; i < count; i++) checksum += offsets[i];
+    }
+    void bindIndexBuffer(vk::Buffer, vk::DeviceSize offset, vk::IndexType) {
+        state_changes++;
+        checksum += offset;
+    }
+    void bindDescriptorSets(
+        vk::PipelineBindPoint,
+        vk::PipelineLayout,
+        uint32_t set,
+        uint32_t,
+        const vk::DescriptorSet *,
+        uint32_t count,
+        const uint32_t *offsets
+    ) {
+        state_changes++;
+        checksum += set;
+        for (uint32_t i = 0; i < count; i++) checksum += offsets[i];
+    }
+    void pushConstants(vk::PipelineLayout, vk::ShaderStageFlags, uint32_t, uint32_t size, const void *data) {
+        state_changes++;
+        checksum += size + std::to_integer<uint64_t>(static_cast<const std::byte *>(data)[0]);
+    }
+    void drawIndexed(uint32_t index_count, uint32_t, uint32_t first_index, int32_t, uint32_t) {
+        draws++;
+        checksum += index_count + first_index;
+    }
+};
+
+// A submesh placed in one of a few shared pools, as the mesh buffer arena places static meshes.
+// Its buffers are fake and never dereferenced.
+class FakeMesh : public IVertexBasedRenderer {
+public:
+    FakeMesh(uint32_t pool, uint32_t first_index) : m_pool(pool), m_first_index(first_index) {
+    }
+
+    bool IsReady() const noexcept override {
+        return true;
+    }
+    uint32_t GetIndexCount() const noexcept override {
+        return 300;
+    }
+    uint32_t GetFirstIndex() const noexcept override {
+        return m_first_index;
+    }
+    uint32_t GetVertexAttributeCount() const noexcept override {
+        return 100;
+    }
+    VertexAttribute GetVertexAttributeFormat() const noexcept override {
+        return VertexAttribute{};
+    }
+    void FillVertexAttributeBufferBindings(VertexBufferBindings &bindings) const override {
+        for (uint32_t k = 0; k < STREAM_COUNT; k++) bindings.push_back({GetBuffer(), k * 65536, 65536});
+    }
+    BufferBindingInfo GetIndexBufferBinding() const noexcept override {
+        return {GetBuffer(), STREAM_COUNT * 65536, 65536};
+    }
+
+    static vk::Buffer ToVkBuffer(const DeviceBuffer *buffer) {
+        return FakeHandle<vk::Buffer>(reinterpret_cast<uintptr_t>(buffer));
+    }
+
+private:
+    const DeviceBuffer *GetBuffer() const noexcept {
+        return reinterpret_cast<const DeviceBuffer *>(uintptr_t{0x1000} * (m_pool + 1));
+    }
+
+    uint32_t m_pool;
+    uint32_t m_first_index;
+};
+
+struct Draw {
+    uint32_t material;
+    const FakeMesh *mesh;
+    const RenderSystemState::DrawPacket *packet;
+    glm::mat4 model;
+};
+
+struct PushConstants {
+    glm::mat4 model;
+    int32_t camera_index;
+};
+
+vk::Pipeline GetPipeline(uint32_t material) {
+    return FakeHandle<vk::Pipeline>(0x100 + material % PIPELINE_COUNT);
+}
+vk::PipelineLayout GetLayout(uint32_t material) {
+    return FakeHandle<vk::PipelineLayout>(0x200 + material % PIPELINE_COUNT);
+}
+vk::DescriptorSet GetMaterialSet(uint32_t material) {
+    return FakeHandle<vk::DescriptorSet>(0x300 + material);
+}
+
+// The recording path before inline arrays and state filtering: heap-allocated
+// binding arrays for each draw, and only pipeline changes are filtered.
+void RecordUnfiltered(NullCommandBuffer &cb, const std::vector<Draw> &draws) {
+    vk::Pipeline bound_pipeline{};
+    uint32_t bound_material = UINT32_MAX;
+    for (const auto &draw : draws) {
+        if (draw.material != bound_material) {
+            if (GetPipeline(draw.material) != bound_pipeline) {
+                bound_pipeline = GetPipeline(draw.material);
+                cb.bindPipeline(vk::PipelineBindPoint::eGraphics, bound_pipeline);
+            }
+            std::vector<uint32_t> dynamic_offsets{draw.material * 256};
+            auto set = GetMaterialSet(draw.material);
+            cb.bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics,
+                GetLayout(draw.material),
+                2,
+                1,
+                &set,
+                static_cast<uint32_t>(dynamic_offsets.size()),
+                dynamic_offsets.data()
+            );
+            bound_material = draw.material;
+        }
+
+        std::vector<IVertexBasedRenderer::BufferBindingInfo> bindings;
+        for (const auto &binding : draw.mesh->GetVertexAttributeBufferBindings()) bindings.push_back(binding);
+        std::vector<vk::Buffer> buffers(bindings.size());
+        std::vector<vk::DeviceSize> offsets(bindings.size());
+        for (size_t i = 0; i < bindings.size(); i++) {
+            buffers[i] = FakeMesh::ToVkBuffer(bindings[i].buffer);
+            offsets[i] = bindings[i].offset;
+        }
+        cb.bindVertexBuffers(0, static_cast<uint32_t>(buffers.size()), buffers.data(), offsets.data());
+        auto indices = draw.mesh->GetIndexBufferBinding();
+        cb.bindIndexBuffer(FakeMesh::ToVkBuffer(indices.buffer), indices.offset, vk::IndexType::eUint32);
+
+        PushConstants push_constants{.model = draw.model, .camera_index = 0};
+        cb.pushConstants(
+            GetLayout(draw.material), vk::ShaderStageFlagBits::eAllGraphics, 0, sizeof(push_constants), &push_constants
+        );
+        cb.drawIndexed(draw.mesh->GetIndexCount(), 1, draw.mesh->GetFirstIndex(), 0, 0);
+    }
+}
+
+// The recording path of `GraphicsCommandBuffer::DrawRenderers` for renderers that are not instanced,
+// from the draw packets cached by the RendererManager.
+void RecordFiltered(NullCommandBuffer &cb, BoundStateFilter &filter, const std::vector<Draw> &draws) {
+    filter.Invalidate();
+    for (const auto &draw : draws) {
+        const auto &packet = *draw.packet;
+        InlineVector<uint32_t, BoundStateFilter::MAX_DYNAMIC_OFFSETS> dynamic_offsets{draw.material * 256};
+        DrawRecording::BindMaterial(
+            cb, filter, packet.pipeline, packet.pipeline_layout, GetMaterialSet(draw.material), dynamic_offsets
+        );
+        DrawRecording::BindPacketBuffers(cb, filter, packet);
+        DrawRecording::PushRendererData(cb, filter, draw.model, 0);
+        DrawRecording::DrawPacketInstances(cb, packet, 1, 0);
+    }
+}
+
+// Draw packets of a mesh with a material, as the RendererManager resolves them.
+RenderSystemState::DrawPacket MakePacket(const FakeMesh &mesh, uint32_t material) {
+    RenderSystemState::DrawPacket packet{};
+    packet.pipeline = GetPipeline(material);
+    packet.pipeline_layout = GetLayout(material);
+    for (const auto &binding : mesh.GetVertexAttributeBufferBindings()) {
+        packet.vertex_buffers.push_back(FakeMesh::ToVkBuffer(binding.buffer));
+        packet.vertex_offsets.push_back(binding.offset);
+    }
+    auto indices = mesh.GetIndexBufferBinding();
+    packet.index_buffer = FakeMesh::ToVkBuffer(indices.buffer);
+    packet.index_offset = indices.offset;
+    packet.index_count = mesh.GetIndexCount();
+    packet.first_index = mesh.GetFirstIndex();
+    return packet;
+}
+
+void test_filter() {
+    BoundStateFilter filter;
+    auto layout = FakeHandle<vk::PipelineLayout>(1), other_layout = FakeHandle<vk::PipelineLayout>(2);
+    auto pipeline = FakeHandle<vk::Pipeline>(1);
+    bool first = filter.ShouldBindPipeline(pipeline, layout);
+    bool again = filter.ShouldBindPipeline(pipeline, layout);
+    assert(first && !again);
+    assert(filter.GetPipelineLayout() == layout);
+
+    vk::Buffer buffers[] = {FakeHandle<vk::Buffer>(1), FakeHandle<vk::Buffer>(2)};
+    vk::DeviceSize offsets[] = {0, 64};
+    first = filter.ShouldBindVertexBuffers(buffers, offsets);
+    again = filter.ShouldBindVertexBuffers(buffers, offsets);
+    assert(first && !again);
+    // Fewer bindings are covered by the bound ones.
+    bool prefix = filter.ShouldBindVertexBuffers(std::span{buffers, 1}, std::span{offsets, 1});
+    assert(!prefix);
+    offsets[1] = 128;
+    bool changed = filter.ShouldBindVertexBuffers(buffers, offsets);
+    assert(changed);
+
+    first = filter.ShouldBindIndexBuffer(buffers[0], 0, vk::IndexType::eUint32);
+    again = filter.ShouldBindIndexBuffer(buffers[0], 0, vk::IndexType::eUint32);
+    changed = filter.ShouldBindIndexBuffer(buffers[0], 4, vk::IndexType::eUint32);
+    assert(first && !again && changed);
+
+    auto set0 = FakeHandle<vk::DescriptorSet>(1), set2 = FakeHandle<vk::DescriptorSet>(2);
+    uint32_t dynamic_offsets[] = {0, 256};
+    bool first_set0 = filter.ShouldBindDescriptorSet(layout, 0, set0, {});
+    bool first_set2 = filter.ShouldBindDescriptorSet(layout, 2, set2, dynamic_offsets);
+    again = filter.ShouldBindDescriptorSet(layout, 2, set2, dynamic_offsets);
+    assert(first_set0 && first_set2 && !again);
+    dynamic_offsets[1] = 512;
+    bool other_offsets = filter.ShouldBindDescriptorSet(layout, 2, set2, dynamic_offsets);
+    bool other_layout_set2 = filter.ShouldBindDescriptorSet(other_layout, 2, set2, dynamic_offsets);
+    assert(other_offsets && other_layout_set2);
+    // Rebinding a lower set forgets the higher ones.
+    bool same_set0 = filter.ShouldBindDescriptorSet(layout, 0, set0, {});
+    bool other_layout_set0 = filter.ShouldBindDescriptorSet(other_layout, 0, set0, {});
+    bool forgotten_set2 = filter.ShouldBindDescriptorSet(other_layout, 2, set2, dynamic_offsets);
+    assert(!same_set0 && other_layout_set0 && forgotten_set2);
+
+    int32_t data[] = {1, 2, 3};
+    first = filter.ShouldPushConstants(layout, std::as_bytes(std::span{data}));
+    again = filter.ShouldPushConstants(layout, std::as_bytes(std::span{data}));
+    bool other_layout_push = filter.ShouldPushConstants(other_layout, std::as_bytes(std::span{data}));
+    assert(first && !again && other_layout_push);
+    data[2] = 4;
+    changed = filter.ShouldPushConstants(other_layout, std::as_bytes(std::span{data}));
+    assert(changed);
+
+    filter.Invalidate();
+    assert(!filter.GetPipelineLayout());
+    bool pipeline_after = filter.ShouldBindPipeline(pipeline, layout);
+    bool index_after = filter.ShouldBindIndexBuffer(buffers[0], 4, vk::IndexType::eUint32);
+    assert(pipeline_after && index_after);
+    puts("Bound state filter test passed.");
+}
+
+void benchmark_recording() {
+    std::vector<FakeMesh> meshes;
+    meshes.reserve(MESH_COUNT);
+    for (uint32_t i = 0; i < MESH_COUNT; i++) meshes.emplace_back(i % POOL_COUNT, i * 300);
+
+    // Renderers sorted by material, and by geometry within a material, as DrawRenderers receives them.
+    // Instances of the same mesh and material keep different model matrices, as in a real scene.
+    std::vector<Draw> draws(DRAW_COUNT);
+    // One cached packet per renderer, as the RendererManager keeps them.
+    std::vector<RenderSystemState::DrawPacket> packets(DRAW_COUNT);
+    for (uint32_t i = 0; i < DRAW_COUNT; i++) {
+        draws[i].material = i * MATERIAL_COUNT / DRAW_COUNT;
+        draws[i].mesh = &meshes[(i * MESH_COUNT / DRAW_COUNT) % MESH_COUNT];
+        packets[i] = MakePacket(*draws[i].mesh, draws[i].material);
+        draws[i].packet = &packets[i];
+        for (int c = 0; c < 4; c++) {
+            for (int r = 0; r < 4; r++) draws[i].model[c][r] = static_cast<float>(gen() % 1000);
+        }
+    }
+    // Static geometry of the same mesh, e.g. shared by a merged instanced draw, pushes the same data.
+    for (uint32_t i = 1; i < DRAW_COUNT; i += 2) draws[i].model = draws[i - 1].model;
+
+    constexpr int ITERATIONS = 10;
+    NullCommandBuffer unfiltered, filtered;
+    BoundStateFilter filter;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) RecordUnfiltered(unfiltered, draws);
+    auto end = std::chrono::high_resolution_clock::now();
+    double unfiltered_time = std::chrono::duration<double, std::milli>(end - start).count() / ITERATIONS;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) RecordFiltered(filtered, filter, draws);
+    end = std::chrono::high_resolution_clock::now();
+    double filtered_time = std::chrono::duration<double, std::milli>(end - start).count() / ITERATIONS;
+
+    assert(unfiltered.draws == filtered.draws && filtered.draws == uint64_t{DRAW_COUNT} * ITERATIONS);
+    assert(filtered.state_changes < unfiltered.state_changes);
+    auto statistics = filter.GetStatistics();
+    assert(statistics.recorded == filtered.state_changes);
+
+    printf(
+        "Recorded %u draws: %.3lfms and %llu state changes unfiltered, %.3lfms and %llu state changes filtered"
+        " (checksums %llu, %llu).\n",
+        DRAW_COUNT,
+        unfiltered_time,
+        static_cast<unsigned long long>(unfiltered.state_changes / ITERATIONS),
+        filtered_time,
+        static_cast<unsigned long long>(filtered.state_changes / ITERATIONS),
+        static_cast<unsigned long long>(unfiltered.checksum),
+        static_cast<unsigned long long>(filtered.checksum)
+    );
+}
+
+int main(int argc, char *argv[]) {
+    test_filter();
+    // ctest only runs the filter test.
+    if (argc > 1 && std::string_view(argv[1]) == "--benchmark") benchmark_recording();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <Core/Delegate/FuncDelegate.h>
+#include <Core/Functional/EventQueue.h>
+#include <Framework/component/Component.h>
+#include <Framework/object/GameObject.h>
+#include <Framework/world/Scene.h>
+#include <Framework/world/WorldSystem.h>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace Engine;
+
+// Count heap allocations to check the steady-state frame.
+std::atomic<size_t> allocation_count{0};
+
+void *operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+uint64_t tick_count = 0;
+uint64_t init_count = 0;
+
+class CountingComponent : public Component {
+public:
+    CountingComponent(GameObject &parent) : Component(parent) {
+    }
+
+    void Init() override {
+        init_count++;
+    }
+
+    void Tick() override {
+        tick_count++;
+    }
+};
+
+void RunFrame(Scene &scene) {
+    scene.FlushCmdQueue();
+    scene.AddTickEvent();
+    scene.ProcessEvents();
+}
+
+void test_events() {
+    WorldSystem world;
+    auto &scene = world.CreateScene();
+    auto &go = scene.CreateGameObject();
+    auto &a = go.AddComponent<CountingComponent>();
+    auto &b = go.AddComponent<CountingComponent>();
+    scene.FlushCmdQueue();
+    scene.ProcessEvents();
+    assert(init_count == 2);
+
+    // Events of removed Components are dropped.
+    EventQueue queue(scene);
+    queue.AddEvent(a, ComponentEvent::Tick);
+    queue.AddEvent(b, ComponentEvent::Tick);
+    scene.RemoveComponent(a.GetHandle());
+    scene.FlushCmdQueue();
+    tick_count = 0;
+    queue.ProcessEvents();
+    assert(tick_count == 1);
+
+    // Delegates are processed in order with Component events, including events queued while processing.
+    int order = 0;
+    queue.AddEvent(std::make_unique<FuncDelegate<>>([&]() {
+        assert(order++ == 0);
+        queue.AddEvent(std::make_unique<FuncDelegate<>>([&]() { assert(order++ == 2); }));
+    }));
+    queue.AddEvent(b, ComponentEvent::Tick);
+    queue.AddEvent(std::make_unique<FuncDelegate<>>([&]() { assert(order++ == 1); }));
+    tick_count = 0;
+    queue.ProcessEvents();
+    assert(order == 3);
+    assert(tick_count == 1);
+
+    puts("Event queue test passed.");
+}
+
+void test_steady_state(uint32_t count) {
+    WorldSystem world;
+    auto &scene = world.CreateScene();
+    for (uint32_t i = 0; i < count; i++) {
+        scene.CreateGameObject().AddComponent<CountingComponent>();
+    }
+    scene.FlushCmdQueue();
+    scene.ProcessEvents();
+
+    // Warm up buffers kept across frames.
+    RunFrame(scene);
+
+    const int frames = 20;
+    tick_count = 0;
+    size_t allocations_before = allocation_count.load();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) RunFrame(scene);
+    auto end = std::chrono::high_resolution_clock::now();
+    size_t allocations = allocation_count.load() - allocations_before;
+
+    assert(tick_count == uint64_t{frames} * count);
+    assert(allocations == 0);
+    printf(
+        "%u components: %.3f ms per frame, %zu allocations in %d frames.\n",
+        count,
+        std::chrono::duration<double, std::milli>(end - start).count() / frames,
+        allocations,
+        frames
+    );
+}
+
+int main() {
+    test_events();
+    test_steady_state(50000);
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "Core/Math/Frustum.h"
+#include <ext/matrix_clip_space.hpp>
+#include <ext/matrix_transform.hpp>
+
+using namespace Engine;
+
+std::mt19937 gen{};
+
+// Same setup as Camera: right-handed, depth in [0, 1], flipped Y.
+glm::mat4 MakeProjectionView() {
+    glm::mat4 proj = glm::perspectiveRH(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+    proj[1][1] *= -1.0f;
+    glm::mat4 view = glm::lookAtRH(glm::vec3{0.0f, 2.0f, 0.0f}, glm::vec3{0.0f, 2.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+    return proj * view;
+}
+
+AABB MakeBox(glm::vec3 center, float half) {
+    return AABB{center - glm::vec3{half}, center + glm::vec3{half}};
+}
+
+// Reference test: a box is culled iff all of its corners are outside one clip plane.
+// Clip coordinates are computed in double precision, as z and w are nearly equal close to
+// the far plane, and rounding them in single precision keeps boxes that are beyond it.
+bool ReferenceIntersects(const glm::mat4 &pv, const AABB &box) {
+    glm::dmat4 dpv{pv};
+    glm::dvec4 corners[8];
+    for (int i = 0; i < 8; i++) {
+        glm::dvec3 p{i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y, i & 4 ? box.max.z : box.min.z};
+        corners[i] = dpv * glm::dvec4(p, 1.0);
+    }
+    auto all_outside = [&](auto outside) {
+        return std::all_of(corners, corners + 8, outside);
+    };
+    if (all_outside([](const glm::dvec4 &c) { return c.x < -c.w; })) return false;
+    if (all_outside([](const glm::dvec4 &c) { return c.x > c.w; })) return false;
+    if (all_outside([](const glm::dvec4 &c) { return c.y < -c.w; })) return false;
+    if (all_outside([](const glm::dvec4 &c) { return c.y > c.w; })) return false;
+    if (all_outside([](const glm::dvec4 &c) { return c.z < 0.0; })) return false;
+    if (all_outside([](const glm::dvec4 &c) { return c.z > c.w; })) return false;
+    return true;
+}
+
+void test_correctness() {
+    glm::mat4 pv = MakeProjectionView();
+    Frustum frustum{pv};
+
+    assert(frustum.Intersects(MakeBox({0.0f, 2.0f, -10.0f}, 1.0f)));
+    // Behind the camera, beyond the far plane, and off each side.
+    assert(!frustum.Intersects(MakeBox({0.0f, 2.0f, 10.0f}, 1.0f)));
+    assert(!frustum.Intersects(MakeBox({0.0f, 2.0f, -300.0f}, 1.0f)));
+    assert(!frustum.Intersects(MakeBox({100.0f, 2.0f, -10.0f}, 1.0f)));
+    assert(!frustum.Intersects(MakeBox({-100.0f, 2.0f, -10.0f}, 1.0f)));
+    assert(!frustum.Intersects(MakeBox({0.0f, 100.0f, -10.0f}, 1.0f)));
+    assert(!frustum.Intersects(MakeBox({0.0f, -100.0f, -10.0f}, 1.0f)));
+    // Straddling the near plane and containing the camera.
+    assert(frustum.Intersects(MakeBox({0.0f, 2.0f, 0.0f}, 5.0f)));
+    // Empty boxes are culled, and the default frustum contains everything else.
+    assert(!frustum.Intersects(AABB{}));
+    assert(Frustum{}.Intersects(MakeBox({1e6f, 0.0f, 0.0f}, 1.0f)));
+    assert(!Frustum{}.Intersects(AABB{}));
+
+    // Transformed boxes contain the transformed corners.
+    AABB unit = MakeBox({0.0f, 0.0f, 0.0f}, 1.0f);
+    glm::mat4 model = glm::rotate(glm::translate(glm::mat4{1.0f}, {5.0f, 0.0f, 0.0f}), 0.7f, {0.0f, 1.0f, 0.0f});
+    AABB moved = unit.Transformed(model);
+    for (int i = 0; i < 8; i++) {
+        glm::vec3 p{i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f};
+        glm::vec3 q = glm::vec3(model * glm::vec4(p, 1.0f));
+        assert(glm::all(glm::greaterThanEqual(q, moved.min - 1e-4f)));
+        assert(glm::all(glm::lessThanEqual(q, moved.max + 1e-4f)));
+    }
+    assert(AABB{}.Transformed(model).IsEmpty());
+
+    // The plane test is conservative: it never culls a box that the exact test keeps.
+    std::uniform_real_distribution<float> position{-150.0f, 150.0f};
+    std::uniform_real_distribution<float> size{0.1f, 5.0f};
+    for (int i = 0; i < 100000; i++) {
+        AABB box = MakeBox({position(gen), position(gen) * 0.2f, position(gen)}, size(gen));
+        if (ReferenceIntersects(pv, box)) assert(frustum.Intersects(box));
+    }
+
+    puts("Frustum culling correctness test passed.");
+}
+
+// Throughput of updating the world bounds and culling, as done by RendererManager for each renderer.
+void benchmark(size_t count) {
+    std::uniform_real_distribution<float> position{-300.0f, 300.0f};
+    std::vector<AABB> local_bounds(count);
+    std::vector<glm::mat4> models(count);
+    std::vector<AABB> world_bounds(count);
+    for (size_t i = 0; i < count; i++) {
+        local_bounds[i] = MakeBox({0.0f, 0.0f, 0.0f}, 1.0f);
+        models[i] = glm::rotate(
+            glm::translate(glm::mat4{1.0f}, {position(gen), position(gen) * 0.05f, position(gen)}),
+            position(gen),
+            {0.0f, 1.0f, 0.0f}
+        );
+    }
+    glm::mat4 pv = MakeProjectionView();
+    Frustum frustum{pv};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; i++) world_bounds[i] = local_bounds[i].Transformed(models[i]);
+    auto end = std::chrono::high_resolution_clock::now();
+    double transform_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::vector<uint32_t> visible{};
+    visible.reserve(count);
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        if (frustum.Intersects(world_bounds[i])) visible.push_back(static_cast<uint32_t>(i));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double cull_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    size_t reference_visible = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        if (ReferenceIntersects(pv, world_bounds[i])) reference_visible++;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double reference_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    assert(visible.size() >= reference_visible);
+
+    printf(
+        "%zu renderers: bounds update %.3f ms, frustum culling %.3f ms (%.1f M boxes/s, %zu visible), "
+        "corner reference %.3f ms.\n",
+        count,
+        transform_ms,
+        cull_ms,
+        count / cull_ms / 1000.0,
+        visible.size(),
+        reference_ms
+    );
+}
+
+int main(int argc, char *argv[]) {
+    test_correctness();
+    if (argc > 1 && std::string_view(argv[1]) == "--benchmark") benchmark(100000);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <Framework/component/Component.h>
+#include <Framework/object/GameObject.h>
+#include <Framework/world/Handle.h>
+#include <Framework/world/Scene.h>
+#include <Framework/world/WorldSystem.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace Engine;
+
+class EmptyComponent : public Component {
+public:
+    EmptyComponent(GameObject &parent) : Component(parent) {
+    }
+};
+
+void test_handles() {
+    static_assert(sizeof(ComponentHandle) == sizeof(uint64_t));
+    static_assert(std::is_trivially_copyable_v<ObjectHandle>);
+
+    WorldSystem world;
+    auto &scene = world.CreateScene();
+    auto &go = scene.CreateGameObject();
+    auto &comp = go.AddComponent<EmptyComponent>();
+    scene.FlushCmdQueue();
+
+    ObjectHandle go_handle = go.GetHandle();
+    ComponentHandle comp_handle = comp.GetHandle();
+    assert(go_handle.IsValid() && comp_handle.IsValid());
+    assert(go_handle.GetSceneID() == scene.GetID());
+    assert(comp_handle.GetValue() == (uint64_t{scene.GetID()} << 32 | comp_handle.GetID()));
+    assert(scene.GetComponent(comp_handle) == &comp);
+
+    // Handles can be copied as raw bytes.
+    ComponentHandle copied{};
+    std::memcpy(&copied, &comp_handle, sizeof(copied));
+    assert(copied == comp_handle);
+    assert(std::hash<ComponentHandle>()(copied) == std::hash<ComponentHandle>()(comp_handle));
+
+    // Reset keeps the scene ID.
+    copied.Reset();
+    assert(!copied.IsValid());
+    assert(copied.GetSceneID() == scene.GetID());
+    assert(copied == scene.GetNullComponentHandle());
+
+    puts("Handle test passed.");
+}
+
+template <typename F>
+double Measure(F &&func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Handle-heavy operations: copying handle arrays, hashing, sorting, comparing and resolving.
+void benchmark(uint32_t count) {
+    std::vector<ComponentHandle> handles;
+    handles.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        handles.push_back(ComponentHandle((i * 2654435761u) | 1u));
+    }
+
+    std::vector<ComponentHandle> copy;
+    double copy_ms = Measure([&] { copy = handles; });
+
+    std::unordered_map<ComponentHandle, uint32_t> map;
+    map.reserve(count);
+    uint64_t found = 0;
+    double map_ms = Measure([&] {
+        for (uint32_t i = 0; i < count; i++) map.emplace(handles[i], i);
+        for (const auto &handle : handles) found += map.find(handle)->second;
+    });
+
+    double sort_ms = Measure([&] {
+        std::sort(copy.begin(), copy.end(), [](const ComponentHandle &a, const ComponentHandle &b) {
+            return a.GetID() < b.GetID();
+        });
+    });
+
+    size_t matches = 0;
+    double compare_ms = Measure([&] {
+        for (uint32_t i = 0; i < count; i++) matches += (copy[i] == handles[i]);
+    });
+
+    WorldSystem world;
+    auto &scene = world.CreateScene();
+    std::vector<ComponentHandle> component_handles;
+    const uint32_t component_count = std::min<uint32_t>(count, 100000);
+    for (uint32_t i = 0; i < component_count; i++) {
+        component_handles.push_back(scene.CreateGameObject().AddComponent<EmptyComponent>().GetHandle());
+    }
+    scene.FlushCmdQueue();
+    size_t resolved = 0;
+    double resolve_ms = Measure([&] {
+        for (int repeat = 0; repeat < 10; repeat++) {
+            for (auto handle : component_handles) resolved += (scene.GetComponent(handle) != nullptr);
+        }
+    });
+    assert(resolved == size_t{component_count} * 10);
+
+    printf(
+        "%u handles of %zu bytes: copy %.3f ms, hash map insert+find %.3f ms, sort %.3f ms, compare %.3f ms "
+        "(%zu), resolve %u x10 %.3f ms (%llu).\n",
+        count,
+        sizeof(ComponentHandle),
+        copy_ms,
+        map_ms,
+        sort_ms,
+        compare_ms,
+        matches,
+        component_count,
+        resolve_ms,
+        static_cast<unsigned long long>(found)
+    );
+}
+
+int main(int argc, char *argv[]) {
+    test_handles();
+    if (argc > 1 && std::string_view(argv[1]) == "--benchmark") benchmark(1 << 20);
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <Core/Jobs/JobSystem.h>
+#include <Core/Jobs/WorkStealingDeque.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+void test_deque() {
+    WorkStealingDeque<uint32_t> deque(4);
+    uint32_t value;
+    bool popped = deque.Pop(value);
+    bool stolen = deque.Steal(value);
+    assert(!popped && !stolen);
+
+    // Grows past the initial capacity.
+    for (uint32_t i = 0; i < 100; i++) deque.Push(i);
+    assert(deque.SizeEstimate() == 100);
+    // Owner pops LIFO, thieves steal FIFO.
+    popped = deque.Pop(value);
+    assert(popped && value == 99);
+    stolen = deque.Steal(value);
+    assert(stolen && value == 0);
+    assert(deque.SizeEstimate() == 98);
+
+    // Concurrent thieves and owner see every value exactly once.
+    WorkStealingDeque<uint32_t> shared;
+    const uint32_t count = 200000;
+    std::vector<std::atomic<uint32_t>> seen(count);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; t++) {
+        thieves.emplace_back([&] {
+            uint32_t v;
+            while (!done.load()) {
+                if (shared.Steal(v)) seen[v]++;
+            }
+            while (shared.Steal(v)) seen[v]++;
+        });
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        shared.Push(i);
+        if (i % 3 == 0 && shared.Pop(value)) seen[value]++;
+    }
+    while (shared.Pop(value)) seen[value]++;
+    done = true;
+    for (auto &thief : thieves) thief.join();
+    for (uint32_t i = 0; i < count; i++) assert(seen[i] == 1);
+
+    puts("Work-stealing deque test passed.");
+}
+
+void test_counters_and_dependencies() {
+    JobSystem jobs(3);
+    std::atomic<int> value{0};
+
+    JobCounter first{};
+    for (int i = 0; i < 1000; i++) {
+        jobs.Schedule([&] { value.fetch_add(1); }, &first);
+    }
+
+    // The second stage only starts after the first one finishes.
+    JobCounter second{};
+    std::atomic<bool> ordered{true};
+    for (int i = 0; i < 100; i++) {
+        jobs.Schedule(
+            [&] {
+                if (value.load() < 1000) ordered = false;
+            },
+            &second,
+            &first
+        );
+    }
+    jobs.Wait(second);
+    assert(first.IsDone() && second.IsDone());
+    assert(value == 1000);
+    assert(ordered);
+
+    // Jobs spawning jobs.
+    JobCounter nested{};
+    std::atomic<int> leaves{0};
+    for (int i = 0; i < 16; i++) {
+        jobs.Schedule(
+            [&] {
+                for (int j = 0; j < 16; j++) jobs.Schedule([&] { leaves.fetch_add(1); }, &nested);
+            },
+            &nested
+        );
+    }
+    jobs.Wait(nested);
+    assert(leaves == 256);
+
+    // A done counter can be reused as a dependency and a signal.
+    JobCounter reused{};
+    jobs.Schedule([&] { value = 0; }, &reused, &first);
+    jobs.Wait(reused);
+    assert(value == 0);
+
+    puts("Job counter and dependency test passed.");
+}
+
+void test_main_thread_jobs() {
+    JobSystem jobs(2);
+    auto main_thread = std::this_thread::get_id();
+    std::atomic<int> on_main{0};
+    JobCounter counter{};
+
+    // Scheduled from a worker, run on the main thread while it waits.
+    jobs.Schedule(
+        [&] {
+            for (int i = 0; i < 10; i++) {
+                jobs.ScheduleOnMainThread(
+                    [&] {
+                        if (std::this_thread::get_id() == main_thread) on_main++;
+                    },
+                    &counter
+                );
+            }
+        },
+        &counter
+    );
+    jobs.Wait(counter);
+    assert(on_main == 10);
+
+    jobs.ScheduleOnMainThread([&] { on_main++; });
+    size_t ran = jobs.RunMainThreadJobs();
+    assert(ran == 1);
+    assert(on_main == 11);
+
+    puts("Main thread job test passed.");
+}
+
+void test_parallel_for() {
+    for (uint32_t workers : {0u, 1u, 3u}) {
+        JobSystem jobs(workers);
+        std::vector<uint32_t> data(100003, 0);
+        jobs.ParallelFor(data.size(), 1000, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) data[i] += static_cast<uint32_t>(i);
+        });
+        for (size_t i = 0; i < data.size(); i++) assert(data[i] == i);
+
+        size_t calls = 0;
+        jobs.ParallelFor(0, 1, [&](size_t, size_t) { calls++; });
+        assert(calls == 0);
+    }
+    puts("ParallelFor test passed.");
+}
+
+// Counters on the stack are destroyed right after they are done, while the workers
+// that finished the last jobs may still be returning from them.
+void test_counter_lifetime() {
+    JobSystem jobs(3);
+    std::atomic<uint32_t> sum{0};
+    for (uint32_t i = 0; i < 20000; i++) {
+        JobCounter counter{};
+        for (uint32_t j = 0; j < 4; j++) {
+            jobs.Schedule([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.Wait(counter);
+    }
+    assert(sum.load() == 80000);
+
+    // Polled instead of waited for, as done for jobs running across frames.
+    for (uint32_t i = 0; i < 20000; i++) {
+        auto counter = std::make_unique<JobCounter>();
+        jobs.Schedule([] {}, counter.get());
+        while (!counter->IsDone()) std::this_thread::yield();
+    }
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < 5000; i++) {
+        std::atomic<uint64_t> partial{0};
+        jobs.ParallelFor(64, 4, [&partial](size_t begin, size_t end) {
+            partial.fetch_add(end - begin, std::memory_order_relaxed);
+        });
+        total += partial.load();
+    }
+    assert(total == 5000 * 64);
+    puts("Job counter lifetime test passed.");
+}
+
+// Throughput of tiny independent jobs, and of a ParallelFor over fine-grained chunks.
+void benchmark() {
+    const uint32_t job_count = 200000;
+    uint32_t max_workers = JobSystem::GetDefaultWorkerCount();
+    std::vector<uint32_t> worker_counts{0};
+    for (uint32_t w = 1; w < max_workers; w *= 2) worker_counts.push_back(w);
+    if (max_workers > 0) worker_counts.push_back(max_workers);
+
+    for (auto workers : worker_counts) {
+        JobSystem jobs(workers);
+        std::atomic<uint64_t> sink{0};
+
+        JobCounter counter{};
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < job_count; i++) {
+            jobs.Schedule([&sink, i] { sink.fetch_add(i, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.Wait(counter);
+        auto end = std::chrono::high_resolution_clock::now();
+        double schedule_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::vector<float> data(1 << 22, 1.0f);
+        start = std::chrono::high_resolution_clock::now();
+        jobs.ParallelFor(data.size(), 4096, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) data[i] = data[i] * 1.5f + 0.5f;
+        });
+        end = std::chrono::high_resolution_clock::now();
+        double parallel_for_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        printf(
+            "%u workers: %u tiny jobs in %.3f ms (%.2f M jobs/s), ParallelFor over %zu floats in %.3f ms.\n",
+            workers,
+            job_count,
+            schedule_ms,
+            job_count / schedule_ms / 1000.0,
+            data.size(),
+            parallel_for_ms
+        );
+    }
+}
+
+int main(int argc, char *argv[]) {
+    test_deque();
+    test_counters_and_dependencies();
+    test_main_thread_jobs();
+    test_parallel_for();
+    test_counter_lifetime();
+    if (argc > 1 && std::string_view(argv[1]) == "--benchmark") benchmark();
+    return 0;
+}
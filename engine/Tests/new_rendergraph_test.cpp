@@ -1,3 +1,5 @@
+#include <cassert>
+
 #include "MainClass.h"
 #include "Render/FullRenderSystem.h"
 using namespace Engine;
@@ -15,58 +17,77 @@ int main() {
 
     auto rgb = RenderGraphBuilder2{*cmc->GetRenderSystem()};
 
-    auto rttd = RenderTargetTexture::RenderTargetTextureDesc{
-        .dimensions = 2,
-        .width = 1280,
-        .height = 720,
-        .depth = 1,
-        .mipmap_levels = 1,
-        .array_layers = 1,
-        .format = RenderTargetTexture::RTTFormat::R8G8B8A8UNorm,
-        .multisample = 1,
-    };
-    auto gbuffer = rgb.RequestRenderTargetTexture(rttd, {}, "G-Buffer");
-    auto fbuffer = rgb.RequestRenderTargetTexture(rttd, {}, "Main buffer");
+    auto fill = [&](uint32_t width, uint32_t height) {
+        auto rttd = RenderTargetTexture::RenderTargetTextureDesc{
+            .dimensions = 2,
+            .width = width,
+            .height = height,
+            .depth = 1,
+            .mipmap_levels = 1,
+            .array_layers = 1,
+            .format = RenderTargetTexture::RTTFormat::R8G8B8A8UNorm,
+            .multisample = 1,
+        };
+        auto gbuffer = rgb.RequestRenderTargetTexture(rttd, {}, "G-Buffer");
+        auto fbuffer = rgb.RequestRenderTargetTexture(rttd, {}, "Main buffer");
 
-    rgb.AddPass(
-        RenderGraphPassBuilder{*cmc->GetRenderSystem()}
-            .SetName("Compute pass")
-            .SetGlobalAccess({MemoryAccessTypeBufferBits::ShaderRandomWrite})
-            .SetComputePassFunction(dummy_compute_pass)
-            .Get()
-    );
+        rgb.AddPass(
+            RenderGraphPassBuilder{*cmc->GetRenderSystem()}
+                .SetName("Compute pass")
+                .SetGlobalAccess({MemoryAccessTypeBufferBits::ShaderRandomWrite})
+                .SetComputePassFunction(dummy_compute_pass)
+                .Get()
+        );
 
-    rgb.AddPass(
-        RenderGraphPassBuilder{*cmc->GetRenderSystem()}
-            .SetName("Main pass")
-            .UseImage(gbuffer, MemoryAccessTypeImageBits::ShaderSampledRead)
-            .AppendColorAttachment(
-                {fbuffer, {}, AttachmentUtils::LoadOperation::Clear, AttachmentUtils::StoreOperation::Store}
-            )
-            .SetRasterizerPassFunction(dummy_graphics_pass)
-            .WrapRenderPass()
-            .Get()
-    );
+        rgb.AddPass(
+            RenderGraphPassBuilder{*cmc->GetRenderSystem()}
+                .SetName("Main pass")
+                .UseImage(gbuffer, MemoryAccessTypeImageBits::ShaderSampledRead)
+                .AppendColorAttachment(
+                    {fbuffer, {}, AttachmentUtils::LoadOperation::Clear, AttachmentUtils::StoreOperation::Store}
+                )
+                .SetRasterizerPassFunction(dummy_graphics_pass)
+                .WrapRenderPass()
+                .Get()
+        );
 
-    rgb.AddPass(
-        RenderGraphPassBuilder{*cmc->GetRenderSystem()}
-            .SetName("GBuffer pass")
-            .SetGlobalAccess({MemoryAccessTypeBufferBits::IndexRead, MemoryAccessTypeBufferBits::VertexRead})
-            .AppendColorAttachment(
-                {gbuffer, {}, AttachmentUtils::LoadOperation::Clear, AttachmentUtils::StoreOperation::Store}
-            )
-            .SetRasterizerPassFunction(dummy_graphics_pass)
-            .WrapRenderPass()
-            .Get()
-    );
+        rgb.AddPass(
+            RenderGraphPassBuilder{*cmc->GetRenderSystem()}
+                .SetName("GBuffer pass")
+                .SetGlobalAccess({MemoryAccessTypeBufferBits::IndexRead, MemoryAccessTypeBufferBits::VertexRead})
+                .AppendColorAttachment(
+                    {gbuffer, {}, AttachmentUtils::LoadOperation::Clear, AttachmentUtils::StoreOperation::Store}
+                )
+                .SetRasterizerPassFunction(dummy_graphics_pass)
+                .WrapRenderPass()
+                .Get()
+        );
 
-    rgb.AddPass(
-        RenderGraphPassBuilder{*cmc->GetRenderSystem()}
-            .SetName("Post processing compute")
-            .UseImage(fbuffer, MemoryAccessTypeImageBits::ShaderRandomRead)
-            .SetComputePassFunction(dummy_compute_pass)
-            .Get()
-    );
+        rgb.AddPass(
+            RenderGraphPassBuilder{*cmc->GetRenderSystem()}
+                .SetName("Post processing compute")
+                .UseImage(fbuffer, MemoryAccessTypeImageBits::ShaderRandomRead)
+                .SetComputePassFunction(dummy_compute_pass)
+                .Get()
+        );
+    };
 
+    fill(1280, 720);
     auto rg = rgb.BuildRenderGraph();
+    const auto &stats = rgb.GetBuildStatistics();
+    assert(stats.builds == 1 && stats.compilations == 1 && stats.memory_plannings == 1);
+
+    // Same structure, reusing the compiled graph.
+    rgb.Reset();
+    fill(1280, 720);
+    auto rg2 = rgb.BuildRenderGraph();
+    assert(stats.builds == 2 && stats.compilations == 1 && stats.memory_plannings == 1);
+    assert(rg2.GetTransientMemorySize() == rg.GetTransientMemorySize());
+
+    // Same topology with different extents, only planning memory again.
+    rgb.Reset();
+    fill(1920, 1080);
+    auto rg3 = rgb.BuildRenderGraph();
+    assert(stats.builds == 3 && stats.compilations == 1 && stats.memory_plannings == 2);
+    assert(rg3.GetTransientMemorySize() > rg.GetTransientMemorySize());
 }
@@ -0,0 +1,164 @@
+#include <Core/Jobs/JobSystem.h>
+#include <Framework/component/Component.h>
+#include <Framework/object/GameObject.h>
+#include <Framework/world/Scene.h>
+#include <Framework/world/TickScheduler.h>
+#include <Framework/world/WorldSystem.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+std::atomic<uint32_t> group0_ticks{0};
+std::atomic<uint32_t> group1_ticks{0};
+std::atomic<uint32_t> group2_ticks{0};
+uint32_t work_iterations = 64;
+
+// Independent per-component work, safe to run on worker threads.
+class SimulationComponent : public Component {
+public:
+    SimulationComponent(GameObject &parent) : Component(parent) {
+    }
+    REFL_TICK_TRAITS(0, true)
+
+    void Tick() override {
+        assert(TickScheduler::IsInParallelTick());
+        for (uint32_t i = 0; i < work_iterations; i++) {
+            m_state = m_state * 0.999f + std::sin(m_state + static_cast<float>(i));
+        }
+        group0_ticks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    float m_state{1.0f};
+};
+
+// Runs on the main thread after all simulation components.
+class GatherComponent : public Component {
+public:
+    GatherComponent(GameObject &parent) : Component(parent) {
+    }
+    REFL_TICK_TRAITS(1, false)
+
+    void Tick() override {
+        assert(group0_ticks.load() == m_expected_group0);
+        assert(!TickScheduler::IsInParallelTick());
+        group1_ticks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32_t m_expected_group0{0};
+};
+
+// Thread-safe again, after the barrier of group 1.
+class LateComponent : public Component {
+public:
+    LateComponent(GameObject &parent) : Component(parent) {
+    }
+    REFL_TICK_TRAITS(2, true)
+
+    void Tick() override {
+        assert(group1_ticks.load() == m_expected_group1);
+        group2_ticks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32_t m_expected_group1{0};
+};
+
+void ResetCounters() {
+    group0_ticks = 0;
+    group1_ticks = 0;
+    group2_ticks = 0;
+}
+
+void RunFrame(Scene &scene) {
+    scene.FlushCmdQueue();
+    scene.AddTickEvent();
+    scene.ProcessEvents();
+}
+
+std::vector<float> Simulate(WorldSystem &world, JobSystem *jobs, uint32_t count, uint32_t frames) {
+    auto &scene = world.CreateScene();
+    scene.SetTickJobSystem(jobs);
+    std::vector<SimulationComponent *> simulation{};
+    for (uint32_t i = 0; i < count; i++) {
+        auto &go = scene.CreateGameObject();
+        auto &comp = go.AddComponent<SimulationComponent>();
+        comp.m_state = static_cast<float>(i % 97) * 0.01f;
+        simulation.push_back(&comp);
+    }
+    std::vector<GatherComponent *> gather{};
+    std::vector<LateComponent *> late{};
+    for (uint32_t i = 0; i < 16; i++) {
+        auto &go = scene.CreateGameObject();
+        gather.push_back(&go.AddComponent<GatherComponent>());
+        late.push_back(&go.AddComponent<LateComponent>());
+    }
+    scene.FlushCmdQueue();
+    scene.ProcessEvents();
+
+    for (uint32_t f = 0; f < frames; f++) {
+        ResetCounters();
+        for (auto *comp : gather) comp->m_expected_group0 = count;
+        for (auto *comp : late) comp->m_expected_group1 = static_cast<uint32_t>(gather.size());
+        RunFrame(scene);
+        assert(group0_ticks == count);
+        assert(group1_ticks == gather.size());
+        assert(group2_ticks == late.size());
+    }
+
+    std::vector<float> states{};
+    for (auto *comp : simulation) states.push_back(comp->m_state);
+    scene.Clear();
+    return states;
+}
+
+void test_ordering_and_determinism() {
+    WorldSystem world;
+    JobSystem jobs(std::max(1u, JobSystem::GetDefaultWorkerCount()));
+    auto serial = Simulate(world, nullptr, 5000, 4);
+    auto parallel = Simulate(world, &jobs, 5000, 4);
+    assert(serial == parallel);
+    puts("Parallel tick ordering and determinism test passed.");
+}
+
+void benchmark(uint32_t count) {
+    WorldSystem world;
+    auto &scene = world.CreateScene();
+    for (uint32_t i = 0; i < count; i++) {
+        scene.CreateGameObject().AddComponent<SimulationComponent>();
+    }
+    scene.FlushCmdQueue();
+    scene.ProcessEvents();
+
+    const int frames = 20;
+    uint32_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<uint32_t> thread_counts{};
+    for (uint32_t threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    double single = 0.0;
+    for (auto threads : thread_counts) {
+        // The main thread ticks as well, so it takes one worker less than the thread count.
+        JobSystem jobs(threads - 1);
+        scene.SetTickJobSystem(&jobs);
+        RunFrame(scene);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int f = 0; f < frames; f++) RunFrame(scene);
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+        if (threads == 1) single = ms;
+        printf("%u components, %u threads: %.3f ms per frame (%.2fx).\n", count, threads, ms, single / ms);
+        scene.SetTickJobSystem(nullptr);
+    }
+}
+
+int main() {
+    test_ordering_and_determinism();
+    benchmark(50000);
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "Render/RenderSystem/PipelineCache.h"
+
+using namespace Engine::RenderSystemState;
+
+const PipelineCache::DeviceIdentity IDENTITY{
+    .vendor_id = 0x10de,
+    .device_id = 0x2684,
+    .driver_version = 0x8a0c4000,
+    .pipeline_cache_uuid = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}
+};
+
+std::vector<std::byte> MakeData(size_t size) {
+    std::vector<std::byte> data(size);
+    for (size_t i = 0; i < size; i++) data[i] = static_cast<std::byte>(i * 7 + 3);
+    return data;
+}
+
+void test_round_trip() {
+    auto data = MakeData(1000);
+    auto file = PipelineCache::Serialize(IDENTITY, data);
+    assert(file.size() > data.size());
+
+    auto loaded = PipelineCache::Deserialize(file, IDENTITY);
+    assert(loaded.size() == data.size());
+    assert(std::equal(loaded.begin(), loaded.end(), data.begin()));
+    puts("Round trip test passed.");
+}
+
+void test_device_mismatch() {
+    auto file = PipelineCache::Serialize(IDENTITY, MakeData(100));
+
+    auto other = IDENTITY;
+    other.driver_version++;
+    assert(PipelineCache::Deserialize(file, other).empty());
+
+    other = IDENTITY;
+    other.pipeline_cache_uuid[15] = 0;
+    assert(PipelineCache::Deserialize(file, other).empty());
+
+    other = IDENTITY;
+    other.vendor_id = 0x1002;
+    assert(PipelineCache::Deserialize(file, other).empty());
+    puts("Device mismatch test passed.");
+}
+
+void test_corruption() {
+    auto file = PipelineCache::Serialize(IDENTITY, MakeData(100));
+
+    // Truncated data.
+    std::vector<std::byte> truncated(file.begin(), file.end() - 1);
+    assert(PipelineCache::Deserialize(truncated, IDENTITY).empty());
+
+    // Truncated header.
+    std::vector<std::byte> header_only(file.begin(), file.begin() + 8);
+    assert(PipelineCache::Deserialize(header_only, IDENTITY).empty());
+
+    // Flipped bit in the data.
+    auto flipped = file;
+    flipped.back() ^= std::byte{1};
+    assert(PipelineCache::Deserialize(flipped, IDENTITY).empty());
+
+    // Not a cache file.
+    auto garbage = MakeData(file.size());
+    assert(PipelineCache::Deserialize(garbage, IDENTITY).empty());
+    assert(PipelineCache::Deserialize({}, IDENTITY).empty());
+    puts("Corruption test passed.");
+}
+
+int main() {
+    test_round_trip();
+    test_device_mismatch();
+    test_corruption();
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "Render/RenderSystem/PipelineManifest.h"
+
+using namespace Engine;
+using namespace Engine::RenderSystemState;
+
+PipelineRuntimeInfo MakeInfo(ImageUtils::ImageFormat color, uint64_t va) {
+    PipelineRuntimeInfo pri{};
+    pri.va.packed = va;
+    pri.samples = 1;
+    pri.color_attachment_format[0] = color;
+    pri.color_attachment_format[1] = ImageUtils::ImageFormat::UNDEFINED;
+    pri.depth_stencil_attachment_format = ImageUtils::ImageFormat::D32SFLOAT;
+    return pri;
+}
+
+const GUID LIBRARY{"123e4567-e89b-12d3-a456-426655440000"};
+
+void test_round_trip() {
+    std::vector<PipelineManifest::Entry> entries{
+        {LIBRARY, "", MakeInfo(ImageUtils::ImageFormat::R8G8B8A8UNorm, 0x2333)},
+        {LIBRARY, "SKYBOX", MakeInfo(ImageUtils::ImageFormat::R32G32B32A32SFloat, 0x33)},
+    };
+    entries[1].pri.color_attachment_format[1] = ImageUtils::ImageFormat::R8G8B8A8UNorm;
+    entries[1].pri.color_attachment_format[2] = ImageUtils::ImageFormat::UNDEFINED;
+
+    auto loaded = PipelineManifest::Deserialize(PipelineManifest::Serialize(entries));
+    assert(loaded == entries);
+    puts("Round trip test passed.");
+}
+
+void test_malformed() {
+    assert(PipelineManifest::Deserialize("").empty());
+    assert(PipelineManifest::Deserialize("{\"version\": 1}").empty());
+    assert(PipelineManifest::Deserialize("{\"version\": 2, \"entries\": []}").empty());
+    assert(PipelineManifest::Deserialize("{\"version\": 1, \"entries\": [{\"tag\": \"\"}]}").empty());
+    puts("Malformed manifest test passed.");
+}
+
+void test_record() {
+    PipelineManifest manifest;
+    auto pri = MakeInfo(ImageUtils::ImageFormat::R8G8B8A8UNorm, 0x2333);
+    bool first = manifest.Record(LIBRARY, "", pri);
+    bool duplicate = manifest.Record(LIBRARY, "", pri);
+    bool other_tag = manifest.Record(LIBRARY, "SKYBOX", pri);
+    assert(first && !duplicate && other_tag);
+    pri.depth_stencil_attachment_format = ImageUtils::ImageFormat::UNDEFINED;
+    bool other_info = manifest.Record(LIBRARY, "", pri);
+    assert(other_info);
+    assert(manifest.GetEntries().size() == 3);
+    // Libraries not loaded from an asset cannot be preheated.
+    bool nil = manifest.Record(GUID::Nil(), "", pri);
+    assert(!nil);
+    assert(manifest.GetEntries().size() == 3);
+    puts("Record test passed.");
+}
+
+void test_save_and_load() {
+    auto path = std::filesystem::temp_directory_path() / "pipeline_manifest_test.json";
+    std::filesystem::remove(path);
+    auto pri = MakeInfo(ImageUtils::ImageFormat::R8G8B8A8UNorm, 0x2333);
+
+    {
+        PipelineManifest manifest;
+        bool loaded = manifest.Load(path);
+        assert(!loaded);
+        manifest.Record(LIBRARY, "", pri);
+        // Saved when destroyed.
+    }
+    {
+        PipelineManifest manifest;
+        manifest.Record(LIBRARY, "SKYBOX", pri);
+        bool loaded = manifest.Load(path);
+        assert(loaded);
+        assert(manifest.GetEntries().size() == 2);
+    }
+    {
+        PipelineManifest manifest;
+        bool loaded = manifest.Load(path);
+        assert(loaded);
+        assert(manifest.GetEntries().size() == 2);
+    }
+    {
+        // Entries of nil libraries, recorded by older versions, are dropped.
+        std::ofstream file(path, std::ios::trunc);
+        file << PipelineManifest::Serialize({{GUID::Nil(), "", pri}, {LIBRARY, "", pri}});
+    }
+    {
+        PipelineManifest manifest;
+        bool loaded = manifest.Load(path);
+        assert(loaded);
+        assert(manifest.GetEntries().size() == 1 && manifest.GetEntries()[0].library == LIBRARY);
+    }
+    std::filesystem::remove(path);
+    puts("Save and load test passed.");
+}
+
+int main() {
+    test_round_trip();
+    test_malformed();
+    test_record();
+    test_save_and_load();
+    return 0;
+}
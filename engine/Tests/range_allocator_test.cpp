@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Core/RangeAllocator.h"
+
+using namespace Engine;
+
+std::mt19937 gen{};
+
+void test_basic() {
+    RangeAllocator allocator{100};
+    assert(allocator.GetLargestFreeRange() == 100);
+    auto empty = allocator.Allocate(0);
+    assert(empty == RangeAllocator::INVALID_OFFSET);
+
+    auto a = allocator.Allocate(30), b = allocator.Allocate(30), c = allocator.Allocate(40);
+    assert(a == 0 && b == 30 && c == 60);
+    auto full = allocator.Allocate(1);
+    assert(full == RangeAllocator::INVALID_OFFSET);
+    assert(allocator.GetUsedSize() == 100 && allocator.GetFreeRangeCount() == 0);
+
+    allocator.Free(a, 30);
+    allocator.Free(c, 40);
+    assert(allocator.GetFreeRangeCount() == 2);
+    // Best fit takes the smaller range.
+    auto best = allocator.Allocate(20);
+    assert(best == 0);
+    allocator.Free(0, 20);
+    // Freeing the middle range merges all three.
+    allocator.Free(b, 30);
+    assert(allocator.GetFreeRangeCount() == 1);
+    assert(allocator.GetLargestFreeRange() == 100 && allocator.GetUsedSize() == 0);
+
+    allocator.Allocate(50);
+    allocator.Clear();
+    assert(allocator.GetLargestFreeRange() == 100 && allocator.GetUsedSize() == 0);
+    puts("Basic test passed.");
+}
+
+// Random allocations and frees checked against a map of used units.
+void test_random(uint64_t capacity, uint32_t operations) {
+    RangeAllocator allocator{capacity};
+    std::vector<bool> used(capacity, false);
+    std::vector<std::pair<uint64_t, uint64_t>> live;
+    uint64_t used_size = 0;
+
+    for (uint32_t op = 0; op < operations; op++) {
+        if (live.empty() || gen() % 3 != 0) {
+            uint64_t size = 1 + gen() % 64;
+            uint64_t offset = allocator.Allocate(size);
+            if (offset == RangeAllocator::INVALID_OFFSET) {
+                assert(allocator.GetLargestFreeRange() < size);
+                continue;
+            }
+            assert(offset + size <= capacity);
+            for (uint64_t i = offset; i < offset + size; i++) {
+                assert(!used[i]);
+                used[i] = true;
+            }
+            live.push_back({offset, size});
+            used_size += size;
+        } else {
+            size_t index = gen() % live.size();
+            auto [offset, size] = live[index];
+            live[index] = live.back();
+            live.pop_back();
+            allocator.Free(offset, size);
+            for (uint64_t i = offset; i < offset + size; i++) used[i] = false;
+            used_size -= size;
+        }
+        assert(allocator.GetUsedSize() == used_size);
+    }
+
+    // Free ranges are maximal, so their count matches the runs of unused units.
+    size_t runs = 0;
+    for (uint64_t i = 0; i < capacity; i++) {
+        if (!used[i] && (i == 0 || used[i - 1])) runs++;
+    }
+    assert(allocator.GetFreeRangeCount() == runs);
+
+    for (auto [offset, size] : live) allocator.Free(offset, size);
+    assert(allocator.GetFreeRangeCount() == 1 && allocator.GetLargestFreeRange() == capacity);
+    printf("Random test with capacity %llu passed, %zu ranges were live.\n", (unsigned long long)capacity, live.size());
+}
+
+// Compaction of a fragmented allocator, with the data moved as MeshBufferArena moves it.
+void test_compact(uint64_t capacity) {
+    RangeAllocator allocator{capacity};
+    // Every unit holds the index of the range that owns it.
+    std::vector<uint32_t> data(capacity, UINT32_MAX);
+    std::vector<RangeAllocator::Relocation> live;
+    while (true) {
+        uint64_t size = 1 + gen() % 16;
+        uint64_t offset = allocator.Allocate(size);
+        if (offset == RangeAllocator::INVALID_OFFSET) break;
+        live.push_back({offset, size, 0});
+    }
+    // Free every other range in random order.
+    std::shuffle(live.begin(), live.end(), gen);
+    for (size_t i = live.size() / 2; i < live.size(); i++) allocator.Free(live[i].offset, live[i].size);
+    live.resize(live.size() / 2);
+    uint64_t used_size = allocator.GetUsedSize();
+    for (uint32_t i = 0; i < live.size(); i++) {
+        for (uint64_t u = live[i].offset; u < live[i].offset + live[i].size; u++) data[u] = i;
+    }
+    assert(allocator.GetFreeRangeCount() > 1);
+
+    auto before = live;
+    allocator.Compact(live);
+    assert(allocator.GetUsedSize() == used_size);
+    assert(allocator.GetFreeRangeCount() == 1 && allocator.GetLargestFreeRange() == capacity - used_size);
+
+    // Copy the ranges to a new buffer, and check that every range lands in one piece.
+    std::vector<uint32_t> compacted(capacity, UINT32_MAX);
+    for (uint32_t i = 0; i < live.size(); i++) {
+        assert(live[i].offset == before[i].offset && live[i].size == before[i].size);
+        assert(live[i].new_offset <= live[i].offset && live[i].new_offset + live[i].size <= used_size);
+        std::copy_n(data.begin() + live[i].offset, live[i].size, compacted.begin() + live[i].new_offset);
+    }
+    for (uint32_t i = 0; i < live.size(); i++) {
+        for (uint64_t u = live[i].new_offset; u < live[i].new_offset + live[i].size; u++) {
+            assert(compacted[u] == i);
+        }
+        // Ranges keep their order.
+        for (uint32_t j = 0; j < live.size(); j++) {
+            assert((live[i].offset < live[j].offset) == (live[i].new_offset < live[j].new_offset));
+        }
+    }
+
+    // The compacted ranges can be freed, and the free range at the end can be allocated.
+    uint64_t tail = allocator.Allocate(capacity - used_size);
+    assert(tail == used_size);
+    allocator.Free(tail, capacity - used_size);
+    for (const auto &range : live) allocator.Free(range.new_offset, range.size);
+    assert(allocator.GetFreeRangeCount() == 1 && allocator.GetLargestFreeRange() == capacity);
+
+    // Compacting nothing frees everything.
+    allocator.Allocate(capacity / 2);
+    allocator.Compact({});
+    assert(allocator.GetUsedSize() == 0 && allocator.GetLargestFreeRange() == capacity);
+    puts("Compaction test passed.");
+}
+
+int main() {
+    test_basic();
+    test_random(4096, 100000);
+    test_random(1 << 20, 200000);
+    test_compact(4096);
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "Core/RadixSort.h"
+#include "Render/RenderSystem/RenderSortKey.h"
+
+using namespace Engine;
+using namespace Engine::RenderSystemState;
+
+std::mt19937_64 gen{};
+
+struct Item {
+    uint64_t key;
+    uint32_t order;
+};
+
+void test_radix_sort() {
+    std::vector<Item> items, scratch, expected;
+    for (uint32_t size : {0u, 1u, 2u, 17u, 1000u, 65536u}) {
+        for (uint64_t mask : {0xFFull, 0xFF00FFull, 0xFFFFFFFFFFFFFFFFull}) {
+            items.clear();
+            for (uint32_t i = 0; i < size; i++) items.push_back({gen() & mask, i});
+            expected = items;
+            std::stable_sort(expected.begin(), expected.end(), [](const Item &a, const Item &b) {
+                return a.key < b.key;
+            });
+            RadixSort(items, scratch, [](const Item &item) { return item.key; });
+            assert(items.size() == expected.size());
+            for (size_t i = 0; i < items.size(); i++) {
+                assert(items[i].key == expected[i].key);
+                // Stable.
+                assert(items[i].order == expected[i].order);
+            }
+        }
+    }
+    puts("Radix sort test passed.");
+}
+
+void test_keys() {
+    // Layers come first, with the lowest bit of the mask.
+    assert(RenderSortKey::ByMaterial(0b1, 100, 100, 100, 100.0f) < RenderSortKey::ByMaterial(0b10, 0, 0, 0, 0.0f));
+    assert(RenderSortKey::ByMaterial(0b110, 1, 1, 1, 1.0f) == RenderSortKey::ByMaterial(0b10, 1, 1, 1, 1.0f));
+
+    // ByMaterial: pipeline, then material, then geometry, then depth.
+    assert(RenderSortKey::ByMaterial(1, 0, 9, 9, 100.0f) < RenderSortKey::ByMaterial(1, 1, 0, 0, 0.0f));
+    assert(RenderSortKey::ByMaterial(1, 1, 0, 9, 100.0f) < RenderSortKey::ByMaterial(1, 1, 1, 0, 0.0f));
+    assert(RenderSortKey::ByMaterial(1, 1, 1, 0, 100.0f) < RenderSortKey::ByMaterial(1, 1, 1, 1, 0.0f));
+    assert(RenderSortKey::ByMaterial(1, 1, 1, 1, 1.0f) < RenderSortKey::ByMaterial(1, 1, 1, 1, 2.0f));
+    // Geometry IDs are masked, and do not spill into the material.
+    assert(RenderSortKey::ByMaterial(1, 1, 1, 0x10001, 1.0f) == RenderSortKey::ByMaterial(1, 1, 1, 1, 1.0f));
+
+    // ByDistance: depth, then pipeline and material.
+    assert(RenderSortKey::ByDistance(1, 9, 9, 1.0f) < RenderSortKey::ByDistance(1, 0, 0, 2.0f));
+    assert(RenderSortKey::ByDistance(1, 0, 9, 1.0f) < RenderSortKey::ByDistance(1, 1, 0, 1.0f));
+
+    // ByPriority: priority, then pipeline.
+    assert(RenderSortKey::ByPriority(1, 0, 9, 9, 9.0f) < RenderSortKey::ByPriority(1, 1, 0, 0, 0.0f));
+    assert(RenderSortKey::ByPriority(1, 1, 0, 9, 9.0f) < RenderSortKey::ByPriority(1, 1, 1, 0, 0.0f));
+
+    // Quantized depth keeps the order of distinct enough values.
+    float last = 0.0f;
+    for (float depth = 1e-3f; depth < 1e6f; depth *= 1.01f) {
+        assert(RenderSortKey::QuantizeDepth(last, 19) <= RenderSortKey::QuantizeDepth(depth, 19));
+        last = depth;
+    }
+    assert(RenderSortKey::QuantizeDepth(-1.0f, 27) == 0);
+    puts("Sort key test passed.");
+}
+
+// Count the rebinds and draw calls of a draw list the way GraphicsCommandBuffer::DrawRenderers records it:
+// the pipeline is rebound when it changes, the descriptor set when the material changes, and runs of
+// the same geometry and material are merged into one instanced draw.
+struct Draw {
+    uint32_t pipeline;
+    uint32_t material;
+    uint32_t geometry;
+    float depth;
+};
+
+struct DrawStats {
+    uint32_t pipelines = 0, materials = 0, draw_calls = 0;
+};
+
+DrawStats CountRebinds(const std::vector<Draw> &draws) {
+    DrawStats stats{};
+    uint32_t bound_pipeline = 0xFFFFFFFF, bound_material = 0xFFFFFFFF, last_geometry = 0xFFFFFFFF;
+    for (const auto &draw : draws) {
+        if (draw.pipeline != bound_pipeline) stats.pipelines++, bound_pipeline = draw.pipeline;
+        if (draw.material != bound_material) {
+            stats.materials++, bound_material = draw.material;
+            last_geometry = 0xFFFFFFFF;
+        }
+        if (draw.geometry != last_geometry) stats.draw_calls++, last_geometry = draw.geometry;
+    }
+    return stats;
+}
+
+void test_rebinds(uint32_t count) {
+    const uint32_t pipeline_count = 8, material_count = 64, geometry_count = 16;
+    std::vector<Draw> draws;
+    std::uniform_real_distribution<float> distance{0.1f, 1e4f};
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t material = gen() % material_count;
+        // Every material belongs to one pipeline.
+        draws.push_back({material % pipeline_count, material, uint32_t(gen() % geometry_count), distance(gen)});
+    }
+    auto unsorted = CountRebinds(draws);
+
+    struct Keyed {
+        uint64_t key;
+        Draw draw;
+    };
+    std::vector<Keyed> keyed, scratch;
+    for (const auto &draw : draws) {
+        keyed.push_back({RenderSortKey::ByMaterial(1, draw.pipeline, draw.material, draw.geometry, draw.depth), draw});
+    }
+    auto std_keyed = keyed;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    RadixSort(keyed, scratch, [](const Keyed &k) { return k.key; });
+    auto end = std::chrono::high_resolution_clock::now();
+    double radix_time = std::chrono::duration<double, std::milli>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    std::sort(std_keyed.begin(), std_keyed.end(), [](const Keyed &a, const Keyed &b) { return a.key < b.key; });
+    end = std::chrono::high_resolution_clock::now();
+    double std_time = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::vector<Draw> sorted;
+    for (const auto &k : keyed) sorted.push_back(k.draw);
+    auto stats = CountRebinds(sorted);
+    assert(stats.pipelines == pipeline_count);
+    assert(stats.materials == material_count);
+    assert(stats.draw_calls <= material_count * geometry_count);
+
+    // Draws sharing a material and geometry are front to back, up to the depth quantization.
+    for (size_t i = 1; i < sorted.size(); i++) {
+        if (sorted[i].material != sorted[i - 1].material || sorted[i].geometry != sorted[i - 1].geometry) continue;
+        auto previous = RenderSortKey::QuantizeDepth(sorted[i - 1].depth, 11);
+        assert(previous <= RenderSortKey::QuantizeDepth(sorted[i].depth, 11));
+    }
+
+    printf(
+        "Synthetic scene of %u draws, %u pipelines, %u materials, %u meshes: unsorted %u pipeline and "
+        "%u material binds, %u draw calls; sorted by material %u and %u, %u instanced draw calls.\n",
+        count,
+        pipeline_count,
+        material_count,
+        geometry_count,
+        unsorted.pipelines,
+        unsorted.materials,
+        unsorted.draw_calls,
+        stats.pipelines,
+        stats.materials,
+        stats.draw_calls
+    );
+    printf("Sorting took %.4f ms with radix sort, %.4f ms with std::sort.\n", radix_time, std_time);
+}
+
+int main(int argc, char *argv[]) {
+    test_radix_sort();
+    test_keys();
+    test_rebinds(10000);
+    // Only timed with `--benchmark`, the smaller run above already checks the sort.
+    if (argc > 1 && std::string_view(argv[1]) == "--benchmark") test_rebinds(100000);
+    return 0;
+}
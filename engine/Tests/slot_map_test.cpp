@@ -0,0 +1,196 @@
+#include <Core/SlotMap.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace Engine;
+
+struct Entity {
+    uint32_t key{0};
+    float payload[8]{};
+};
+
+// Storage scheme used by Scene before slot maps: a vector of owning pointers
+// with erase-remove on despawn, and a hash map for lookups.
+struct BaselineStorage {
+    std::vector<std::unique_ptr<Entity>> entities{};
+    std::unordered_map<uint32_t, Entity *> map{};
+    uint32_t id_gen{0};
+
+    uint32_t Spawn() {
+        while (map.find(id_gen) != map.end() || id_gen == 0) id_gen++;
+        auto ptr = std::make_unique<Entity>();
+        ptr->key = id_gen;
+        map[id_gen] = ptr.get();
+        entities.push_back(std::move(ptr));
+        return id_gen++;
+    }
+
+    void Despawn(uint32_t key) {
+        map.erase(key);
+        entities.erase(
+            std::remove_if(
+                entities.begin(),
+                entities.end(),
+                [key](const std::unique_ptr<Entity> &e) { return e->key == key; }
+            ),
+            entities.end()
+        );
+    }
+};
+
+struct SlotMapStorage {
+    SlotMap<Entity> entities{};
+
+    uint32_t Spawn() {
+        auto ptr = std::make_unique<Entity>();
+        auto key = entities.Allocate(ptr.get());
+        ptr->key = key;
+        entities.Commit(key, std::move(ptr));
+        return key;
+    }
+
+    void Despawn(uint32_t key) {
+        entities.Erase(key);
+    }
+};
+
+void test_basic() {
+    SlotMap<Entity> map;
+    assert(map.Get(0) == nullptr);
+
+    auto e1 = std::make_unique<Entity>();
+    auto *p1 = e1.get();
+    auto k1 = map.Allocate(p1);
+    assert(k1 != 0);
+    // Pending objects are resolvable, but not part of the dense storage.
+    assert(map.Get(k1) == p1);
+    assert(map.Size() == 0);
+    map.Commit(k1, std::move(e1));
+    assert(map.Size() == 1);
+
+    auto e2 = std::make_unique<Entity>();
+    auto *p2 = e2.get();
+    auto k2 = map.Allocate(p2);
+    map.Commit(k2, std::move(e2));
+    assert(map.GetDenseIndex(k1) == 0);
+    assert(map.GetDenseIndex(k2) == 1);
+
+    auto removed = map.Erase(k1);
+    assert(removed.get() == p1);
+    assert(map.Get(k1) == nullptr);
+    assert(map.Get(k2) == p2);
+    assert(map.Size() == 1);
+    assert(map.GetDense()[0].get() == p2);
+    assert(map.GetDenseKeys()[0] == k2);
+    // The last object is moved into the gap.
+    assert(map.GetDenseIndex(k2) == 0);
+    assert(map.GetDenseIndex(k1) == SlotMap<Entity>::INVALID_DENSE_INDEX);
+
+    // The freed slot is reused with a new generation.
+    auto e3 = std::make_unique<Entity>();
+    auto *p3 = e3.get();
+    auto k3 = map.Allocate(p3);
+    map.Commit(k3, std::move(e3));
+    assert(SlotMap<Entity>::GetIndex(k3) == SlotMap<Entity>::GetIndex(k1));
+    assert(k3 != k1);
+    assert(map.Get(k1) == nullptr);
+    assert(map.Get(k3) == p3);
+
+    // Erasing twice is a no-op, and leaves the new occupant of the slot alone.
+    auto erased = map.Erase(k1);
+    assert(erased == nullptr);
+    assert(map.Get(k3) == p3);
+
+    map.Clear();
+    assert(map.Size() == 0);
+    assert(map.Get(k2) == nullptr);
+    assert(map.Get(k3) == nullptr);
+
+    puts("Basic slot map test passed.");
+}
+
+void test_random_churn() {
+    std::mt19937 gen{42};
+    SlotMap<Entity> map;
+    std::vector<std::pair<uint32_t, Entity *>> live;
+    std::vector<uint32_t> dead;
+
+    for (int i = 0; i < 100000; i++) {
+        if (live.empty() || gen() % 3 != 0) {
+            auto e = std::make_unique<Entity>();
+            auto *p = e.get();
+            auto k = map.Allocate(p);
+            map.Commit(k, std::move(e));
+            live.emplace_back(k, p);
+        } else {
+            size_t idx = gen() % live.size();
+            map.Erase(live[idx].first);
+            dead.push_back(live[idx].first);
+            live[idx] = live.back();
+            live.pop_back();
+        }
+    }
+
+    assert(map.Size() == live.size());
+    for (auto [k, p] : live) assert(map.Get(k) == p);
+    for (auto k : dead) assert(map.Get(k) == nullptr);
+    for (size_t i = 0; i < map.Size(); i++) {
+        assert(map.Get(map.GetDenseKeys()[i]) == map.GetDense()[i].get());
+    }
+
+    puts("Random churn slot map test passed.");
+}
+
+template <typename Storage>
+double benchmark_spawn_despawn(size_t entity_count, size_t frames, size_t churn_per_frame) {
+    std::mt19937 gen{1234};
+    Storage storage;
+    std::vector<uint32_t> live;
+    live.reserve(entity_count);
+    for (size_t i = 0; i < entity_count; i++) live.push_back(storage.Spawn());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t f = 0; f < frames; f++) {
+        for (size_t c = 0; c < churn_per_frame; c++) {
+            size_t idx = gen() % live.size();
+            storage.Despawn(live[idx]);
+            live[idx] = storage.Spawn();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void benchmark(size_t entity_count) {
+    const size_t frames = 10;
+    const size_t churn = 100;
+    double baseline = benchmark_spawn_despawn<BaselineStorage>(entity_count, frames, churn);
+    double slot_map = benchmark_spawn_despawn<SlotMapStorage>(entity_count, frames, churn);
+    printf(
+        "%zu entities, %zu spawn/despawn pairs: baseline %.3f ms, slot map %.3f ms (%.1fx).\n",
+        entity_count,
+        frames * churn,
+        baseline,
+        slot_map,
+        baseline / std::max(slot_map, 1e-6)
+    );
+}
+
+// Benchmarks take seconds, so they only run with `--benchmark`, and ctest only checks correctness.
+int main(int argc, char *argv[]) {
+    test_basic();
+    test_random_churn();
+
+    if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+        benchmark(10000);
+        benchmark(100000);
+    }
+    return 0;
+}
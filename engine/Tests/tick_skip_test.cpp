@@ -0,0 +1,106 @@
+#include <Framework/component/RenderComponent/CameraComponent.h>
+#include <Framework/component/RenderComponent/StaticMeshComponent.h>
+#include <Framework/component/TransformComponent/TransformComponent.h>
+#include <Framework/object/GameObject.h>
+#include <Framework/world/Scene.h>
+#include <Framework/world/WorldSystem.h>
+#include <Reflection/reflection.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+
+using namespace Engine;
+
+uint64_t tick_count = 0;
+
+// Not reflected, so it is assumed to override Tick().
+class SpinComponent : public Component {
+public:
+    SpinComponent(GameObject &parent) : Component(parent) {
+    }
+
+    void Tick() override {
+        tick_count++;
+    }
+};
+
+void RunFrame(Scene &scene) {
+    scene.FlushCmdQueue();
+    scene.AddTickEvent();
+    scene.ProcessEvents();
+}
+
+double MeasureFrame(Scene &scene) {
+    const int frames = 50;
+    double best = 1e30;
+    for (int f = 0; f < frames; f++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        RunFrame(scene);
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+void test_overrides() {
+    auto component = Reflection::GetType("Engine::Component");
+    auto static_mesh = Reflection::GetType("Engine::StaticMeshComponent");
+    auto camera = Reflection::GetType("Engine::CameraComponent");
+    auto transform = Reflection::GetType("Engine::TransformComponent");
+    assert(component->DeclaresVirtualMethod("Tick"));
+    assert(!component->OverridesMethod("Tick"));
+    assert(!static_mesh->OverridesMethod("Tick"));
+    assert(!static_mesh->OverridesMethod("Init"));
+    assert(!transform->OverridesMethod("Tick"));
+    assert(camera->OverridesMethod("Tick"));
+    assert(static_mesh->OverridesMethod("Awake"));
+
+    puts("Override detection test passed.");
+}
+
+void test_static_meshes(uint32_t count) {
+    WorldSystem world;
+    auto &scene = world.CreateScene();
+    for (int i = 0; i < 100; i++) {
+        scene.CreateGameObject().AddComponent<SpinComponent>();
+    }
+    scene.FlushCmdQueue();
+    scene.ProcessEvents();
+    // TransformComponents do not tick.
+    assert(scene.GetTickableComponentCount() == 100);
+    double before = MeasureFrame(scene);
+
+    auto handles = scene.CreateGameObjects<StaticMeshComponent>(count);
+    scene.FlushCmdQueue();
+    scene.ProcessEvents();
+    assert(scene.GetComponents().size() == 200 + size_t{count} * 2);
+    assert(scene.GetTickableComponentCount() == 100);
+    tick_count = 0;
+    double after = MeasureFrame(scene);
+    assert(tick_count == 50 * 100);
+
+    // Removed Components stop ticking, the others keep ticking.
+    auto spinner = scene.GetGameObjects()[0]->GetHandle();
+    scene.RemoveGameObject(spinner);
+    scene.RemoveGameObject(handles[0]);
+    scene.FlushCmdQueue();
+    assert(scene.GetTickableComponentCount() == 99);
+    tick_count = 0;
+    RunFrame(scene);
+    assert(tick_count == 99);
+
+    scene.Clear();
+    assert(scene.GetTickableComponentCount() == 0);
+
+    printf(
+        "Frame with 100 ticking Components: %.4f ms, with %u static meshes added: %.4f ms.\n", before, count, after
+    );
+}
+
+int main() {
+    Reflection::Initialize();
+    test_overrides();
+    test_static_meshes(100000);
+    return 0;
+}
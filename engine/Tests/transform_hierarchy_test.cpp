@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "Core/Math/Transform.h"
+#include "Core/Math/TransformHierarchy.h"
+
+using namespace Engine;
+
+std::mt19937 gen{};
+std::uniform_real_distribution<float> translation_dist{-10.0, 10.0};
+std::uniform_real_distribution<float> rotation_dist{-3.14, 3.14};
+std::uniform_real_distribution<float> scale_dist{0.5, 2.0};
+
+Transform RandomTransform() {
+    Transform t;
+    t.SetPosition({translation_dist(gen), translation_dist(gen), translation_dist(gen)})
+        .SetRotationEuler({rotation_dist(gen), rotation_dist(gen), rotation_dist(gen)})
+        .SetScale({scale_dist(gen), scale_dist(gen), scale_dist(gen)});
+    return t;
+}
+
+// A random forest in parent-before-child order, with bounded depth.
+struct Forest {
+    std::vector<Transform> locals{};
+    std::vector<uint32_t> parents{};
+    std::vector<uint32_t> depths{};
+
+    Forest(size_t count, uint32_t max_depth) {
+        for (size_t i = 0; i < count; i++) {
+            uint32_t parent = TransformHierarchy::NO_PARENT;
+            uint32_t depth = 0;
+            if (i > 0 && gen() % 16 != 0) {
+                uint32_t candidate = gen() % i;
+                if (depths[candidate] + 1 < max_depth) {
+                    parent = candidate;
+                    depth = depths[candidate] + 1;
+                }
+            }
+            locals.push_back(RandomTransform());
+            parents.push_back(parent);
+            depths.push_back(depth);
+        }
+    }
+};
+
+// The per-object path: every query walks up to the root, as GameObject::GetWorldTransform did before caching.
+Transform RecursiveWorldTransform(const Forest &forest, uint32_t node) {
+    if (forest.parents[node] != TransformHierarchy::NO_PARENT) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        return RecursiveWorldTransform(forest, forest.parents[node]) * forest.locals[node];
+#pragma GCC diagnostic pop
+    }
+    return forest.locals[node];
+}
+
+glm::mat4 ReferenceWorldMatrix(const Forest &forest, uint32_t node) {
+    if (forest.parents[node] != TransformHierarchy::NO_PARENT) {
+        return ReferenceWorldMatrix(forest, forest.parents[node]) * forest.locals[node].GetTransformMatrix();
+    }
+    return forest.locals[node].GetTransformMatrix();
+}
+
+bool MatrixNear(const glm::mat4 &a, const glm::mat4 &b, float eps) {
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            float tolerance = eps * std::max(1.0f, std::abs(b[c][r]));
+            if (std::abs(a[c][r] - b[c][r]) > tolerance) return false;
+        }
+    }
+    return true;
+}
+
+void test_correctness() {
+    Forest forest(2000, 8);
+    TransformHierarchy hierarchy;
+    for (size_t i = 0; i < forest.locals.size(); i++) {
+        auto node = hierarchy.AddNode(forest.parents[i], forest.locals[i]);
+        assert(node == i);
+    }
+    size_t updated = hierarchy.UpdateWorldMatrices();
+    assert(updated == forest.locals.size());
+    for (uint32_t i = 0; i < forest.locals.size(); i++) {
+        assert(MatrixNear(hierarchy.GetWorldMatrix(i), ReferenceWorldMatrix(forest, i), 1e-3f));
+    }
+
+    // Nothing changed, nothing recomputed.
+    updated = hierarchy.UpdateWorldMatrices();
+    assert(updated == 0);
+
+    // Changing one node recomputes exactly its subtree.
+    uint32_t changed = 0;
+    forest.locals[changed] = RandomTransform();
+    hierarchy.SetLocalTransform(changed, forest.locals[changed]);
+    std::vector<bool> in_subtree(forest.locals.size(), false);
+    size_t subtree_size = 0;
+    for (uint32_t i = 0; i < forest.locals.size(); i++) {
+        in_subtree[i] = (i == changed) || (forest.parents[i] != TransformHierarchy::NO_PARENT && in_subtree[forest.parents[i]]);
+        subtree_size += in_subtree[i];
+    }
+    auto version_before = hierarchy.GetWorldMatrixVersion(forest.locals.size() - 1);
+    updated = hierarchy.UpdateWorldMatrices();
+    assert(updated == subtree_size);
+    for (uint32_t i = 0; i < forest.locals.size(); i++) {
+        assert(MatrixNear(hierarchy.GetWorldMatrix(i), ReferenceWorldMatrix(forest, i), 1e-3f));
+    }
+    if (!in_subtree.back()) {
+        assert(hierarchy.GetWorldMatrixVersion(forest.locals.size() - 1) == version_before);
+    }
+
+    puts("Transform hierarchy correctness test passed.");
+}
+
+// Rebuilding after a structural change keeps the world matrices of unaffected nodes.
+void test_rebuild() {
+    Forest forest(2000, 8);
+    TransformHierarchy hierarchy;
+    for (size_t i = 0; i < forest.locals.size(); i++) hierarchy.AddNode(forest.parents[i], forest.locals[i]);
+    hierarchy.UpdateWorldMatrices();
+    std::vector<uint64_t> versions(forest.locals.size());
+    for (uint32_t i = 0; i < forest.locals.size(); i++) versions[i] = hierarchy.GetWorldMatrixVersion(i);
+
+    // Reparent one node to the root, and drop the last node.
+    uint32_t moved = 1;
+    while (forest.parents[moved] == TransformHierarchy::NO_PARENT) moved++;
+    forest.parents[moved] = TransformHierarchy::NO_PARENT;
+    forest.locals.pop_back();
+    forest.parents.pop_back();
+
+    hierarchy.BeginRebuild();
+    for (uint32_t i = 0; i < forest.locals.size(); i++) {
+        auto node = hierarchy.AddNode(forest.parents[i], forest.locals[i], i);
+        assert(node == i);
+    }
+    std::vector<bool> in_subtree(forest.locals.size(), false);
+    size_t subtree_size = 0;
+    for (uint32_t i = 0; i < forest.locals.size(); i++) {
+        uint32_t parent = forest.parents[i];
+        in_subtree[i] = (i == moved) || (parent != TransformHierarchy::NO_PARENT && in_subtree[parent]);
+        subtree_size += in_subtree[i];
+    }
+    size_t updated = hierarchy.UpdateWorldMatrices();
+    assert(updated == subtree_size);
+    for (uint32_t i = 0; i < forest.locals.size(); i++) {
+        assert(MatrixNear(hierarchy.GetWorldMatrix(i), ReferenceWorldMatrix(forest, i), 1e-3f));
+        assert((hierarchy.GetWorldMatrixVersion(i) == versions[i]) == !in_subtree[i]);
+    }
+
+    // A node added without a previous node is computed.
+    hierarchy.BeginRebuild();
+    for (uint32_t i = 0; i < forest.locals.size(); i++) hierarchy.AddNode(forest.parents[i], forest.locals[i], i);
+    hierarchy.AddNode(0, RandomTransform());
+    updated = hierarchy.UpdateWorldMatrices();
+    assert(updated == 1);
+
+    puts("Transform hierarchy rebuild test passed.");
+}
+
+void benchmark(size_t count, uint32_t max_depth) {
+    Forest forest(count, max_depth);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    float checksum_per_object = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        checksum_per_object += RecursiveWorldTransform(forest, i).GetTransformMatrix()[3][0];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double per_object = std::chrono::duration<double, std::milli>(end - start).count();
+
+    TransformHierarchy hierarchy;
+    hierarchy.Reserve(count);
+    for (size_t i = 0; i < count; i++) hierarchy.AddNode(forest.parents[i], forest.locals[i]);
+
+    start = std::chrono::high_resolution_clock::now();
+    hierarchy.UpdateWorldMatrices();
+    end = std::chrono::high_resolution_clock::now();
+    double batched_full = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Typical frame: a small fraction of the nodes moves.
+    for (size_t i = 0; i < count; i += 100) hierarchy.SetLocalTransform(i, forest.locals[i]);
+    start = std::chrono::high_resolution_clock::now();
+    size_t partial = hierarchy.UpdateWorldMatrices();
+    end = std::chrono::high_resolution_clock::now();
+    double batched_partial = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Keep the per-object results alive so that the loop is not optimized away.
+    volatile float sink = checksum_per_object;
+    (void)sink;
+
+    printf(
+        "%zu nodes, depth <= %u: per-object %.3f ms, batched full %.3f ms, batched partial (%zu nodes) %.3f ms.\n",
+        count,
+        max_depth,
+        per_object,
+        batched_full,
+        partial,
+        batched_partial
+    );
+}
+
+int main(int argc, char *argv[]) {
+    test_correctness();
+    test_rebuild();
+
+    if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+        benchmark(100000, 4);
+        benchmark(100000, 16);
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Render/Pipeline/RenderGraph2/TransientMemoryPlanner.h"
+
+using namespace Engine;
+using Request = TransientMemoryPlanner::Request;
+
+std::mt19937 gen{};
+
+void test_disjoint_lifetimes() {
+    // G-buffer, lighting and post process, alive one after another.
+    std::vector<Request> requests{
+        {100, 16, 0b11, 0, 1},
+        {100, 16, 0b11, 2, 3},
+        {60, 16, 0b11, 4, 5},
+    };
+    auto plan = TransientMemoryPlanner::MakePlan(requests);
+    assert(plan.blocks.size() == 1);
+    assert(plan.requested_size == 260 && plan.allocated_size == 100);
+    for (const auto &p : plan.placements) assert(p.block == 0 && p.offset == 0);
+
+    assert(plan.placements[0].aliased_predecessors.empty());
+    assert(plan.placements[1].aliased_predecessors == std::vector<size_t>{0});
+    assert(plan.placements[2].aliased_predecessors.size() == 2);
+    puts("Disjoint lifetimes test passed.");
+}
+
+void test_overlapping_lifetimes() {
+    std::vector<Request> requests{
+        {100, 16, 0b11, 0, 2},
+        {40, 16, 0b11, 1, 3},
+        {50, 16, 0b11, 3, 4},
+    };
+    auto plan = TransientMemoryPlanner::MakePlan(requests);
+    // The first two are both alive at pass 1 and 2, so they cannot share memory,
+    // and the third one reuses the memory of the first one after it dies.
+    assert(plan.blocks.size() == 2);
+    assert(plan.placements[0].block != plan.placements[1].block);
+    assert(plan.placements[2].block == plan.placements[0].block);
+    assert(plan.allocated_size == 140);
+    assert(plan.placements[2].aliased_predecessors == std::vector<size_t>{0});
+    puts("Overlapping lifetimes test passed.");
+}
+
+void test_offset_and_alignment() {
+    std::vector<Request> requests{
+        {100, 1, 0b1, 0, 0},
+        {30, 1, 0b1, 1, 2},
+        {30, 32, 0b1, 2, 3},
+    };
+    auto plan = TransientMemoryPlanner::MakePlan(requests);
+    assert(plan.blocks.size() == 1);
+    assert(plan.blocks[0].alignment == 32);
+    assert(plan.placements[1].offset == 0);
+    // Placed after the second one, aligned up.
+    assert(plan.placements[2].offset == 32);
+    assert(plan.placements[2].aliased_predecessors == std::vector<size_t>{0});
+    puts("Offset and alignment test passed.");
+}
+
+void test_memory_types() {
+    std::vector<Request> requests{
+        {100, 16, 0b01, 0, 0},
+        {100, 16, 0b10, 1, 1},
+        {100, 16, 0b11, 2, 2},
+    };
+    auto plan = TransientMemoryPlanner::MakePlan(requests);
+    assert(plan.blocks.size() == 2);
+    assert(plan.placements[0].block != plan.placements[1].block);
+    for (const auto &b : plan.blocks) assert(b.memory_type_bits == 0b01 || b.memory_type_bits == 0b10);
+    puts("Memory type test passed.");
+}
+
+void test_random() {
+    std::uniform_int_distribution<uint32_t> pass{0, 20}, size{1, 1000}, alignment{0, 6};
+    for (int round = 0; round < 100; round++) {
+        std::vector<Request> requests(50);
+        for (auto &r : requests) {
+            r.first_use = pass(gen);
+            r.last_use = r.first_use + pass(gen) / 4;
+            r.size = size(gen);
+            r.alignment = 1ull << alignment(gen);
+            r.memory_type_bits = 0b1;
+        }
+        auto plan = TransientMemoryPlanner::MakePlan(requests);
+        assert(plan.allocated_size <= plan.requested_size);
+
+        for (size_t i = 0; i < requests.size(); i++) {
+            const auto &p = plan.placements[i];
+            assert(p.offset % requests[i].alignment == 0);
+            assert(p.offset + requests[i].size <= plan.blocks[p.block].size);
+            for (size_t j = i + 1; j < requests.size(); j++) {
+                const auto &q = plan.placements[j];
+                if (p.block != q.block) continue;
+                bool share_bytes = p.offset < q.offset + requests[j].size && q.offset < p.offset + requests[i].size;
+                bool share_time =
+                    requests[i].first_use <= requests[j].last_use && requests[j].first_use <= requests[i].last_use;
+                assert(!(share_bytes && share_time));
+            }
+        }
+    }
+    puts("Random placement test passed.");
+}
+
+int main() {
+    test_disjoint_lifetimes();
+    test_overlapping_lifetimes();
+    test_offset_and_alignment();
+    test_memory_types();
+    test_random();
+    return 0;
+}
@@ -100,6 +100,10 @@ class ReflectionParser:
             # ignore inner classes
             if child.kind == CX.CursorKind.STRUCT_DECL or child.kind == CX.CursorKind.CLASS_DECL:
                 continue
+            # record virtual methods, so that overrides (e.g. Component::Tick) can be detected at runtime
+            if child.kind == CX.CursorKind.CXX_METHOD and child.is_virtual_method():
+                if child.spelling not in current_type.virtual_methods:
+                    current_type.virtual_methods.append(child.spelling)
             # check if the field, constructor, or method should be reflected
             if not self.is_reflection(child, mode):
                 continue
@@ -12,6 +12,7 @@ class Type:
         self.serialized_fields = []
         self.constructors = []
         self.methods = []
+        self.virtual_methods = [] # names of all virtual methods declared in the class, reflected or not
 
 
 class Enum:
@@ -0,0 +1,275 @@
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <format>
+#include <gtc/matrix_transform.hpp>
+#include <numeric>
+
+#include "Asset/AssetManager/AssetManager.h"
+#include "Asset/Loader/TextureImportUtils.h"
+#include "Asset/Material/MaterialTemplateAsset.h"
+#include "Asset/Mesh/PlaneMeshAsset.h"
+#include "Asset/Texture/Image2DTextureAsset.h"
+#include "Core/Functional/SDLWindow.h"
+#include "MainClass.h"
+#include "Render/FullRenderSystem.h"
+#include "Render/Renderer/StaticHomogeneousMesh.h"
+#include <Asset/AssetDatabase/FileSystemDatabase.h>
+
+#include "cmake_config.h"
+
+// Introduces 100 new materials in a single frame, and reports the frame time spikes
+// caused by creating their pipelines.
+//
+// Usage: material_compile_spike_test [frame count] [async|fallback|sync]
+//  - async: pipelines are created by the job system, and draws are skipped until they are ready (default).
+//  - fallback: as above, but pending materials are drawn with a fallback template.
+//  - sync: pipelines are created on the main thread when first drawn.
+
+using namespace Engine;
+namespace sch = std::chrono;
+
+constexpr uint32_t MATERIAL_COUNT = 100;
+constexpr uint32_t GRID_SIZE = 10;
+constexpr uint64_t INTRODUCING_FRAME = 10;
+constexpr const char *FALLBACK_TAG = "FALLBACK";
+
+MaterialTemplateAsset *ConstructTemplate(AssetRef vs_ref, AssetRef fs_ref, int32_t specular_mode, float shadow_bias) {
+    auto am = MainClass::GetInstance()->GetAssetManager();
+    auto asset = am->CreateAsset<MaterialTemplateAsset>();
+    asset->name = "Blinn-Phong";
+
+    MaterialTemplateSinglePassProperties mtspp{};
+    mtspp.attachments.color = {ImageUtils::ImageFormat::R8G8B8A8UNorm};
+    mtspp.attachments.color_blending = {PipelineProperties::ColorBlendingProperties{}};
+    mtspp.attachments.depth = ImageUtils::ImageFormat::D32SFLOAT;
+    mtspp.shaders.shaders = std::vector<AssetRef>{vs_ref, fs_ref};
+    // A distinct shadow bias makes a distinct pipeline, which the driver cannot reuse.
+    mtspp.shaders.specialization_constants = {{0, specular_mode}, {1, std::bit_cast<int32_t>(shadow_bias)}};
+
+    asset->properties = mtspp;
+    return asset;
+}
+
+std::vector<MaterialLibraryAsset *> ConstructLibraries() {
+    auto adb = std::dynamic_pointer_cast<FileSystemDatabase>(MainClass::GetInstance()->GetAssetDatabase());
+    auto am = MainClass::GetInstance()->GetAssetManager();
+    auto vs_ref = adb->GetNewAssetRef({*adb, "~/shaders/blinn_phong.vert.asset"});
+    auto fs_ref = adb->GetNewAssetRef({*adb, "~/shaders/blinn_phong.frag.asset"});
+
+    auto fallback = ConstructTemplate(vs_ref, fs_ref, 0, 0.005f);
+
+    std::vector<MaterialLibraryAsset *> libraries;
+    for (uint32_t i = 0; i < MATERIAL_COUNT; i++) {
+        auto lib_asset = am->CreateAsset<MaterialLibraryAsset>();
+        lib_asset->m_name = std::format("Blinn-Phong {}", i);
+
+        MaterialLibraryAsset::MaterialTemplateReference ref;
+        ref.expected_mesh_type = 0;
+        ref.material_template = AssetRef(ConstructTemplate(vs_ref, fs_ref, 2, 0.005f + 1e-5f * (i + 1)));
+        lib_asset->material_bundle[""] = ref;
+
+        ref.material_template = AssetRef(fallback);
+        lib_asset->material_bundle[FALLBACK_TAG] = ref;
+
+        libraries.push_back(lib_asset);
+    }
+    return libraries;
+}
+
+int main(int argc, char **argv) {
+    int64_t max_frame_count = 120;
+    if (argc > 1) {
+        max_frame_count = std::atoll(argv[1]);
+        if (max_frame_count <= static_cast<int64_t>(INTRODUCING_FRAME)) return -1;
+    }
+    std::string mode = argc > 2 ? argv[2] : "async";
+    if (mode != "async" && mode != "fallback" && mode != "sync") return -1;
+
+    SDL_Init(SDL_INIT_VIDEO);
+
+    StartupOptions opt{.resol_x = 1920, .resol_y = 1080, .title = "Material Compile Spike Test"};
+
+    auto cmc = MainClass::GetInstance();
+    cmc->Initialize(&opt, SDL_INIT_VIDEO, SDL_LOG_PRIORITY_INFO);
+    cmc->LoadBuiltinAssets(std::filesystem::path(ENGINE_BUILTIN_ASSETS_DIR));
+
+    auto rsys = cmc->GetRenderSystem();
+    auto am = cmc->GetAssetManager();
+    if (mode == "sync") rsys->SetJobSystem(nullptr);
+
+    // Prepare texture
+    auto texture_asset = std::make_shared<Image2DTextureAsset>();
+    Engine::detail::texture_import::LoadImage2DTextureAssetFromFile(
+        *texture_asset, std::string(ENGINE_ASSETS_DIR) + "/skybox/sky_cloudy.png", ImageUtils::ImageFormat::R8G8B8A8SRGB
+    );
+    std::shared_ptr texture = ImageTexture::CreateUnique(*rsys, *texture_asset);
+    rsys->GetFrameManager().GetSubmissionHelper().EnqueueTextureBufferSubmission(
+        *texture, std::span{texture_asset->GetPixelData(), texture_asset->GetPixelDataSize()}
+    );
+
+    // Prepare materials
+    auto &ml_mng = rsys->GetRenderResourceManager<RenderSystemState::MaterialLibraryManager>();
+    std::vector<MaterialLibrary *> libraries;
+    std::vector<std::unique_ptr<MaterialInstance>> instances;
+    for (auto lib_asset : ConstructLibraries()) {
+        auto handle = ml_mng.CreateOrReuseFromAsset(lib_asset->GetGUID());
+        libraries.push_back(ml_mng.Resolve(handle));
+        if (mode == "fallback") libraries.back()->SetFallbackTag(FALLBACK_TAG);
+
+        auto &instance = instances.emplace_back(std::make_unique<MaterialInstance>(*rsys, handle));
+        float hue = static_cast<float>(instances.size()) / MATERIAL_COUNT;
+        instance->AssignVectorVariable("Material::ambient_color", glm::vec4(hue, 0.0, 1.0 - hue, 0.0));
+        instance->AssignVectorVariable("Material::specular_color", glm::vec4(1.0, 1.0, 1.0, 64.0));
+        instance->AssignTexture("base_texture", texture);
+    }
+
+    // Prepare mesh
+    auto mesh_asset = am->CreateAsset<PlaneMeshAsset>();
+    auto mesh_asset_ref = AssetRef(mesh_asset);
+    auto mesh_resource = std::make_shared<StaticMeshResource>(mesh_asset_ref.GetGUID());
+    StaticHomogeneousMesh mesh{0, mesh_resource.get()};
+    mesh_resource->Submit(rsys->GetAllocatorState(), rsys->GetFrameManager().GetSubmissionHelper());
+
+    // Submit scene data
+    rsys->GetCameraManager().WriteCameraMatrices(glm::mat4{1.0f}, glm::mat4{1.0f});
+    rsys->GetSceneDataManager().SetLightPointNonShadowCasting(
+        0, glm::vec3{-5.0f, -5.0f, -5.0f}, glm::vec3{1.0, 1.0, 1.0}
+    );
+    rsys->GetSceneDataManager().SetLightCountNonShadowCasting(1);
+
+    // Prepare attachments
+    RenderTargetTexture::RenderTargetTextureDesc desc{
+        .dimensions = 2,
+        .width = 1920,
+        .height = 1080,
+        .depth = 1,
+        .mipmap_levels = 1,
+        .array_layers = 1,
+        .format = RenderTargetTexture::RenderTargetTextureDesc::RTTFormat::R8G8B8A8UNorm,
+        .multisample = 1,
+        .is_cube_map = false
+    };
+    std::shared_ptr color = RenderTargetTexture::CreateUnique(*rsys, desc, Texture::SamplerDesc{}, "Color Attachment");
+    desc.format = RenderTargetTexture::RenderTargetTextureDesc::RTTFormat::D32SFLOAT;
+    std::shared_ptr depth = RenderTargetTexture::CreateUnique(*rsys, desc, Texture::SamplerDesc{}, "Depth Attachment");
+
+    // Materials are drawn from the introducing frame on.
+    bool introduced = false;
+    uint32_t ready_count = 0;
+
+    RenderGraphBuilder2 rgb{*rsys};
+    auto c = rgb.ImportExternalResource(*color);
+    auto d = rgb.ImportExternalResource(*depth);
+    rgb.AddPass(
+        RenderGraphPassBuilder{*rsys}
+            .SetName("Main")
+            .AppendColorAttachment(
+                {c, {}, AttachmentUtils::LoadOperation::Clear, AttachmentUtils::StoreOperation::Store}
+            )
+            .SetDepthStencilAttachment(
+                {d,
+                 {},
+                 AttachmentUtils::LoadOperation::Clear,
+                 AttachmentUtils::StoreOperation::DontCare,
+                 AttachmentUtils::DepthClearValue{1.0f, 0U}}
+            )
+            .SetRasterizerPassFunction([&](GraphicsCommandBuffer &gcb, const RenderGraph2 &) {
+                auto extent = rsys->GetSwapchain().GetExtent();
+
+                PipelineRuntimeInfo pri{};
+                pri.va = mesh.GetVertexAttributeFormat();
+                pri.color_attachment_format[0] = color->GetTextureDescription().format;
+                pri.color_attachment_format[1] = ImageUtils::ImageFormat::UNDEFINED;
+                pri.depth_stencil_attachment_format = depth->GetTextureDescription().format;
+
+                gcb.SetupViewport(extent.width, extent.height, {{0, 0}, extent});
+                gcb.BindSceneResources(rsys->GetSceneDataManager());
+                gcb.BindCameraResources(rsys->GetCameraManager());
+
+                ready_count = 0;
+                if (!introduced) return;
+                for (uint32_t i = 0; i < MATERIAL_COUNT; i++) {
+                    auto request = libraries[i]->RequestMaterialTemplate("", pri);
+                    if (request.status == MaterialLibrary::TemplateStatus::Ready) ready_count++;
+                    if (!request.material_template) continue;
+
+                    glm::vec3 offset{
+                        (static_cast<float>(i % GRID_SIZE) + 0.5f) * 2.0f / GRID_SIZE - 1.0f,
+                        (static_cast<float>(i / GRID_SIZE) + 0.5f) * 2.0f / GRID_SIZE - 1.0f,
+                        0.5f
+                    };
+                    glm::mat4 model =
+                        glm::scale(glm::translate(glm::mat4{1.0f}, offset), glm::vec3{0.8f / GRID_SIZE});
+                    gcb.BindMaterial(*instances[i], *request.material_template);
+                    gcb.DrawMesh(mesh, model);
+                }
+            })
+            .WrapRenderPass()
+            .Get()
+    );
+    auto graph = rgb.BuildRenderGraph();
+
+    std::vector<double> frame_milliseconds;
+    int64_t all_ready_frame = -1;
+    for (int64_t frame = 0; frame < max_frame_count; frame++) {
+        SDL_Event event;
+        bool quited = false;
+        while (SDL_PollEvent(&event) != 0) {
+            if (event.type == SDL_EVENT_QUIT) quited = true;
+        }
+        if (quited) break;
+
+        introduced = frame >= static_cast<int64_t>(INTRODUCING_FRAME);
+
+        auto start = sch::steady_clock::now();
+        cmc->GetJobSystem()->RunMainThreadJobs();
+        rsys->StartFrame();
+        graph.Execute(*rsys);
+        rsys->CompleteFrame(
+            *color,
+            MemoryAccessTypeImageBits::ColorAttachmentWrite,
+            color->GetTextureDescription().width,
+            color->GetTextureDescription().height
+        );
+        frame_milliseconds.push_back(sch::duration<double, std::milli>(sch::steady_clock::now() - start).count());
+
+        if (all_ready_frame < 0 && ready_count == MATERIAL_COUNT) all_ready_frame = frame;
+    }
+
+    rsys->WaitForIdle();
+
+    // Report per-frame spike metrics of frames after materials are introduced.
+    if (frame_milliseconds.size() <= INTRODUCING_FRAME) return 0;
+    std::vector<double> before(frame_milliseconds.begin(), frame_milliseconds.begin() + INTRODUCING_FRAME);
+    std::vector<double> after(frame_milliseconds.begin() + INTRODUCING_FRAME, frame_milliseconds.end());
+    std::sort(before.begin(), before.end());
+    double baseline = before[before.size() / 2];
+    double worst = *std::max_element(after.begin(), after.end());
+    double average = std::accumulate(after.begin(), after.end(), 0.0) / after.size();
+    auto spikes = std::count_if(after.begin(), after.end(), [baseline](double ms) {
+        return ms > std::max(baseline * 2.0, baseline + 4.0);
+    });
+
+    auto pipeline_stats = rsys->GetPipelineCache().GetStatistics();
+    SDL_Log("Mode: %s", mode.c_str());
+    SDL_Log("Frame time before introducing materials (median): %.3f ms", baseline);
+    SDL_Log("Frame time after introducing materials: average %.3f ms, worst %.3f ms", average, worst);
+    SDL_Log("Spike frames (over twice the median and 4 ms above it): %lld", static_cast<long long>(spikes));
+    SDL_Log(
+        "All materials ready %lld frames after introduced.",
+        static_cast<long long>(all_ready_frame < 0 ? -1 : all_ready_frame - INTRODUCING_FRAME)
+    );
+    SDL_Log(
+        "%u pipelines were created in %.2f ms in total.",
+        pipeline_stats.pipeline_count,
+        pipeline_stats.creation_milliseconds
+    );
+    for (size_t i = 0; i < after.size(); i++) {
+        SDL_LogVerbose(SDL_LOG_CATEGORY_APPLICATION, "Frame %zu: %.3f ms", i + INTRODUCING_FRAME, after[i]);
+    }
+
+    return 0;
+}
@@ -139,6 +139,8 @@ auto BuildRenderGraph(
                         sizeof(RenderSystemState::RendererManager::RendererDataStruct),
                         reinterpret_cast<const void *>(&EYE4)
                     );
+                    // Pushed past the bound state filter of the command buffer.
+                    gcb.InvalidateBoundState();
                     gcb.DrawMesh(*mesh);
                 }
             )